@@ -0,0 +1,448 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// stores the csv of a containers run as a versioned baseline and compares a
+// later run against it.
+//
+//	baseline record results.csv baseline.csv [--label NAME]
+//		copies the rows behind a "# mystl-baseline format=1 label=NAME
+//		date=..." line. the label names the mystl drop (a tag or commit)
+//	baseline compare baseline.csv results.csv [--threshold PCT] [--alpha P] [--json FILE]
+//		matches the cases on container,impl,type,op,size and runs Welch's
+//		t-test on their samples. a case regressed when its median got slower
+//		by more than PCT percent (default 5) and the test says the samples
+//		differ (p below P, default 0.05). cases with a single sample are
+//		judged on the threshold alone. prints a text report, writes the same
+//		as json to FILE ("-" for stdout) and exits with 1 on any regression
+
+// csv input
+namespace
+{
+	struct result
+	{
+		double					median		= 0;
+		std::vector<double>		samples{};
+	};
+
+	struct run
+	{
+		std::string								header{};	// the "# mystl-baseline" line, if any
+		std::map<std::string, result>			cases{};	// keyed by container,impl,type,op,size
+		std::vector<std::string>				order{};
+	};
+
+	std::vector<std::string> split(const std::string& line, const char& separator)
+	{
+		std::vector<std::string> fields{};
+		std::stringstream stream(line);
+		std::string field;
+
+		while (std::getline(stream, field, separator))
+			fields.push_back(field);
+
+		if (!line.empty() && line.back() == separator)
+			fields.emplace_back();
+
+		return fields;
+	}
+
+	bool load(const char* path, run& out)
+	{
+		std::ifstream file(path);
+		if (!file)
+		{
+			std::fprintf(stderr, "cannot open %s\n", path);
+			return false;
+		}
+
+		std::string line;
+		std::vector<std::string> columns{};
+
+		while (std::getline(file, line))
+		{
+			if (!line.empty() && line.back() == '\r')
+				line.pop_back();
+
+			if (line.empty())
+				continue;
+
+			if (line[0] == '#')
+			{
+				if (line.rfind("# mystl-baseline", 0) == 0)
+					out.header = line;
+				continue;
+			}
+
+			if (columns.empty())
+			{
+				columns = split(line, ',');
+				continue;
+			}
+
+			std::vector<std::string> fields = split(line, ',');
+			auto field = [&](const char* name) -> std::string
+			{
+				for (size_t i = 0; i < columns.size() && i < fields.size(); i++)
+				{
+					if (columns[i] == name)
+						return fields[i];
+				}
+
+				return {};
+			};
+
+			std::string key = field("container") + "," + field("impl") + "," + field("type") + "," + field("op") + "," + field("size");
+			result entry{};
+			entry.median = std::strtod(field("ns_per_op").c_str(), nullptr);
+
+			for (const std::string& sample : split(field("samples"), ';'))
+			{
+				if (!sample.empty())
+					entry.samples.push_back(std::strtod(sample.c_str(), nullptr));
+			}
+
+			if (entry.samples.empty())
+				entry.samples.push_back(entry.median);
+
+			if (!out.cases.count(key))
+				out.order.push_back(key);
+			out.cases[key] = entry;
+		}
+
+		if (columns.empty())
+		{
+			std::fprintf(stderr, "%s has no csv header\n", path);
+			return false;
+		}
+
+		return true;
+	}
+}
+
+// statistics
+namespace
+{
+	// continued fraction of the regularized incomplete beta function
+	double beta_fraction(const double& a, const double& b, const double& x)
+	{
+		const double tiny = 1e-300;
+		double c = 1;
+		double d = 1 - (a + b) * x / (a + 1);
+		d = 1 / (std::fabs(d) < tiny ? tiny : d);
+		double h = d;
+
+		for (int m = 1; m <= 200; m++)
+		{
+			double numerator = m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m));
+			d = 1 + numerator * d;
+			c = 1 + numerator / c;
+			d = 1 / (std::fabs(d) < tiny ? tiny : d);
+			c = std::fabs(c) < tiny ? tiny : c;
+			h *= d * c;
+
+			numerator = -(a + m) * (a + b + m) * x / ((a + 2 * m) * (a + 2 * m + 1));
+			d = 1 + numerator * d;
+			c = 1 + numerator / c;
+			d = 1 / (std::fabs(d) < tiny ? tiny : d);
+			c = std::fabs(c) < tiny ? tiny : c;
+			double step = d * c;
+			h *= step;
+
+			if (std::fabs(step - 1) < 1e-12)
+				break;
+		}
+
+		return h;
+	}
+
+	double incomplete_beta(const double& a, const double& b, const double& x)
+	{
+		if (x <= 0)
+			return 0;
+		if (x >= 1)
+			return 1;
+
+		double front = std::exp(std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) + a * std::log(x) + b * std::log(1 - x));
+
+		if (x < (a + 1) / (a + b + 2))
+			return front * beta_fraction(a, b, x) / a;
+
+		return 1 - front * beta_fraction(b, a, 1 - x) / b;
+	}
+
+	// two sided p-value of Welch's t-test, -1 when either side has fewer
+	// than two samples
+	double welch_p(const std::vector<double>& left, const std::vector<double>& right)
+	{
+		if (left.size() < 2 || right.size() < 2)
+			return -1;
+
+		auto moments = [](const std::vector<double>& samples, double& mean, double& variance)
+		{
+			mean = 0;
+			for (double sample : samples)
+				mean += sample;
+			mean /= (double)samples.size();
+
+			variance = 0;
+			for (double sample : samples)
+				variance += (sample - mean) * (sample - mean);
+			variance /= (double)(samples.size() - 1);
+		};
+
+		double leftMean, leftVariance, rightMean, rightVariance;
+		moments(left, leftMean, leftVariance);
+		moments(right, rightMean, rightVariance);
+
+		double leftError = leftVariance / (double)left.size();
+		double rightError = rightVariance / (double)right.size();
+		double error = leftError + rightError;
+
+		if (error == 0)
+			return leftMean == rightMean ? 1 : 0;
+
+		double t = (rightMean - leftMean) / std::sqrt(error);
+		double freedom = error * error / (leftError * leftError / (double)(left.size() - 1) + rightError * rightError / (double)(right.size() - 1));
+
+		return incomplete_beta(freedom / 2, 0.5, freedom / (freedom + t * t));
+	}
+}
+
+// commands
+namespace
+{
+	int record(const char* resultsPath, const char* baselinePath, const std::string& label)
+	{
+		std::ifstream results(resultsPath);
+		if (!results)
+		{
+			std::fprintf(stderr, "cannot open %s\n", resultsPath);
+			return 2;
+		}
+
+		std::ofstream baseline(baselinePath);
+		if (!baseline)
+		{
+			std::fprintf(stderr, "cannot write %s\n", baselinePath);
+			return 2;
+		}
+
+		char date[32];
+		std::time_t now = std::time(nullptr);
+		std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+		baseline << "# mystl-baseline format=1 label=" << (label.empty() ? "unlabeled" : label) << " date=" << date << "\n";
+
+		std::string line;
+		while (std::getline(results, line))
+		{
+			if (line.rfind("# mystl-baseline", 0) != 0)
+				baseline << line << "\n";
+		}
+
+		return 0;
+	}
+
+	struct verdict
+	{
+		std::string		key;
+		std::string		status;
+		double			baseline	= 0;
+		double			current		= 0;
+		double			change		= 0;
+		double			p			= -1;
+	};
+
+	std::string json_string(const std::string& text)
+	{
+		std::string quoted = "\"";
+		for (char c : text)
+		{
+			if (c == '"' || c == '\\')
+				quoted += '\\';
+			quoted += c;
+		}
+
+		return quoted + "\"";
+	}
+
+	int compare(const char* baselinePath, const char* currentPath, const double& threshold, const double& alpha, const char* jsonPath)
+	{
+		run baseline{};
+		run current{};
+
+		if (!load(baselinePath, baseline) || !load(currentPath, current))
+			return 2;
+
+		std::vector<verdict> verdicts{};
+		size_t regressions = 0;
+		size_t improvements = 0;
+
+		for (const std::string& key : baseline.order)
+		{
+			verdict entry{ key, "missing" };
+			entry.baseline = baseline.cases[key].median;
+
+			auto found = current.cases.find(key);
+			if (found != current.cases.end())
+			{
+				entry.current = found->second.median;
+				entry.change = entry.baseline > 0 ? (entry.current - entry.baseline) / entry.baseline : 0;
+				entry.p = welch_p(baseline.cases[key].samples, found->second.samples);
+
+				bool significant = entry.p < 0 || entry.p < alpha;
+				if (significant && entry.change > threshold)
+				{
+					entry.status = "regression";
+					regressions++;
+				}
+				else if (significant && entry.change < -threshold)
+				{
+					entry.status = "improvement";
+					improvements++;
+				}
+				else
+					entry.status = "unchanged";
+			}
+
+			verdicts.push_back(entry);
+		}
+
+		for (const std::string& key : current.order)
+		{
+			if (!baseline.cases.count(key))
+				verdicts.push_back(verdict{ key, "new", 0, current.cases[key].median });
+		}
+
+		// text report: regressions first, then improvements, then the rest in one line
+		std::printf("baseline: %s\n", baseline.header.empty() ? baselinePath : baseline.header.c_str());
+		std::printf("threshold %.1f%%, alpha %.3f, %zu cases\n\n", threshold * 100, alpha, verdicts.size());
+
+		for (const char* status : { "regression", "improvement" })
+		{
+			for (const verdict& entry : verdicts)
+			{
+				if (entry.status != status)
+					continue;
+
+				std::printf("%-12s %-48s %10.3f -> %10.3f ns/op  %+7.1f%%", status, entry.key.c_str(), entry.baseline, entry.current, entry.change * 100);
+				if (entry.p >= 0)
+					std::printf("  p=%.4f\n", entry.p);
+				else
+					std::printf("  (single sample)\n");
+			}
+		}
+
+		size_t missing = (size_t)std::count_if(verdicts.begin(), verdicts.end(), [](const verdict& entry) { return entry.status == "missing"; });
+		size_t added = (size_t)std::count_if(verdicts.begin(), verdicts.end(), [](const verdict& entry) { return entry.status == "new"; });
+
+		std::printf("\n%zu regressions, %zu improvements, %zu unchanged, %zu missing, %zu new\n", regressions, improvements,
+			verdicts.size() - regressions - improvements - missing - added, missing, added);
+
+		if (jsonPath)
+		{
+			std::string json = "{\n  \"baseline\": " + json_string(baseline.header) + ",\n";
+
+			char numbers[256];
+			std::snprintf(numbers, sizeof(numbers), "  \"threshold\": %.4f,\n  \"alpha\": %.4f,\n  \"regressions\": %zu,\n  \"improvements\": %zu,\n  \"cases\": [", threshold, alpha, regressions, improvements);
+			json += numbers;
+
+			for (size_t i = 0; i < verdicts.size(); i++)
+			{
+				const verdict& entry = verdicts[i];
+				std::vector<std::string> parts = split(entry.key, ',');
+				parts.resize(5);
+
+				json += i ? ",\n    {" : "\n    {";
+				json += "\"container\": " + json_string(parts[0]) + ", \"impl\": " + json_string(parts[1]) + ", \"type\": " + json_string(parts[2]);
+				json += ", \"op\": " + json_string(parts[3]) + ", \"size\": " + json_string(parts[4]) + ", \"status\": " + json_string(entry.status);
+
+				std::snprintf(numbers, sizeof(numbers), ", \"baseline_ns\": %.3f, \"current_ns\": %.3f, \"change\": %.4f, \"p_value\": ", entry.baseline, entry.current, entry.change);
+				json += numbers;
+
+				if (entry.p >= 0)
+					std::snprintf(numbers, sizeof(numbers), "%.6f}", entry.p);
+				else
+					std::snprintf(numbers, sizeof(numbers), "null}");
+				json += numbers;
+			}
+
+			json += "\n  ]\n}\n";
+
+			if (!std::strcmp(jsonPath, "-"))
+				std::fputs(json.c_str(), stdout);
+			else
+			{
+				std::ofstream file(jsonPath);
+				if (!file)
+				{
+					std::fprintf(stderr, "cannot write %s\n", jsonPath);
+					return 2;
+				}
+
+				file << json;
+			}
+		}
+
+		return regressions ? 1 : 0;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const char* usage =
+		"usage: %s record results.csv baseline.csv [--label NAME]\n"
+		"       %s compare baseline.csv results.csv [--threshold PCT] [--alpha P] [--json FILE]\n";
+
+	if (argc < 4)
+	{
+		std::fprintf(stderr, usage, argv[0], argv[0]);
+		return 2;
+	}
+
+	std::string label{};
+	double threshold = 0.05;
+	double alpha = 0.05;
+	const char* jsonPath = nullptr;
+
+	for (int i = 4; i < argc; i += 2)
+	{
+		if (i + 1 == argc)
+		{
+			std::fprintf(stderr, "%s needs a value\n", argv[i]);
+			return 2;
+		}
+
+		if (!std::strcmp(argv[i], "--label"))
+			label = argv[i + 1];
+		else if (!std::strcmp(argv[i], "--threshold"))
+			threshold = std::strtod(argv[i + 1], nullptr) / 100;
+		else if (!std::strcmp(argv[i], "--alpha"))
+			alpha = std::strtod(argv[i + 1], nullptr);
+		else if (!std::strcmp(argv[i], "--json"))
+			jsonPath = argv[i + 1];
+		else
+		{
+			std::fprintf(stderr, usage, argv[0], argv[0]);
+			return 2;
+		}
+	}
+
+	if (!std::strcmp(argv[1], "record"))
+		return record(argv[2], argv[3], label);
+
+	if (!std::strcmp(argv[1], "compare"))
+		return compare(argv[2], argv[3], threshold, alpha, jsonPath);
+
+	std::fprintf(stderr, usage, argv[0], argv[0]);
+	return 2;
+}
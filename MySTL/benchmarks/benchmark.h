@@ -0,0 +1,250 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#if defined(__linux__)
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// benchmark																		///
+///																					///
+/// Small timing helpers shared by the mystl benchmarks. Every benchmark is a		///
+/// standalone executable that prints one line per case. perf_counters reads		///
+/// the Linux hardware counters (cycles, instructions, cache, branch and TLB		///
+/// misses) around a measured region through perf_event_open. Counters the			///
+/// kernel or the virtual machine does not expose are reported as unavailable.		///
+///																					///
+///////////////////////////////////////////////////////////////////////////////////////
+
+namespace bench
+{
+	// keeps the optimizer from deleting the work being measured
+	template<typename T>
+	inline void
+		do_not_optimize(const T& value)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile const T* sink = nullptr;
+		sink = &value;
+#endif
+	}
+
+	// runs fn repetitions times and returns the fastest run in nanoseconds
+	template<class Function>
+	inline double
+		best_of(const size_t& repetitions, const Function& fn)
+	{
+		double best = 0;
+
+		for (size_t i = 0; i < repetitions; i++)
+		{
+			auto start = std::chrono::steady_clock::now();
+			fn();
+			auto stop = std::chrono::steady_clock::now();
+
+			double elapsed = std::chrono::duration<double, std::nano>(stop - start).count();
+			if (i == 0 || elapsed < best)
+				best = elapsed;
+		}
+
+		return best;
+	}
+
+	inline void
+		report(const char* name, const size_t& count, const double& ns)
+	{
+		std::printf("%-40s n=%-10zu %12.3f ms %10.3f ns/op\n", name, count, ns / 1e6, ns / (double)count);
+	}
+}
+
+// hardware counters
+namespace bench
+{
+	enum class counter
+	{
+		cycles,
+		instructions,
+		l1d_misses,
+		llc_misses,
+		branch_misses,
+		dtlb_misses,
+		count
+	};
+
+	inline constexpr size_t counter_count = size_t(counter::count);
+
+	// one perf event per counter for this thread, user space only. events are
+	// opened one by one, so a missing counter (common in containers and VMs)
+	// leaves the others working
+	class perf_counters
+	{
+	// constructor/destructor
+	public:
+											perf_counters();
+											perf_counters(const perf_counters&) = delete;
+											~perf_counters();
+
+	// measurement functions
+	public:
+					void					start();
+					void					stop();
+
+	// accessors
+	public:
+					bool					available() const;
+					bool					available(const counter& which) const;
+		// events counted between the last start() and stop(), scaled up when
+		// the kernel had to multiplex the counters. 0 when unavailable
+					double					value(const counter& which) const;
+
+		static constexpr const char*		name(const counter& which);
+
+	// assignment operators
+	public:
+					perf_counters&			operator=(const perf_counters&) = delete;
+
+	// variables
+	private:
+					int						m_Events[counter_count];
+					double					m_Values[counter_count];
+	};
+
+	inline perf_counters::perf_counters()
+	{
+		for (size_t i = 0; i < counter_count; i++)
+		{
+			m_Events[i] = -1;
+			m_Values[i] = 0;
+		}
+
+#if defined(__linux__)
+		auto cache_miss = [](const uint64_t& cache) { return cache | (uint64_t(PERF_COUNT_HW_CACHE_OP_READ) << 8) | (uint64_t(PERF_COUNT_HW_CACHE_RESULT_MISS) << 16); };
+
+		const uint32_t types[counter_count] = { PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE };
+		const uint64_t configs[counter_count] = {
+			PERF_COUNT_HW_CPU_CYCLES,
+			PERF_COUNT_HW_INSTRUCTIONS,
+			cache_miss(PERF_COUNT_HW_CACHE_L1D),
+			cache_miss(PERF_COUNT_HW_CACHE_LL),
+			PERF_COUNT_HW_BRANCH_MISSES,
+			cache_miss(PERF_COUNT_HW_CACHE_DTLB)
+		};
+
+		for (size_t i = 0; i < counter_count; i++)
+		{
+			perf_event_attr attr;
+			std::memset(&attr, 0, sizeof(attr));
+
+			attr.size = sizeof(attr);
+			attr.type = types[i];
+			attr.config = configs[i];
+			attr.disabled = 1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+			m_Events[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC);
+		}
+#endif
+	}
+
+	inline perf_counters::~perf_counters()
+	{
+#if defined(__linux__)
+		for (int event : m_Events)
+		{
+			if (event >= 0)
+				close(event);
+		}
+#endif
+	}
+
+	inline void
+		perf_counters::start()
+	{
+#if defined(__linux__)
+		for (int event : m_Events)
+		{
+			if (event >= 0)
+			{
+				ioctl(event, PERF_EVENT_IOC_RESET, 0);
+				ioctl(event, PERF_EVENT_IOC_ENABLE, 0);
+			}
+		}
+#endif
+	}
+
+	inline void
+		perf_counters::stop()
+	{
+#if defined(__linux__)
+		for (int event : m_Events)
+		{
+			if (event >= 0)
+				ioctl(event, PERF_EVENT_IOC_DISABLE, 0);
+		}
+
+		for (size_t i = 0; i < counter_count; i++)
+		{
+			uint64_t reading[3] = { 0, 0, 0 };	// value, time enabled, time running
+			m_Values[i] = 0;
+
+			if (m_Events[i] < 0 || read(m_Events[i], reading, sizeof(reading)) != (ssize_t)sizeof(reading) || reading[2] == 0)
+				continue;
+
+			m_Values[i] = (double)reading[0] * ((double)reading[1] / (double)reading[2]);
+		}
+#endif
+	}
+
+	inline bool
+		perf_counters::available() const
+	{
+		for (int event : m_Events)
+		{
+			if (event >= 0)
+				return true;
+		}
+
+		return false;
+	}
+
+	inline bool
+		perf_counters::available(const counter& which) const
+	{
+		return m_Events[size_t(which)] >= 0;
+	}
+
+	inline double
+		perf_counters::value(const counter& which) const
+	{
+		return m_Values[size_t(which)];
+	}
+
+	constexpr const char*
+		perf_counters::name(const counter& which)
+	{
+		switch (which)
+		{
+		case counter::cycles:			return "cycles";
+		case counter::instructions:		return "instructions";
+		case counter::l1d_misses:		return "l1d_misses";
+		case counter::llc_misses:		return "llc_misses";
+		case counter::branch_misses:	return "branch_misses";
+		case counter::dtlb_misses:		return "dtlb_misses";
+		default:						return "unknown";
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,57 @@
+#include <cstdint>
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#endif
+
+#include "benchmark.h"
+#include "../src/data_structures/big_vector.h"
+
+// grows a vector to a few hundred megabytes with push_back. mystl::vector
+// copies the whole block on every reallocation and needs the old and the new
+// block at once; big_vector resizes its mapping with mremap. peak rss is read
+// per case, so each case runs in a fresh process: big_vector_growth <case>
+
+#if defined(__linux__)
+static long peak_rss_mb()
+{
+	rusage usage{};
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss / 1024;
+}
+#else
+static long peak_rss_mb() { return 0; }
+#endif
+
+template<class Vector>
+static double grow(const size_t& count)
+{
+	return bench::best_of(3, [&]()
+	{
+		Vector vec{};
+		for (size_t i = 0; i < count; i++)
+			vec.push_back((uint64_t)i);
+
+		bench::do_not_optimize(vec.data());
+	});
+}
+
+int main(int argc, char** argv)
+{
+	const size_t count = size_t(48) << 20;	// 384 MiB of uint64_t
+	const int which = argc > 1 ? argv[1][0] - '0' : -1;
+
+	if (which < 0 || which == 0)
+	{
+		bench::report("mystl::vector<uint64_t>::push_back", count, grow<mystl::vector<uint64_t>>(count));
+		std::printf("%-40s peak rss %ld MiB\n", "", peak_rss_mb());
+	}
+
+	if (which < 0 || which == 1)
+	{
+		bench::report("mystl::big_vector<uint64_t>::push_back", count, grow<mystl::big_vector<uint64_t>>(count));
+		std::printf("%-40s peak rss %ld MiB\n", "", peak_rss_mb());
+	}
+
+	return 0;
+}
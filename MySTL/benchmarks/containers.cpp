@@ -0,0 +1,514 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <list>
+#include <memory>
+#include <new>
+#include <queue>
+#include <random>
+#include <set>
+#include <stack>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "../src/algorithms/algorithm.h"
+#include "../src/data_structures/array.h"
+#include "../src/data_structures/binary_search_tree.h"
+#include "../src/data_structures/deque.h"
+#include "../src/data_structures/list.h"
+#include "../src/data_structures/queue.h"
+#include "../src/data_structures/stack.h"
+#include "../src/data_structures/vector.h"
+
+// every mystl container against its std counterpart (binary_search_tree
+// against std::set): push (and emplace for vector), pop, iterate, random
+// access and search over uint32_t, a 32 byte record and std::string, with
+// working sets of 16 KB (L1), 256 KB (L2), 4 MB (L3) and 64 MB (DRAM).
+// prints one csv row per case:
+//	container,impl,type,op,size,n,ns_per_op,allocs_per_op,bytes_per_element,samples
+// ns_per_op is the median of the repetitions, samples lists every one of them.
+// allocs_per_op counts operator new calls during the timed loop and
+// bytes_per_element is the heap (or inline) footprint of the filled
+// container. options: --reps N (default 5), --max-bytes N (skips larger
+// working sets), --filter NAME (only containers whose name contains NAME)
+// and --perf, which adds the hardware counters of the median repetition per
+// operation (cycles,instructions,l1d_misses,llc_misses,branch_misses,
+// dtlb_misses), left empty where perf_event_open is not allowed.
+// the sequence search scans for a missing value, so its ns_per_op is per
+// element scanned. mystl::deque sits on a list and has no random access case
+
+// allocation counting
+namespace
+{
+	// every block carries its size in front so delete can subtract it
+	constexpr size_t	g_Header		= __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+	size_t				g_Allocations	= 0;
+	size_t				g_LiveBytes		= 0;
+
+	void* counted_new(const size_t& bytes)
+	{
+		void* block = std::malloc(bytes + g_Header);
+		if (!block)
+			throw std::bad_alloc();
+
+		*static_cast<size_t*>(block) = bytes;
+		g_Allocations++;
+		g_LiveBytes += bytes;
+
+		return static_cast<char*>(block) + g_Header;
+	}
+
+	void counted_delete(void* ptr)
+	{
+		if (!ptr)
+			return;
+
+		void* block = static_cast<char*>(ptr) - g_Header;
+		g_LiveBytes -= *static_cast<size_t*>(block);
+		std::free(block);
+	}
+}
+
+void* operator new(size_t bytes) { return counted_new(bytes); }
+void* operator new[](size_t bytes) { return counted_new(bytes); }
+void* operator new(size_t bytes, const std::nothrow_t&) noexcept { try { return counted_new(bytes); } catch (...) { return nullptr; } }
+void* operator new[](size_t bytes, const std::nothrow_t&) noexcept { try { return counted_new(bytes); } catch (...) { return nullptr; } }
+void operator delete(void* ptr) noexcept { counted_delete(ptr); }
+void operator delete[](void* ptr) noexcept { counted_delete(ptr); }
+void operator delete(void* ptr, size_t) noexcept { counted_delete(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { counted_delete(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { counted_delete(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { counted_delete(ptr); }
+
+// element types
+namespace
+{
+	struct record
+	{
+		uint64_t	key;
+		uint32_t	a;
+		uint32_t	b;
+		double		value;
+		double		weight;
+
+		bool operator==(const record& other) const { return key == other.key; }
+		bool operator<(const record& other) const { return key < other.key; }
+		bool operator>(const record& other) const { return key > other.key; }
+	};
+
+	template<typename T>
+	T make(const uint64_t& i)
+	{
+		if constexpr (std::is_same_v<T, std::string>)
+			return "key" + std::to_string(i);
+		else if constexpr (std::is_same_v<T, record>)
+			return record{ i, uint32_t(i), uint32_t(i >> 32), double(i), 1.0 };
+		else
+			return T(i);
+	}
+
+	template<typename T>
+	uint64_t fold(const T& element)
+	{
+		if constexpr (std::is_same_v<T, std::string>)
+			return element.size();
+		else if constexpr (std::is_same_v<T, record>)
+			return element.key;
+		else
+			return uint64_t(element);
+	}
+
+	template<typename T> constexpr const char* type_name();
+	template<> constexpr const char* type_name<uint32_t>() { return "uint32_t"; }
+	template<> constexpr const char* type_name<record>() { return "record"; }
+	template<> constexpr const char* type_name<std::string>() { return "string"; }
+}
+
+// harness
+namespace
+{
+	struct options
+	{
+		size_t			reps		= 5;
+		size_t			maxBytes	= size_t(64) << 20;
+		const char*		filter		= nullptr;
+		bench::perf_counters* counters = nullptr;
+	};
+
+	struct working_set
+	{
+		const char*		label;
+		size_t			bytes;
+	};
+
+	constexpr working_set g_Sizes[] = { { "l1", size_t(16) << 10 }, { "l2", size_t(256) << 10 }, { "l3", size_t(4) << 20 }, { "dram", size_t(64) << 20 } };
+
+	struct suite
+	{
+		const char*		container;
+		const char*		impl;
+		const char*		type;
+		const char*		size;
+		size_t			count;
+		double			bytesPerElement;
+	};
+
+	// prepare(state) runs untimed before every repetition (refill, reset),
+	// operation(state) does count operations
+	template<class State, class Prepare, class Operation>
+	void measure(const suite& info, const options& opts, const char* op, State& state, const Prepare& prepare, const Operation& operation)
+	{
+		std::vector<double> samples(opts.reps);
+		std::vector<std::array<double, bench::counter_count>> events(opts.reps);
+		size_t allocations = 0;
+
+		for (size_t i = 0; i < opts.reps; i++)
+		{
+			prepare(state);
+			size_t allocationsBefore = g_Allocations;
+
+			if (opts.counters)
+				opts.counters->start();
+
+			auto start = std::chrono::steady_clock::now();
+			operation(state);
+			auto stop = std::chrono::steady_clock::now();
+
+			if (opts.counters)
+			{
+				opts.counters->stop();
+				for (size_t c = 0; c < bench::counter_count; c++)
+					events[i][c] = opts.counters->value(bench::counter(c));
+			}
+
+			allocations = g_Allocations - allocationsBefore;
+			samples[i] = std::chrono::duration<double, std::nano>(stop - start).count() / (double)info.count;
+		}
+
+		std::vector<size_t> ranks(opts.reps);
+		for (size_t i = 0; i < ranks.size(); i++)
+			ranks[i] = i;
+
+		std::sort(ranks.begin(), ranks.end(), [&](size_t left, size_t right) { return samples[left] < samples[right]; });
+		size_t median = ranks[ranks.size() / 2];
+
+		std::printf("%s,%s,%s,%s,%s,%zu,%.3f,%.4f,%.2f,", info.container, info.impl, info.type, op, info.size, info.count,
+			samples[median], (double)allocations / (double)info.count, info.bytesPerElement);
+		for (size_t i = 0; i < samples.size(); i++)
+			std::printf(i ? ";%.3f" : "%.3f", samples[i]);
+
+		if (opts.counters)
+		{
+			for (size_t c = 0; c < bench::counter_count; c++)
+			{
+				if (opts.counters->available(bench::counter(c)))
+					std::printf(",%.4f", events[median][c] / (double)info.count);
+				else
+					std::printf(",");
+			}
+		}
+		std::printf("\n");
+		std::fflush(stdout);
+	}
+
+	constexpr auto g_Nothing = [](auto&) { };
+
+	// the footprint of a freshly filled container, heap blocks plus the object
+	template<class Container, class Fill>
+	double footprint(const size_t& count, const Fill& fill)
+	{
+		size_t before = g_LiveBytes;
+		auto container = std::make_unique<Container>();
+		fill(*container);
+
+		return (double)(g_LiveBytes - before) / (double)count;
+	}
+
+	// the random access and lookup order, generated before anything is timed
+	std::vector<uint32_t> shuffled(const size_t& count, const uint32_t& seed)
+	{
+		std::vector<uint32_t> order(count);
+		for (size_t i = 0; i < count; i++)
+			order[i] = (uint32_t)i;
+
+		std::shuffle(order.begin(), order.end(), std::mt19937(seed));
+		return order;
+	}
+
+	template<bool Mine, class Iterator, typename T>
+	bool scan(Iterator first, Iterator last, const T& value)
+	{
+		if constexpr (Mine)
+			return mystl::find(first, last, value) != last;
+		else
+			return std::find(first, last, value) != last;
+	}
+}
+
+// containers
+namespace
+{
+	template<class Array, typename T, bool Mine>
+	void bench_array(suite info, const options& opts)
+	{
+		const size_t count = info.count;
+		const std::vector<uint32_t> order = shuffled(count, 1);
+		info.bytesPerElement = (double)sizeof(Array) / (double)count;
+
+		auto data = std::make_unique<Array>();
+		for (size_t i = 0; i < count; i++)
+			(*data)[i] = make<T>(i);
+
+		uint64_t sink = 0;
+		measure(info, opts, "iterate", *data, g_Nothing, [&](Array& array) { for (auto& element : array) sink += fold(element); });
+		measure(info, opts, "random", *data, g_Nothing, [&](Array& array) { for (uint32_t index : order) sink += fold(array[index]); });
+		measure(info, opts, "search", *data, g_Nothing, [&](Array& array) { sink += scan<Mine>(array.begin(), array.end(), make<T>(count)); });
+		bench::do_not_optimize(sink);
+	}
+
+	template<class Vector, typename T, bool Mine>
+	void bench_vector(suite info, const options& opts)
+	{
+		const size_t count = info.count;
+		const std::vector<uint32_t> order = shuffled(count, 2);
+		auto fill = [count](Vector& vector) { for (size_t i = 0; i < count; i++) vector.push_back(make<T>(i)); };
+		info.bytesPerElement = footprint<Vector>(count, fill);
+
+		auto data = std::make_unique<Vector>();
+		uint64_t sink = 0;
+
+		measure(info, opts, "push", *data, [](Vector& vector) { vector = Vector(); }, fill);
+		measure(info, opts, "emplace", *data, [](Vector& vector) { vector = Vector(); }, [count](Vector& vector) { for (size_t i = 0; i < count; i++) vector.emplace_back(make<T>(i)); });
+		measure(info, opts, "iterate", *data, g_Nothing, [&](Vector& vector) { for (auto& element : vector) sink += fold(element); });
+		measure(info, opts, "random", *data, g_Nothing, [&](Vector& vector) { for (uint32_t index : order) sink += fold(vector[index]); });
+		measure(info, opts, "search", *data, g_Nothing, [&](Vector& vector) { sink += scan<Mine>(vector.begin(), vector.end(), make<T>(count)); });
+		measure(info, opts, "pop", *data, [&](Vector& vector) { if (vector.empty()) fill(vector); }, [count](Vector& vector) { for (size_t i = 0; i < count; i++) vector.pop_back(); });
+		bench::do_not_optimize(sink);
+	}
+
+	template<class List, typename T, bool Mine>
+	void bench_list(suite info, const options& opts)
+	{
+		const size_t count = info.count;
+		auto fill = [count](List& list) { for (size_t i = 0; i < count; i++) list.push_back(make<T>(i)); };
+		info.bytesPerElement = footprint<List>(count, fill);
+
+		auto data = std::make_unique<List>();
+		uint64_t sink = 0;
+
+		measure(info, opts, "push", *data, [](List& list) { list = List(); }, fill);
+		measure(info, opts, "iterate", *data, g_Nothing, [&](List& list) { for (auto& element : list) sink += fold(element); });
+		measure(info, opts, "search", *data, g_Nothing, [&](List& list) { sink += scan<Mine>(list.begin(), list.end(), make<T>(count)); });
+		measure(info, opts, "pop", *data, [&](List& list) { if (list.empty()) fill(list); }, [count](List& list) { for (size_t i = 0; i < count; i++) list.pop_front(); });
+		bench::do_not_optimize(sink);
+	}
+
+	template<class Deque, typename T, bool Mine>
+	void bench_deque(suite info, const options& opts)
+	{
+		const size_t count = info.count;
+		auto fill = [count](Deque& deque) { for (size_t i = 0; i < count; i++) deque.push_back(make<T>(i)); };
+		info.bytesPerElement = footprint<Deque>(count, fill);
+
+		auto data = std::make_unique<Deque>();
+		uint64_t sink = 0;
+
+		measure(info, opts, "push", *data, [](Deque& deque) { deque = Deque(); }, fill);
+		measure(info, opts, "push_front", *data, [](Deque& deque) { deque = Deque(); }, [count](Deque& deque) { for (size_t i = 0; i < count; i++) deque.push_front(make<T>(i)); });
+		measure(info, opts, "iterate", *data, g_Nothing, [&](Deque& deque) { for (auto& element : deque) sink += fold(element); });
+		if constexpr (!Mine)
+		{
+			const std::vector<uint32_t> order = shuffled(count, 3);
+			measure(info, opts, "random", *data, g_Nothing, [&](Deque& deque) { for (uint32_t index : order) sink += fold(deque[index]); });
+		}
+		measure(info, opts, "search", *data, g_Nothing, [&](Deque& deque) { sink += scan<Mine>(deque.begin(), deque.end(), make<T>(count)); });
+		measure(info, opts, "pop", *data, [&](Deque& deque) { if (deque.empty()) fill(deque); }, [count](Deque& deque) { for (size_t i = 0; i < count; i++) deque.pop_front(); });
+		bench::do_not_optimize(sink);
+	}
+
+	// stack and queue: the top/front read keeps the pop from being elided
+	template<class Adapter, typename T>
+	void bench_adapter(suite info, const options& opts)
+	{
+		const size_t count = info.count;
+		auto fill = [count](Adapter& adapter) { for (size_t i = 0; i < count; i++) adapter.push(make<T>(i)); };
+		info.bytesPerElement = footprint<Adapter>(count, fill);
+
+		auto data = std::make_unique<Adapter>();
+		uint64_t sink = 0;
+
+		measure(info, opts, "push", *data, [](Adapter& adapter) { adapter = Adapter(); }, fill);
+		measure(info, opts, "pop", *data, [&](Adapter& adapter) { if (adapter.empty()) fill(adapter); }, [&](Adapter& adapter)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				if constexpr (requires { adapter.top(); })
+					sink += fold(adapter.top());
+				else
+					sink += fold(adapter.front());
+				adapter.pop();
+			}
+		});
+		bench::do_not_optimize(sink);
+	}
+
+	template<typename T> void tree_insert(std::set<T>& tree, const T& value) { tree.insert(value); }
+	template<typename T> void tree_insert(mystl::binary_search_tree<T>& tree, const T& value) { tree.push(value); }
+	template<typename T> bool tree_contains(const std::set<T>& tree, const T& value) { return tree.find(value) != tree.end(); }
+	template<typename T> bool tree_contains(const mystl::binary_search_tree<T>& tree, const T& value) { return tree.contains(value); }
+	template<typename T> void tree_erase(std::set<T>& tree, const T& value) { tree.erase(value); }
+	template<typename T> void tree_erase(mystl::binary_search_tree<T>& tree, const T& value) { tree.erase(value); }
+
+	// keys go in shuffled so the unbalanced tree stays about log n deep
+	template<class Tree, typename T>
+	void bench_tree(suite info, const options& opts)
+	{
+		const size_t count = info.count;
+		const std::vector<uint32_t> order = shuffled(count, 4);
+		const std::vector<uint32_t> lookups = shuffled(count, 5);
+		auto fill = [&](Tree& tree) { for (uint32_t key : order) tree_insert(tree, make<T>(key)); };
+		info.bytesPerElement = footprint<Tree>(count, fill);
+
+		auto data = std::make_unique<Tree>();
+		uint64_t sink = 0;
+
+		measure(info, opts, "push", *data, [](Tree& tree) { tree = Tree(); }, fill);
+		measure(info, opts, "search", *data, g_Nothing, [&](Tree& tree) { for (uint32_t key : lookups) sink += tree_contains(tree, make<T>(key)); });
+		measure(info, opts, "pop", *data, [&](Tree& tree) { if (tree.empty()) fill(tree); }, [&](Tree& tree) { for (uint32_t key : lookups) tree_erase(tree, make<T>(key)); });
+		bench::do_not_optimize(sink);
+	}
+}
+
+// drivers
+namespace
+{
+	bool selected(const options& opts, const char* container)
+	{
+		return !opts.filter || std::strstr(container, opts.filter);
+	}
+
+	template<typename T, size_t Bytes>
+	void run_arrays(const options& opts, const char* size)
+	{
+		constexpr size_t count = Bytes / sizeof(T);
+
+		bench_array<std::array<T, count>, T, false>({ "array", "std", type_name<T>(), size, count, 0 }, opts);
+		bench_array<mystl::array<T, count>, T, true>({ "array", "mystl", type_name<T>(), size, count, 0 }, opts);
+	}
+
+	template<typename T>
+	void run_type(const options& opts)
+	{
+		for (const working_set& set : g_Sizes)
+		{
+			if (set.bytes > opts.maxBytes)
+				break;
+
+			const size_t count = set.bytes / sizeof(T);
+			const char* type = type_name<T>();
+
+			if (selected(opts, "array"))
+			{
+				switch (set.bytes)
+				{
+				case size_t(16) << 10:	run_arrays<T, size_t(16) << 10>(opts, set.label); break;
+				case size_t(256) << 10:	run_arrays<T, size_t(256) << 10>(opts, set.label); break;
+				case size_t(4) << 20:	run_arrays<T, size_t(4) << 20>(opts, set.label); break;
+				default:				run_arrays<T, size_t(64) << 20>(opts, set.label); break;
+				}
+			}
+
+			if (selected(opts, "vector"))
+			{
+				bench_vector<std::vector<T>, T, false>({ "vector", "std", type, set.label, count, 0 }, opts);
+				bench_vector<mystl::vector<T>, T, true>({ "vector", "mystl", type, set.label, count, 0 }, opts);
+			}
+
+			if (selected(opts, "list"))
+			{
+				bench_list<std::list<T>, T, false>({ "list", "std", type, set.label, count, 0 }, opts);
+				bench_list<mystl::list<T>, T, true>({ "list", "mystl", type, set.label, count, 0 }, opts);
+			}
+
+			if (selected(opts, "deque"))
+			{
+				bench_deque<std::deque<T>, T, false>({ "deque", "std", type, set.label, count, 0 }, opts);
+				bench_deque<mystl::deque<T>, T, true>({ "deque", "mystl", type, set.label, count, 0 }, opts);
+			}
+
+			if (selected(opts, "stack"))
+			{
+				bench_adapter<std::stack<T>, T>({ "stack", "std", type, set.label, count, 0 }, opts);
+				bench_adapter<mystl::stack<T>, T>({ "stack", "mystl", type, set.label, count, 0 }, opts);
+			}
+
+			if (selected(opts, "queue"))
+			{
+				bench_adapter<std::queue<T>, T>({ "queue", "std", type, set.label, count, 0 }, opts);
+				bench_adapter<mystl::queue<T>, T>({ "queue", "mystl", type, set.label, count, 0 }, opts);
+			}
+
+			if (selected(opts, "binary_search_tree"))
+			{
+				bench_tree<std::set<T>, T>({ "binary_search_tree", "std", type, set.label, count, 0 }, opts);
+				bench_tree<mystl::binary_search_tree<T>, T>({ "binary_search_tree", "mystl", type, set.label, count, 0 }, opts);
+			}
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	options opts{};
+	bench::perf_counters counters{};
+
+	for (int i = 1; i < argc; i += 2)
+	{
+		if (!std::strcmp(argv[i], "--perf"))
+		{
+			opts.counters = &counters;
+			i--;
+		}
+		else if (i + 1 == argc)
+		{
+			std::fprintf(stderr, "%s needs a value\n", argv[i]);
+			return 1;
+		}
+		else if (!std::strcmp(argv[i], "--reps"))
+			opts.reps = std::max<size_t>(1, (size_t)std::strtoull(argv[i + 1], nullptr, 10));
+		else if (!std::strcmp(argv[i], "--max-bytes"))
+			opts.maxBytes = (size_t)std::strtoull(argv[i + 1], nullptr, 10);
+		else if (!std::strcmp(argv[i], "--filter"))
+			opts.filter = argv[i + 1];
+		else
+		{
+			std::fprintf(stderr, "usage: %s [--reps N] [--max-bytes N] [--filter NAME] [--perf]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	std::printf("container,impl,type,op,size,n,ns_per_op,allocs_per_op,bytes_per_element,samples");
+
+	if (opts.counters)
+	{
+		for (size_t c = 0; c < bench::counter_count; c++)
+			std::printf(",%s", bench::perf_counters::name(bench::counter(c)));
+
+		if (!counters.available())
+			std::fprintf(stderr, "hardware counters are unavailable (no PMU, or perf_event_paranoid is too strict), the counter columns stay empty\n");
+	}
+	std::printf("\n");
+
+	run_type<uint32_t>(opts);
+	run_type<record>(opts);
+	run_type<std::string>(opts);
+
+	return 0;
+}
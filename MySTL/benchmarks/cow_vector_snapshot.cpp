@@ -0,0 +1,51 @@
+#include <cstdint>
+
+#include "benchmark.h"
+#include "../src/data_structures/cow_vector.h"
+#include "../src/data_structures/vector.h"
+
+// publishes a snapshot of a large vector to a reader: mystl::vector copies
+// every element, cow_vector only bumps the shared reference count. the writer
+// then changes one element, which clones a shared cow_vector buffer once
+
+template<class Vector>
+static void snapshot(const char* name, const size_t& count)
+{
+	Vector vec{};
+	for (size_t i = 0; i < count; i++)
+		vec.push_back((uint64_t)i);
+
+	double copy = bench::best_of(5, [&]
+	{
+		Vector reader(vec);
+		bench::do_not_optimize(reader.size());
+	});
+
+	double write = bench::best_of(5, [&]
+	{
+		Vector reader(vec);
+		vec[0] = count;
+
+		// the reference from vec[0] is gone, so the next snapshot may share again
+		if constexpr (requires { vec.mark_shareable(); })
+			vec.mark_shareable();
+
+		bench::do_not_optimize(reader.size());
+	});
+
+	bench::report(name, count, copy);
+	bench::report("  + first write", count, write);
+}
+
+int main()
+{
+	const size_t sizes[] = { 1000, 100000, 10000000 };
+
+	for (size_t count : sizes)
+	{
+		snapshot<mystl::vector<uint64_t>>("mystl::vector<uint64_t>", count);
+		snapshot<mystl::cow_vector<uint64_t>>("mystl::cow_vector<uint64_t>", count);
+	}
+
+	return 0;
+}
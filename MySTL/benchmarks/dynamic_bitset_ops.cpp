@@ -0,0 +1,111 @@
+#include <cstdint>
+#include <cstdio>
+#include <random>
+
+#include "benchmark.h"
+#include "../src/data_structures/dynamic_bitset.h"
+#include "../src/data_structures/vector.h"
+
+// a visited set of count flags stored one byte per flag in mystl::vector<bool>
+// against dynamic_bitset, once per instruction set. reports the memory, the
+// popcount, a walk over the set bits and a bulk and of two sets
+
+static void run_bytes(const size_t& count, const mystl::vector<bool>& flags, const mystl::vector<bool>& other)
+{
+	const size_t reps = 5;
+
+	std::printf("-- mystl::vector<bool>: %zu MiB\n", flags.capacity() / (1 << 20));
+
+	bench::report("count", count, bench::best_of(reps, [&]()
+	{
+		size_t set = 0;
+		for (size_t i = 0; i < count; i++)
+			set += flags[i];
+		bench::do_not_optimize(set);
+	}));
+
+	bench::report("walk set bits", count, bench::best_of(reps, [&]()
+	{
+		size_t sum = 0;
+		for (size_t i = 0; i < count; i++)
+			if (flags[i])
+				sum += i;
+		bench::do_not_optimize(sum);
+	}));
+
+	mystl::vector<bool> result(flags);
+	bench::report("and", count, bench::best_of(reps, [&]()
+	{
+		for (size_t i = 0; i < count; i++)
+			result[i] = result[i] && other[i];
+		bench::do_not_optimize(result[0]);
+	}));
+}
+
+static void run_bits(const size_t& count, const mystl::dynamic_bitset<>& flags, const mystl::dynamic_bitset<>& other)
+{
+	const size_t reps = 5;
+	char name[64];
+
+	std::printf("-- mystl::dynamic_bitset: %zu MiB\n", flags.num_words() * sizeof(uint64_t) / (1 << 20));
+
+	for (int level = (int)mystl::simd::isa::scalar; level <= (int)mystl::simd::detect_isa(); level++)
+	{
+		mystl::simd::set_active_isa((mystl::simd::isa)level);
+		const char* isa = mystl::simd::isa_name(mystl::simd::active_isa());
+
+		std::snprintf(name, sizeof(name), "count (%s)", isa);
+		bench::report(name, count, bench::best_of(reps, [&]() { bench::do_not_optimize(flags.count()); }));
+
+		std::snprintf(name, sizeof(name), "walk set bits (%s)", isa);
+		bench::report(name, count, bench::best_of(reps, [&]()
+		{
+			size_t sum = 0;
+			for (size_t i = flags.find_first(); i != flags.npos; i = flags.find_next(i))
+				sum += i;
+			bench::do_not_optimize(sum);
+		}));
+
+		mystl::dynamic_bitset<> result(flags);
+		std::snprintf(name, sizeof(name), "and (%s)", isa);
+		bench::report(name, count, bench::best_of(reps, [&]()
+		{
+			result &= other;
+			bench::do_not_optimize(result.data()[0]);
+		}));
+	}
+
+	mystl::simd::set_active_isa(mystl::simd::detect_isa());
+}
+
+int main()
+{
+	const size_t count = (size_t)1 << 28;
+
+	// a sparse set (1 in 64) to walk and a dense one to and it with
+	std::mt19937_64 rng(7);
+	mystl::vector<bool> bytes(count, false);
+	mystl::vector<bool> otherBytes(count, false);
+	mystl::dynamic_bitset<> bits(count);
+	mystl::dynamic_bitset<> otherBits(count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		uint64_t r = rng();
+		if (r % 64 == 0)
+		{
+			bytes[i] = true;
+			bits.set(i);
+		}
+		if (r & 64)
+		{
+			otherBytes[i] = true;
+			otherBits.set(i);
+		}
+	}
+
+	run_bytes(count, bytes, otherBytes);
+	run_bits(count, bits, otherBits);
+
+	return 0;
+}
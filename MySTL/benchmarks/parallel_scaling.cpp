@@ -0,0 +1,81 @@
+#include <cmath>
+#include <cstdlib>
+#include <thread>
+
+#include "benchmark.h"
+#include "../src/algorithms/parallel.h"
+#include "../src/data_structures/vector.h"
+
+// runs the parallel algorithms over a 256 MiB vector on pools of 1, 2, 4 ...
+// threads up to the hardware thread count (or the first argument) and prints
+// the speedup over the single threaded pool. fill and copy are bound by
+// memory bandwidth, the transforms by arithmetic
+
+static void report_scaling(const char* name, const size_t& threads, const size_t& count, const double& ns, const double& baseline)
+{
+	char label[64];
+	std::snprintf(label, sizeof(label), "%s [%zu threads]", name, threads);
+
+	bench::report(label, count, ns);
+	std::printf("%-40s speedup %.2fx\n", "", baseline / ns);
+}
+
+int main(int argc, char** argv)
+{
+	const size_t count = size_t(64) << 20;
+	const size_t hardware = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+	const size_t maxThreads = argc > 1 && std::atoi(argv[1]) > 0 ? (size_t)std::atoi(argv[1]) : hardware;
+
+	mystl::vector<float> source{};
+	mystl::vector<float> dest{};
+	source.resize(count, 1.0f);
+	dest.resize(count);
+
+	double baseline[5] = {};
+
+	for (size_t threads = 1; ; threads = threads * 2 < maxThreads ? threads * 2 : maxThreads)
+	{
+		mystl::thread_pool pool(threads);
+		const auto policy = mystl::execution::par.on(pool);
+		double ns[5];
+
+		ns[0] = bench::best_of(5, [&]()
+		{
+			mystl::fill(policy, dest.begin(), dest.end(), 2.0f);
+		});
+
+		ns[1] = bench::best_of(5, [&]()
+		{
+			mystl::copy(policy, source.begin(), source.end(), dest.begin());
+		});
+
+		ns[2] = bench::best_of(5, [&]()
+		{
+			mystl::transform(policy, source.begin(), source.end(), dest.begin(), [](float x) { return std::sqrt(x) * std::exp(-x); });
+		});
+
+		ns[3] = bench::best_of(5, [&]()
+		{
+			bench::do_not_optimize(mystl::reduce(policy, source.cbegin(), source.cend(), 0.0));
+		});
+
+		ns[4] = bench::best_of(5, [&]()
+		{
+			bench::do_not_optimize(mystl::transform_reduce(policy, source.cbegin(), source.cend(), 0.0,
+				[](double a, double b) { return a + b; }, [](float x) { return (double)std::sin(x); }));
+		});
+
+		if (threads == 1)
+			for (size_t i = 0; i < 5; i++)
+				baseline[i] = ns[i];
+
+		const char* names[5] = { "fill", "copy", "transform", "reduce", "transform_reduce" };
+		for (size_t i = 0; i < 5; i++)
+			report_scaling(names[i], threads, count, ns[i], baseline[i]);
+
+		if (threads >= maxThreads)
+			break;
+	}
+
+	return 0;
+}
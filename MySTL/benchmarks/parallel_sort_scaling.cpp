@@ -0,0 +1,106 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <thread>
+
+#include "benchmark.h"
+#include "../src/algorithms/parallel.h"
+#include "../src/data_structures/vector.h"
+
+// sorts 64M random uint64_t (or the count given as the second argument) with
+// sort(par) and stable_sort(par), and merges two sorted halves with
+// merge(par), on pools of 1, 2, 4 ... threads up to the hardware thread count
+// (or the first argument). prints the speedup over the single threaded pool
+
+static void report_scaling(const char* name, const size_t& threads, const size_t& count, const double& ns, const double& baseline)
+{
+	char label[64];
+	std::snprintf(label, sizeof(label), "%s [%zu threads]", name, threads);
+
+	bench::report(label, count, ns);
+	std::printf("%-40s speedup %.2fx\n", "", baseline / ns);
+}
+
+// times fn on a fresh copy of input, best of reps
+template<class Function>
+static double time_sorted(const mystl::vector<uint64_t>& input, mystl::vector<uint64_t>& data, const size_t& reps, const Function& fn)
+{
+	double best = 0;
+
+	for (size_t i = 0; i < reps; i++)
+	{
+		data = input;
+
+		auto start = std::chrono::steady_clock::now();
+		fn();
+		auto stop = std::chrono::steady_clock::now();
+
+		double elapsed = std::chrono::duration<double, std::nano>(stop - start).count();
+		if (i == 0 || elapsed < best)
+			best = elapsed;
+	}
+
+	return best;
+}
+
+int main(int argc, char** argv)
+{
+	const size_t hardware = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+	const size_t maxThreads = argc > 1 && std::atoi(argv[1]) > 0 ? (size_t)std::atoi(argv[1]) : hardware;
+	const size_t count = argc > 2 && std::atoll(argv[2]) > 0 ? (size_t)std::atoll(argv[2]) : size_t(64) << 20;
+	const size_t reps = 3;
+
+	mystl::vector<uint64_t> input{};
+	mystl::vector<uint64_t> data{};
+	mystl::vector<uint64_t> halves{};
+	mystl::vector<uint64_t> merged{};
+
+	std::mt19937_64 rng(13);
+	input.reserve(count);
+	for (size_t i = 0; i < count; i++)
+		input.push_back(rng());
+
+	halves = input;
+	mystl::sort(halves.begin(), halves.begin() + count / 2);
+	mystl::sort(halves.begin() + count / 2, halves.end());
+	merged.resize(count);
+
+	double baseline[3] = {};
+
+	for (size_t threads = 1; ; threads = threads * 2 < maxThreads ? threads * 2 : maxThreads)
+	{
+		mystl::thread_pool pool(threads);
+		const auto policy = mystl::execution::par.on(pool);
+		double ns[3];
+
+		ns[0] = time_sorted(input, data, reps, [&]()
+		{
+			mystl::sort(policy, data.begin(), data.end());
+		});
+
+		ns[1] = time_sorted(input, data, reps, [&]()
+		{
+			mystl::stable_sort(policy, data.begin(), data.end());
+		});
+
+		ns[2] = bench::best_of(reps, [&]()
+		{
+			mystl::merge(policy, halves.cbegin(), halves.cbegin() + count / 2, halves.cbegin() + count / 2, halves.cend(), merged.begin());
+		});
+
+		if (threads == 1)
+			for (size_t i = 0; i < 3; i++)
+				baseline[i] = ns[i];
+
+		const char* names[3] = { "sort", "stable_sort", "merge" };
+		for (size_t i = 0; i < 3; i++)
+			report_scaling(names[i], threads, count, ns[i], baseline[i]);
+
+		if (threads >= maxThreads)
+			break;
+	}
+
+	bench::do_not_optimize(merged[count / 2]);
+	return 0;
+}
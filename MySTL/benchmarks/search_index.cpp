@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "benchmark.h"
+#include "../src/algorithms/algorithm.h"
+#include "../src/data_structures/binary_search_tree.h"
+#include "../src/data_structures/static_search_index.h"
+#include "../src/data_structures/vector.h"
+
+// 1M random lookups into sorted int32_t keys, from 4K keys (16 KB, fits in
+// L1) to 64M keys (256 MB, DRAM): std::lower_bound, the branchless
+// mystl::lower_bound, static_search_index in both layouts and
+// binary_search_tree::search. the tree is built in random order and only up
+// to 4M keys, its nodes alone outgrow memory after that. an optional
+// argument caps the key count, e.g. "search_index 1000000"
+
+static constexpr size_t lookups = 1000000;
+
+template<class Search>
+static void time_search(const char* name, const mystl::vector<int32_t>& queries, const Search& search)
+{
+	size_t hits = 0;
+
+	double ns = bench::best_of(3, [&]()
+	{
+		for (size_t i = 0; i < queries.size(); i++)
+			hits += search(queries.data()[i]);
+	});
+
+	bench::do_not_optimize(hits);
+	bench::report(name, queries.size(), ns);
+}
+
+int main(int argc, char** argv)
+{
+	const size_t sizes[] = { 4096, 65536, 1048576, 4194304, 16777216, 67108864 };
+	const size_t limit = argc > 1 ? (size_t)std::strtoull(argv[1], nullptr, 10) : sizes[5];
+	std::mt19937 rng(19);
+
+	for (size_t count : sizes)
+	{
+		if (count > limit)
+			break;
+
+		// even keys, so about half the lookups miss
+		mystl::vector<int32_t> keys{};
+		keys.reserve(count);
+		for (size_t i = 0; i < count; i++)
+			keys.push_back((int32_t)(2 * i));
+
+		mystl::vector<int32_t> queries{};
+		queries.reserve(lookups);
+		for (size_t i = 0; i < lookups; i++)
+			queries.push_back((int32_t)(rng() % (2 * count)));
+
+		const int32_t* first = keys.data();
+		const int32_t* last = keys.data() + count;
+
+		std::printf("-- %zu keys\n", count);
+		time_search("std::lower_bound", queries, [&](int32_t query) { return size_t(std::lower_bound(first, last, query) - first); });
+		time_search("mystl::lower_bound", queries, [&](int32_t query) { return size_t(mystl::lower_bound(first, last, query) - first); });
+
+		{
+			mystl::static_search_index<int32_t, mystl::search_layout::eytzinger> index(keys);
+			time_search("static_search_index eytzinger", queries, [&](int32_t query) { return index.lower_bound(query); });
+		}
+
+		{
+			mystl::static_search_index<int32_t, mystl::search_layout::btree> index(keys);
+			time_search("static_search_index btree", queries, [&](int32_t query) { return index.lower_bound(query); });
+		}
+
+		if (count <= 4194304)
+		{
+			mystl::vector<int32_t> order = keys;
+			std::shuffle(order.data(), order.data() + count, rng);
+
+			mystl::binary_search_tree<int32_t> tree{};
+			for (int32_t key : order)
+				tree.push(key);
+
+			time_search("binary_search_tree::search", queries, [&](int32_t query) { return size_t(tree.search(query) != nullptr); });
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,133 @@
+#include <cstdint>
+#include <cstdio>
+#include <random>
+
+#include "benchmark.h"
+#include "../src/algorithms/algorithm.h"
+#include "../src/data_structures/vector.h"
+
+// mystl::find, count, min_element, max_element, accumulate and equal against
+// the loops they replace, once per instruction set the cpu supports. the
+// needle is placed at the end so find has to scan the whole range
+
+template<typename T>
+static size_t plain_find(const T* data, const size_t& count, const T& value)
+{
+	for (size_t i = 0; i < count; i++)
+		if (data[i] == value)
+			return i;
+
+	return count;
+}
+
+template<typename T>
+static size_t plain_count(const T* data, const size_t& count, const T& value)
+{
+	size_t matches = 0;
+	for (size_t i = 0; i < count; i++)
+		if (data[i] == value)
+			matches++;
+
+	return matches;
+}
+
+template<typename T>
+static size_t plain_min(const T* data, const size_t& count)
+{
+	size_t best = 0;
+	for (size_t i = 1; i < count; i++)
+		if (data[i] < data[best])
+			best = i;
+
+	return best;
+}
+
+template<typename T>
+static size_t plain_max(const T* data, const size_t& count)
+{
+	size_t best = 0;
+	for (size_t i = 1; i < count; i++)
+		if (data[best] < data[i])
+			best = i;
+
+	return best;
+}
+
+template<typename T, typename S>
+static S plain_sum(const T* data, const size_t& count, S sum)
+{
+	for (size_t i = 0; i < count; i++)
+		sum += data[i];
+
+	return sum;
+}
+
+template<typename T>
+static bool plain_equal(const T* first, const T* second, const size_t& count)
+{
+	for (size_t i = 0; i < count; i++)
+		if (first[i] != second[i])
+			return false;
+
+	return true;
+}
+
+template<typename T, typename S>
+static void run(const char* type, const size_t& count, const S& init)
+{
+	const size_t reps = 20;
+	char name[64];
+
+	mystl::vector<T> data{};
+	mystl::vector<T> copy{};
+	std::mt19937 rng(7);
+
+	for (size_t i = 0; i + 1 < count; i++)
+		data.push_back(T(rng() % 100 + 1));
+	data.push_back(T(0));
+	copy.append(data.begin(), data.end());
+
+	const T* ptr = data.data();
+	const T* other = copy.data();
+	const T needle = T(0);
+
+	std::printf("-- %s\n", type);
+	bench::report("plain find", count, bench::best_of(reps, [&]() { bench::do_not_optimize(plain_find(ptr, count, needle)); }));
+	bench::report("plain count", count, bench::best_of(reps, [&]() { bench::do_not_optimize(plain_count(ptr, count, needle)); }));
+	bench::report("plain min_element", count, bench::best_of(reps, [&]() { bench::do_not_optimize(plain_min(ptr, count)); }));
+	bench::report("plain max_element", count, bench::best_of(reps, [&]() { bench::do_not_optimize(plain_max(ptr, count)); }));
+	bench::report("plain accumulate", count, bench::best_of(reps, [&]() { bench::do_not_optimize(plain_sum(ptr, count, init)); }));
+	bench::report("plain equal", count, bench::best_of(reps, [&]() { bench::do_not_optimize(plain_equal(ptr, other, count)); }));
+
+	for (int level = (int)mystl::simd::isa::scalar; level <= (int)mystl::simd::detect_isa(); level++)
+	{
+		mystl::simd::set_active_isa((mystl::simd::isa)level);
+		const char* isa = mystl::simd::isa_name(mystl::simd::active_isa());
+
+		std::snprintf(name, sizeof(name), "mystl::find (%s)", isa);
+		bench::report(name, count, bench::best_of(reps, [&]() { bench::do_not_optimize(mystl::find(data.begin(), data.end(), needle)); }));
+		std::snprintf(name, sizeof(name), "mystl::count (%s)", isa);
+		bench::report(name, count, bench::best_of(reps, [&]() { bench::do_not_optimize(mystl::count(data.begin(), data.end(), needle)); }));
+		std::snprintf(name, sizeof(name), "mystl::min_element (%s)", isa);
+		bench::report(name, count, bench::best_of(reps, [&]() { bench::do_not_optimize(mystl::min_element(data.begin(), data.end())); }));
+		std::snprintf(name, sizeof(name), "mystl::max_element (%s)", isa);
+		bench::report(name, count, bench::best_of(reps, [&]() { bench::do_not_optimize(mystl::max_element(data.begin(), data.end())); }));
+		std::snprintf(name, sizeof(name), "mystl::accumulate (%s)", isa);
+		bench::report(name, count, bench::best_of(reps, [&]() { bench::do_not_optimize(mystl::accumulate(data.begin(), data.end(), init)); }));
+		std::snprintf(name, sizeof(name), "mystl::equal (%s)", isa);
+		bench::report(name, count, bench::best_of(reps, [&]() { bench::do_not_optimize(mystl::equal(data.begin(), data.end(), copy.begin())); }));
+	}
+
+	mystl::simd::set_active_isa(mystl::simd::detect_isa());
+}
+
+int main()
+{
+	const size_t count = 1 << 20;
+
+	run<int32_t>("int32_t", count, int32_t(0));
+	run<float>("float", count, 0.0f);
+	run<uint8_t>("uint8_t", count, uint64_t(0));
+
+	return 0;
+}
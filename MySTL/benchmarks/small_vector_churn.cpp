@@ -0,0 +1,40 @@
+#include <vector>
+
+#include "benchmark.h"
+#include "../src/data_structures/small_vector.h"
+
+// creates, fills and destroys many short vectors: the per-request pattern
+// small_vector is meant for. mystl::vector and std::vector pay at least one
+// heap allocation per vector, small_vector pays none until it overflows
+
+template<class Vector>
+static double churn(const size_t& vectors, const size_t& elements)
+{
+	return bench::best_of(5, [&]()
+	{
+		for (size_t i = 0; i < vectors; i++)
+		{
+			Vector vec{};
+			for (size_t j = 0; j < elements; j++)
+				vec.push_back((int)(i + j));
+
+			bench::do_not_optimize(vec[0]);
+		}
+	});
+}
+
+int main()
+{
+	const size_t vectors = 1000000;
+	const size_t lengths[] = { 1, 4, 8, 16 };
+
+	for (size_t elements : lengths)
+	{
+		std::printf("-- %zu elements per vector\n", elements);
+		bench::report("std::vector<int>", vectors, churn<std::vector<int>>(vectors, elements));
+		bench::report("mystl::vector<int>", vectors, churn<mystl::vector<int>>(vectors, elements));
+		bench::report("mystl::small_vector<int, 8>", vectors, churn<mystl::small_vector<int, 8>>(vectors, elements));
+	}
+
+	return 0;
+}
@@ -0,0 +1,60 @@
+#include <cstdint>
+
+#include "benchmark.h"
+#include "../src/algorithms/algorithm.h"
+#include "../src/data_structures/soa_vector.h"
+#include "../src/data_structures/vector.h"
+
+// sums one field of a 64 byte row. mystl::vector<row> drags the whole row
+// through the cache for every element, soa_vector reads only the column, and
+// its column is a plain contiguous range the simd kernels pick up
+
+struct row
+{
+	int32_t		price;
+	int32_t		quantity;
+	uint64_t	id;
+	double		weights[6];
+};
+
+int main()
+{
+	const size_t count = size_t(4) << 20;
+
+	mystl::vector<row> rows{};
+	mystl::soa_vector<int32_t, int32_t, uint64_t, double> columns{};
+	rows.reserve(count);
+	columns.reserve(count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		rows.push_back(row{ (int32_t)(i & 1023), 1, i, {} });
+		columns.emplace_back((int32_t)(i & 1023), 1, (uint64_t)i, 0.0);
+	}
+
+	bench::report("mystl::vector<row> field loop", count, bench::best_of(5, [&]()
+	{
+		uint32_t sum = 0;
+		for (size_t i = 0; i < count; i++)
+			sum += (uint32_t)rows[i].price;
+
+		bench::do_not_optimize(sum);
+	}));
+
+	bench::report("mystl::soa_vector column loop", count, bench::best_of(5, [&]()
+	{
+		uint32_t sum = 0;
+		for (int32_t price : columns.column<0>())
+			sum += (uint32_t)price;
+
+		bench::do_not_optimize(sum);
+	}));
+
+	bench::report("mystl::soa_vector column accumulate", count, bench::best_of(5, [&]()
+	{
+		auto prices = columns.column<0>();
+		bench::do_not_optimize(mystl::accumulate(prices.begin(), prices.end(), uint32_t(0)));
+	}));
+
+	return 0;
+}
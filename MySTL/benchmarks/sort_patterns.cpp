@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "benchmark.h"
+#include "../src/algorithms/sort.h"
+#include "../src/data_structures/vector.h"
+
+// mystl::sort, stable_sort and radix_sort against std::sort and
+// std::stable_sort on random, sorted, reverse sorted and few-unique inputs
+// of uint32_t, from 1K to 100M elements. every run sorts a fresh copy of the
+// input and only the sort is timed. an optional argument caps the size, e.g.
+// "sort_patterns 10000000" skips the 100M runs
+
+enum class pattern { random, sorted, reverse, few_unique };
+
+static const char* pattern_name(const pattern& kind)
+{
+	switch (kind)
+	{
+	case pattern::sorted:		return "sorted";
+	case pattern::reverse:		return "reverse";
+	case pattern::few_unique:	return "few unique";
+	default:					return "random";
+	}
+}
+
+static mystl::vector<uint32_t> make_input(const size_t& count, const pattern& kind)
+{
+	mystl::vector<uint32_t> data{};
+	data.reserve(count);
+	std::mt19937 rng(11);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		switch (kind)
+		{
+		case pattern::sorted:		data.push_back((uint32_t)i); break;
+		case pattern::reverse:		data.push_back((uint32_t)(count - i)); break;
+		case pattern::few_unique:	data.push_back(rng() % 16); break;
+		default:					data.push_back(rng()); break;
+		}
+	}
+
+	return data;
+}
+
+template<class Sort>
+static void time_sort(const char* name, const mystl::vector<uint32_t>& input, const Sort& sort)
+{
+	const size_t count = input.size();
+	const size_t reps = count >= 10000000 ? 1 : 5;
+	mystl::vector<uint32_t> data{};
+	double best = 0;
+
+	for (size_t i = 0; i < reps; i++)
+	{
+		data = input;
+
+		auto start = std::chrono::steady_clock::now();
+		sort(data.data(), data.data() + count);
+		auto stop = std::chrono::steady_clock::now();
+
+		double elapsed = std::chrono::duration<double, std::nano>(stop - start).count();
+		if (i == 0 || elapsed < best)
+			best = elapsed;
+	}
+
+	bench::do_not_optimize(data[count / 2]);
+	bench::report(name, count, best);
+}
+
+int main(int argc, char** argv)
+{
+	const size_t sizes[] = { 1000, 100000, 10000000, 100000000 };
+	const size_t limit = argc > 1 ? (size_t)std::strtoull(argv[1], nullptr, 10) : sizes[3];
+	const pattern patterns[] = { pattern::random, pattern::sorted, pattern::reverse, pattern::few_unique };
+
+	for (size_t count : sizes)
+	{
+		if (count > limit)
+			break;
+
+		for (pattern kind : patterns)
+		{
+			mystl::vector<uint32_t> input = make_input(count, kind);
+
+			std::printf("-- %s\n", pattern_name(kind));
+			time_sort("std::sort", input, [](uint32_t* first, uint32_t* last) { std::sort(first, last); });
+			time_sort("mystl::sort", input, [](uint32_t* first, uint32_t* last) { mystl::sort(first, last); });
+			time_sort("std::stable_sort", input, [](uint32_t* first, uint32_t* last) { std::stable_sort(first, last); });
+			time_sort("mystl::stable_sort", input, [](uint32_t* first, uint32_t* last) { mystl::stable_sort(first, last); });
+			time_sort("mystl::radix_sort", input, [](uint32_t* first, uint32_t* last) { mystl::radix_sort(first, last); });
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,48 @@
+#include <chrono>
+#include <cstdint>
+
+#include "benchmark.h"
+#include "../src/data_structures/stable_vector.h"
+#include "../src/data_structures/vector.h"
+
+// times every push_back of a growing vector and reports the total and the
+// slowest single call. mystl::vector copies everything on each reallocation,
+// so its worst push grows with the size; stable_vector only allocates the
+// next block
+
+template<class Vector>
+static void latency(const char* name, const size_t& count)
+{
+	Vector vec{};
+	double worst = 0;
+
+	auto begin = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < count; i++)
+	{
+		auto start = std::chrono::steady_clock::now();
+		vec.push_back((uint64_t)i);
+		auto stop = std::chrono::steady_clock::now();
+
+		double elapsed = std::chrono::duration<double, std::nano>(stop - start).count();
+		if (elapsed > worst)
+			worst = elapsed;
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	bench::do_not_optimize(vec[count / 2]);
+	bench::report(name, count, std::chrono::duration<double, std::nano>(end - begin).count());
+	std::printf("%-40s worst push_back %.3f ms\n", "", worst / 1e6);
+}
+
+int main()
+{
+	const size_t sizes[] = { 100000, 10000000, 50000000 };
+
+	for (size_t count : sizes)
+	{
+		latency<mystl::vector<uint64_t>>("mystl::vector<uint64_t>", count);
+		latency<mystl::stable_vector<uint64_t>>("mystl::stable_vector<uint64_t>", count);
+	}
+
+	return 0;
+}
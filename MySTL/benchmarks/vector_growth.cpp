@@ -0,0 +1,93 @@
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#include "benchmark.h"
+#include "../src/data_structures/vector.h"
+
+// growth throughput of mystl::vector::emplace_back against the element by
+// element move/destroy loop that realloc used before the relocation layer
+
+struct record
+{
+	uint64_t	id;
+	uint32_t	a;
+	uint32_t	b;
+	double		value;
+};
+
+// reproduces the previous growth path: same growth rule, one move construct
+// and one destructor call per element on every reallocation
+template<typename T>
+class loop_vector
+{
+public:
+	~loop_vector()
+	{
+		for (size_t i = 0; i < m_Size; i++)
+			m_Data[i].~T();
+
+		::operator delete(m_Data, m_Capacity * sizeof(T));
+	}
+
+	void emplace_back(const T& element)
+	{
+		if (m_Size >= m_Capacity)
+			realloc(m_Size < 5 ? m_Capacity * 2 : m_Capacity + (m_Capacity << 1));
+
+		new(&m_Data[m_Size++]) T(element);
+	}
+
+	const T* data() const { return m_Data; }
+
+private:
+	void realloc(const size_t& newCapacity)
+	{
+		T* newBlock = (T*)::operator new(newCapacity * sizeof(T));
+
+		for (size_t i = 0; i < m_Size; i++)
+			new(&newBlock[i]) T(std::move(m_Data[i]));
+
+		for (size_t i = 0; i < m_Size; i++)
+			m_Data[i].~T();
+
+		::operator delete(m_Data, m_Capacity * sizeof(T));
+		m_Data = newBlock;
+		m_Capacity = newCapacity;
+	}
+
+private:
+	T*		m_Data		= (T*)::operator new(2 * sizeof(T));
+	size_t	m_Size		= 0;
+	size_t	m_Capacity	= 2;
+};
+
+template<class Vector, typename T>
+static double grow(const size_t& count, const T& element)
+{
+	return bench::best_of(5, [&]()
+	{
+		Vector vec{};
+		for (size_t i = 0; i < count; i++)
+			vec.emplace_back(element);
+
+		bench::do_not_optimize(vec.data());
+	});
+}
+
+int main()
+{
+	const size_t sizes[] = { 1000, 100000, 10000000 };
+
+	for (size_t count : sizes)
+	{
+		bench::report("loop_vector<int>::emplace_back", count, grow<loop_vector<int>>(count, 7));
+		bench::report("mystl::vector<int>::emplace_back", count, grow<mystl::vector<int>>(count, 7));
+
+		record element{ 1, 2, 3, 4.0 };
+		bench::report("loop_vector<record>::emplace_back", count, grow<loop_vector<record>>(count, element));
+		bench::report("mystl::vector<record>::emplace_back", count, grow<mystl::vector<record>>(count, element));
+	}
+
+	return 0;
+}
@@ -0,0 +1,314 @@
+#ifndef ALGORITHM_H
+#define ALGORITHM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "simd.h"
+#include "../data_structures/iterator.h"
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// algorithm																		///
+///																					///
+/// This file holds the mystl versions of the basic search and reduction			///
+/// algorithms. They work on any iterator pair. When the range is contiguous		///
+/// (raw pointers, array and vector iterators) and holds int32_t, float or			///
+/// uint8_t, the work is handed to the simd kernels in simd.h, which pick the		///
+/// widest instruction set the cpu supports at runtime. The binary searches			///
+/// run without a branch on the comparison over contiguous ranges.					///
+///																					///
+///////////////////////////////////////////////////////////////////////////////////////
+
+// iterator helpers
+namespace mystl
+{
+	// element type an iterator refers to. an iterator whose operator* returns
+	// a proxy by value (soa_vector rows) names the element with value_type, so
+	// a temporary taken out of the range holds the values, not the proxy
+	template<class Iterator>
+	struct iterator_value
+	{
+		using type = std::remove_cvref_t<decltype(*std::declval<Iterator&>())>;
+	};
+
+	template<class Iterator> requires (!std::is_reference_v<decltype(*std::declval<Iterator&>())>)
+	struct iterator_value<Iterator>
+	{
+		using type = typename Iterator::value_type;
+	};
+
+	template<class Iterator>
+	using iterator_value_t = typename iterator_value<Iterator>::type;
+
+	// true when [first, last) can be handed to the simd kernels as a raw array
+	template<class Iterator>
+	inline constexpr bool is_simd_range_v = is_contiguous_iterator_v<Iterator> && simd::has_kernels_v<iterator_value_t<Iterator>>;
+
+	// true when comparing elements of type E against a value of type T gives
+	// the same answers as comparing them against static_cast<E>(value), once
+	// values that do not survive the cast are ruled out. an integer element
+	// compared with a floating point value is converted (and rounded) first
+	template<typename E, typename T>
+	inline constexpr bool is_simd_needle_v = std::is_arithmetic_v<T> && !(std::is_floating_point_v<T> && std::is_integral_v<E>);
+}
+
+// search
+namespace mystl
+{
+	template<class Iterator, typename T>
+	constexpr Iterator
+		find(Iterator first, Iterator last, const T& value)
+	{
+		using element = iterator_value_t<Iterator>;
+
+		if constexpr (is_simd_range_v<Iterator> && is_simd_needle_v<element, T>)
+		{
+			if (!std::is_constant_evaluated() && first != last)
+			{
+				element needle = static_cast<element>(value);
+				if (!(needle == value))
+					return last;
+
+				return first + simd::find(&*first, size_t(last - first), needle);
+			}
+		}
+
+		for (; first != last; ++first)
+			if (*first == value)
+				return first;
+
+		return last;
+	}
+
+	template<class Iterator, typename T>
+	constexpr size_t
+		count(Iterator first, Iterator last, const T& value)
+	{
+		using element = iterator_value_t<Iterator>;
+
+		if constexpr (is_simd_range_v<Iterator> && is_simd_needle_v<element, T>)
+		{
+			if (!std::is_constant_evaluated() && first != last)
+			{
+				element needle = static_cast<element>(value);
+				if (!(needle == value))
+					return 0;
+
+				return simd::count(&*first, size_t(last - first), needle);
+			}
+		}
+
+		size_t matches = 0;
+		for (; first != last; ++first)
+			if (*first == value)
+				matches++;
+
+		return matches;
+	}
+
+	template<class Iterator1, class Iterator2>
+	constexpr bool
+		equal(Iterator1 first1, Iterator1 last1, Iterator2 first2)
+	{
+		if constexpr (is_simd_range_v<Iterator1> && is_contiguous_iterator_v<Iterator2> && std::is_same_v<iterator_value_t<Iterator1>, iterator_value_t<Iterator2>>)
+		{
+			if (!std::is_constant_evaluated())
+				return first1 == last1 || simd::equal(&*first1, &*first2, size_t(last1 - first1));
+		}
+
+		for (; first1 != last1; ++first1, ++first2)
+			if (!(*first1 == *first2))
+				return false;
+
+		return true;
+	}
+}
+
+// binary search
+namespace mystl
+{
+	// first element not ordered before value, last if there is none.
+	// contiguous ranges run the branchless search: the range is halved by a
+	// conditional move on every step instead of a branch on the comparison,
+	// and large ranges prefetch both possible midpoints of the next step
+	template<class Iterator, typename T, class Compare>
+	constexpr Iterator
+		lower_bound(Iterator first, Iterator last, const T& value, Compare comp)
+	{
+		if constexpr (is_contiguous_iterator_v<Iterator>)
+		{
+			if (first == last)
+				return last;
+
+			const auto* base = &*first;
+			size_t length = size_t(last - first);
+
+			while (length > 1)
+			{
+				size_t half = length / 2;
+
+				if (!std::is_constant_evaluated() && length >= 256)
+				{
+					simd::prefetch(base + half / 2);
+					simd::prefetch(base + half + half / 2);
+				}
+
+				base = comp(base[half], value) ? base + half : base;
+				length -= half;
+			}
+
+			return first + ((base - &*first) + comp(*base, value));
+		}
+		else
+		{
+			auto length = last - first;
+
+			while (length > 0)
+			{
+				auto half = length / 2;
+				Iterator middle = first + half;
+
+				if (comp(*middle, value))
+				{
+					first = middle + 1;
+					length -= half + 1;
+				}
+				else
+					length = half;
+			}
+
+			return first;
+		}
+	}
+
+	template<class Iterator, typename T>
+	constexpr Iterator
+		lower_bound(Iterator first, Iterator last, const T& value)
+	{
+		return mystl::lower_bound(first, last, value, std::less<>());
+	}
+
+	// first element ordered after value, last if there is none
+	template<class Iterator, typename T, class Compare>
+	constexpr Iterator
+		upper_bound(Iterator first, Iterator last, const T& value, Compare comp)
+	{
+		return mystl::lower_bound(first, last, value, [&comp](const auto& element, const T& key) { return !comp(key, element); });
+	}
+
+	template<class Iterator, typename T>
+	constexpr Iterator
+		upper_bound(Iterator first, Iterator last, const T& value)
+	{
+		return mystl::upper_bound(first, last, value, std::less<>());
+	}
+
+	// true when an element equivalent to value is in the sorted range
+	template<class Iterator, typename T, class Compare>
+	constexpr bool
+		binary_search(Iterator first, Iterator last, const T& value, Compare comp)
+	{
+		Iterator found = mystl::lower_bound(first, last, value, comp);
+		return found != last && !comp(value, *found);
+	}
+
+	template<class Iterator, typename T>
+	constexpr bool
+		binary_search(Iterator first, Iterator last, const T& value)
+	{
+		return mystl::binary_search(first, last, value, std::less<>());
+	}
+}
+
+// min/max
+namespace mystl
+{
+	// returns the first smallest element, last for an empty range
+	template<class Iterator>
+	constexpr Iterator
+		min_element(Iterator first, Iterator last)
+	{
+		if (first == last)
+			return last;
+
+		if constexpr (is_simd_range_v<Iterator>)
+		{
+			if (!std::is_constant_evaluated())
+				return first + simd::min_element(&*first, size_t(last - first));
+		}
+
+		Iterator best = first;
+		for (++first; first != last; ++first)
+			if (*first < *best)
+				best = first;
+
+		return best;
+	}
+
+	// returns the first largest element, last for an empty range
+	template<class Iterator>
+	constexpr Iterator
+		max_element(Iterator first, Iterator last)
+	{
+		if (first == last)
+			return last;
+
+		if constexpr (is_simd_range_v<Iterator>)
+		{
+			if (!std::is_constant_evaluated())
+				return first + simd::max_element(&*first, size_t(last - first));
+		}
+
+		Iterator best = first;
+		for (++first; first != last; ++first)
+			if (*best < *first)
+				best = first;
+
+		return best;
+	}
+}
+
+// numeric
+namespace mystl
+{
+	// adds every element to init. the simd kernels are used when the sum
+	// type allows it: int32_t and uint32_t sums over int32_t (wrapping),
+	// float sums over float (lane by lane, so rounding can differ from a
+	// left to right loop) and any integer sum over uint8_t
+	template<class Iterator, typename T>
+	constexpr T
+		accumulate(Iterator first, Iterator last, T init)
+	{
+		using element = iterator_value_t<Iterator>;
+
+		if constexpr (is_simd_range_v<Iterator>)
+		{
+			constexpr bool words = std::is_same_v<element, int32_t> && std::is_integral_v<T> && sizeof(T) == sizeof(int32_t);
+			constexpr bool floats = std::is_same_v<element, float> && std::is_same_v<T, float>;
+			constexpr bool bytes = std::is_same_v<element, uint8_t> && std::is_integral_v<T> && !std::is_same_v<T, bool>;
+
+			if constexpr (words || floats || bytes)
+			{
+				if (!std::is_constant_evaluated() && first != last)
+				{
+					auto sum = simd::accumulate(&*first, size_t(last - first));
+
+					if constexpr (words)
+						return T(uint32_t(init) + sum);
+					else
+						return T(init + T(sum));
+				}
+			}
+		}
+
+		for (; first != last; ++first)
+			init = init + *first;
+
+		return init;
+	}
+}
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+#if !defined(MYSTL_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define MYSTL_SIMD_X86 1
+#endif
+
+#if defined(MYSTL_SIMD_X86) && defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// cpu_features																	///
+///																					///
+/// This file detects which vector instruction sets the cpu and the operating		///
+/// system support. The simd kernels are compiled for every instruction set up		///
+/// front and the dispatching algorithms pick one at runtime through				///
+/// active_isa(), so one binary runs everywhere and uses the widest registers		///
+/// available. Defining MYSTL_NO_SIMD compiles the kernels out.						///
+///																					///
+///////////////////////////////////////////////////////////////////////////////////////
+
+namespace mystl::simd
+{
+	// instruction sets with a kernel, ordered so every entry implies the ones
+	// before it. avx2 and avx512 (avx512f + avx512bw) also imply popcnt
+	enum class isa
+	{
+		scalar,
+		sse2,
+		avx2,
+		avx512
+	};
+
+	inline const char*
+		isa_name(const isa& level)
+	{
+		switch (level)
+		{
+		case isa::sse2:		return "sse2";
+		case isa::avx2:		return "avx2";
+		case isa::avx512:	return "avx512";
+		default:			return "scalar";
+		}
+	}
+
+	// asks the cpu which instruction sets it has and checks that the os saves
+	// the wider registers on a context switch
+	inline isa
+		detect_isa()
+	{
+#if !defined(MYSTL_SIMD_X86)
+		return isa::scalar;
+#elif defined(_MSC_VER) && !defined(__clang__)
+		int info[4];
+
+		__cpuid(info, 0);
+		int maxLeaf = info[0];
+
+		__cpuid(info, 1);
+		if (!(info[3] & (1 << 26)))
+			return isa::scalar;
+
+		bool popcnt = info[2] & (1 << 23);
+		bool osxsave = info[2] & (1 << 27);
+		bool avx = info[2] & (1 << 28);
+		if (!popcnt || !osxsave || !avx || maxLeaf < 7)
+			return isa::sse2;
+
+		// xmm and ymm state (bits 1, 2), opmask and zmm state (bits 5 - 7)
+		unsigned long long xcr0 = _xgetbv(0);
+		if ((xcr0 & 0x06) != 0x06)
+			return isa::sse2;
+
+		__cpuidex(info, 7, 0);
+		bool avx2 = info[1] & (1 << 5);
+		bool avx512 = (info[1] & (1 << 16)) && (info[1] & (1 << 30)) && (xcr0 & 0xe6) == 0xe6;
+
+		if (avx512)
+			return isa::avx512;
+
+		return avx2 ? isa::avx2 : isa::sse2;
+#else
+		__builtin_cpu_init();
+
+		if (!__builtin_cpu_supports("popcnt"))
+			return __builtin_cpu_supports("sse2") ? isa::sse2 : isa::scalar;
+		if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+			return isa::avx512;
+		if (__builtin_cpu_supports("avx2"))
+			return isa::avx2;
+		if (__builtin_cpu_supports("sse2"))
+			return isa::sse2;
+
+		return isa::scalar;
+#endif
+	}
+
+	namespace detail
+	{
+		inline isa& active_isa_storage()
+		{
+			static isa level = detect_isa();
+			return level;
+		}
+	}
+
+	// the instruction set the dispatching algorithms use
+	inline isa
+		active_isa()
+	{
+		return detail::active_isa_storage();
+	}
+
+	// lowers (or restores) the instruction set used for dispatch, e.g. to
+	// compare kernels in a benchmark. never goes above what the cpu supports
+	inline void
+		set_active_isa(const isa& level)
+	{
+		isa detected = detect_isa();
+		detail::active_isa_storage() = level < detected ? level : detected;
+	}
+}
+
+#endif
@@ -0,0 +1,874 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "algorithm.h"
+#include "sort.h"
+#include "thread_pool.h"
+#include "../data_structures/allocator.h"
+#include "../data_structures/iterator.h"
+#include "../data_structures/memory.h"
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// parallel																		///
+///																					///
+/// This file holds the parallel versions of for_each, transform, reduce,			///
+/// transform_reduce, fill, copy, sort, stable_sort and merge. They take an			///
+/// execution policy first: execution::seq runs the plain loop, execution::par		///
+/// splits the range into tasks on a thread_pool. Only contiguous ranges (raw		///
+/// pointers, array and vector iterators) are split; task boundaries are placed		///
+/// on cache line boundaries of the range being written, so two threads never		///
+/// store into the same line. Ranges below the policy grain run inline on the		///
+/// caller.																			///
+///																					///
+///////////////////////////////////////////////////////////////////////////////////////
+
+// execution policies
+namespace mystl::execution
+{
+	struct sequenced_policy { };
+
+	struct parallel_policy
+	{
+		thread_pool*	pool	= nullptr;	// nullptr runs on thread_pool::global()
+		size_t			grain	= 16384;	// fewest elements worth a task of their own
+
+		constexpr parallel_policy on(thread_pool& target) const { return { &target, grain }; }
+		constexpr parallel_policy with_grain(const size_t& elements) const { return { pool, elements ? elements : 1 }; }
+	};
+
+	inline constexpr sequenced_policy	seq{};
+	inline constexpr parallel_policy	par{};
+
+	template<class Policy>
+	inline constexpr bool is_execution_policy_v = std::is_same_v<std::remove_cvref_t<Policy>, sequenced_policy>
+		|| std::is_same_v<std::remove_cvref_t<Policy>, parallel_policy>;
+}
+
+// partitioning
+namespace mystl::detail
+{
+	inline constexpr size_t cache_line_size = 64;
+
+	// tasks handed out per pool thread, so uneven tasks even out
+	inline constexpr size_t tasks_per_thread = 4;
+
+	// number of tasks for count elements, 1 when the range should run inline
+	inline size_t
+		task_count(const execution::parallel_policy& policy, const size_t& count)
+	{
+		thread_pool& pool = policy.pool ? *policy.pool : thread_pool::global();
+
+		if (pool.size() == 1 || count < 2 * policy.grain)
+			return 1;
+
+		size_t tasks = count / policy.grain;
+		size_t limit = pool.size() * tasks_per_thread;
+
+		return tasks < limit ? tasks : limit;
+	}
+
+	// first index of a task. the even split is pushed up to the next element
+	// that starts a cache line of data, when elements tile cache lines
+	template<typename T>
+	inline size_t
+		task_begin(const T* data, const size_t& count, const size_t& tasks, const size_t& task)
+	{
+		if (task == 0)
+			return 0;
+
+		if (task >= tasks)
+			return count;
+
+		size_t index = count / tasks * task + (task < count % tasks ? task : count % tasks);
+		size_t misalign = reinterpret_cast<uintptr_t>(data) % cache_line_size;
+
+		if constexpr (sizeof(T) <= cache_line_size && cache_line_size % sizeof(T) == 0)
+		{
+			if (misalign % sizeof(T) == 0)
+			{
+				const size_t perLine = cache_line_size / sizeof(T);
+				size_t aligned = (cache_line_size - misalign) % cache_line_size / sizeof(T);
+
+				index = index <= aligned ? aligned : aligned + (index - aligned + perLine - 1) / perLine * perLine;
+			}
+		}
+
+		return index < count ? index : count;
+	}
+
+	// calls fn(begin, end, task) for every task over [0, count). layout is the
+	// range whose cache lines the split respects
+	template<typename T, class Function>
+	inline void
+		parallel_tasks(const execution::parallel_policy& policy, const T* layout, const size_t& count, const size_t& tasks, const Function& fn)
+	{
+		if (tasks <= 1)
+		{
+			fn(size_t(0), count, size_t(0));
+			return;
+		}
+
+		thread_pool& pool = policy.pool ? *policy.pool : thread_pool::global();
+
+		pool.run(tasks, [&](const size_t& task)
+		{
+			size_t begin = task_begin(layout, count, tasks, task);
+			size_t end = task_begin(layout, count, tasks, task + 1);
+
+			if (begin < end)
+				fn(begin, end, task);
+		});
+	}
+
+	// one reduction result per task, each on its own cache line
+	template<typename T>
+	struct alignas(cache_line_size) partial_result
+	{
+		std::optional<T> value{};
+	};
+
+	template<class Iterator>
+	inline constexpr bool is_parallel_range_v = is_contiguous_iterator_v<Iterator>;
+}
+
+// for_each/transform
+namespace mystl
+{
+	template<class Policy, class Iterator, class Function>
+		requires execution::is_execution_policy_v<Policy>
+	inline void
+		for_each(Policy&& policy, Iterator first, Iterator last, Function fn)
+	{
+		if constexpr (std::is_same_v<std::remove_cvref_t<Policy>, execution::parallel_policy> && detail::is_parallel_range_v<Iterator>)
+		{
+			if (first == last)
+				return;
+
+			auto* data = &*first;
+			size_t count = size_t(last - first);
+
+			detail::parallel_tasks(policy, data, count, detail::task_count(policy, count), [&](const size_t& begin, const size_t& end, const size_t&)
+			{
+				for (size_t i = begin; i < end; i++)
+					fn(data[i]);
+			});
+
+			return;
+		}
+
+		for (; first != last; ++first)
+			fn(*first);
+	}
+
+	// writes fn(element) to out for every element, returns the end of the output
+	template<class Policy, class Iterator, class OutIterator, class Function>
+		requires execution::is_execution_policy_v<Policy>
+	inline OutIterator
+		transform(Policy&& policy, Iterator first, Iterator last, OutIterator out, Function fn)
+	{
+		if constexpr (std::is_same_v<std::remove_cvref_t<Policy>, execution::parallel_policy> && detail::is_parallel_range_v<Iterator> && detail::is_parallel_range_v<OutIterator>)
+		{
+			if (first == last)
+				return out;
+
+			auto* source = &*first;
+			auto* dest = &*out;
+			size_t count = size_t(last - first);
+
+			detail::parallel_tasks(policy, dest, count, detail::task_count(policy, count), [&](const size_t& begin, const size_t& end, const size_t&)
+			{
+				for (size_t i = begin; i < end; i++)
+					dest[i] = fn(source[i]);
+			});
+
+			return out + count;
+		}
+
+		for (; first != last; ++first, ++out)
+			*out = fn(*first);
+
+		return out;
+	}
+}
+
+// reduce/transform_reduce
+namespace mystl
+{
+	// folds transform(element) into init with op. op must be associative and
+	// commutative: the tasks fold their own elements, then the task results
+	// are folded into init in order
+	template<class Policy, class Iterator, typename T, class BinaryOp, class UnaryOp>
+		requires execution::is_execution_policy_v<Policy>
+	inline T
+		transform_reduce(Policy&& policy, Iterator first, Iterator last, T init, BinaryOp op, UnaryOp transform)
+	{
+		if constexpr (std::is_same_v<std::remove_cvref_t<Policy>, execution::parallel_policy> && detail::is_parallel_range_v<Iterator>)
+		{
+			if (first == last)
+				return init;
+
+			auto* data = &*first;
+			size_t count = size_t(last - first);
+			size_t tasks = detail::task_count(policy, count);
+
+			// new[] honours the cache line alignment of the slots
+			std::unique_ptr<detail::partial_result<T>[]> partials(new detail::partial_result<T>[tasks]);
+
+			detail::parallel_tasks(policy, data, count, tasks, [&](const size_t& begin, const size_t& end, const size_t& task)
+			{
+				T sum = T(transform(data[begin]));
+				for (size_t i = begin + 1; i < end; i++)
+					sum = op(sum, transform(data[i]));
+
+				partials[task].value.emplace(std::move(sum));
+			});
+
+			for (size_t task = 0; task < tasks; task++)
+				if (partials[task].value)
+					init = op(init, *partials[task].value);
+
+			return init;
+		}
+
+		for (; first != last; ++first)
+			init = op(init, transform(*first));
+
+		return init;
+	}
+
+	template<class Policy, class Iterator, typename T, class BinaryOp>
+		requires execution::is_execution_policy_v<Policy>
+	inline T
+		reduce(Policy&& policy, Iterator first, Iterator last, T init, BinaryOp op)
+	{
+		return transform_reduce(policy, first, last, init, op, [](const auto& element) -> const auto& { return element; });
+	}
+
+	// sums with operator+
+	template<class Policy, class Iterator, typename T>
+		requires execution::is_execution_policy_v<Policy>
+	inline T
+		reduce(Policy&& policy, Iterator first, Iterator last, T init)
+	{
+		return reduce(policy, first, last, init, [](const T& sum, const auto& element) { return T(sum + element); });
+	}
+}
+
+// fill/copy
+namespace mystl
+{
+	template<class Policy, class Iterator, typename T>
+		requires execution::is_execution_policy_v<Policy>
+	inline void
+		fill(Policy&& policy, Iterator first, Iterator last, const T& value)
+	{
+		for_each(policy, first, last, [&value](auto& element) { element = value; });
+	}
+
+	// copies [first, last) to out, the ranges must not overlap. returns the
+	// end of the output
+	template<class Policy, class Iterator, class OutIterator>
+		requires execution::is_execution_policy_v<Policy>
+	inline OutIterator
+		copy(Policy&& policy, Iterator first, Iterator last, OutIterator out)
+	{
+		if constexpr (std::is_same_v<std::remove_cvref_t<Policy>, execution::parallel_policy> && detail::is_parallel_range_v<Iterator> && detail::is_parallel_range_v<OutIterator>)
+		{
+			if (first == last)
+				return out;
+
+			auto* source = &*first;
+			auto* dest = &*out;
+			size_t count = size_t(last - first);
+
+			detail::parallel_tasks(policy, dest, count, detail::task_count(policy, count), [&](const size_t& begin, const size_t& end, const size_t&)
+			{
+				for (size_t i = begin; i < end; i++)
+					dest[i] = source[i];
+			});
+
+			return out + count;
+		}
+
+		for (; first != last; ++first, ++out)
+			*out = *first;
+
+		return out;
+	}
+}
+
+// sort/merge helpers
+namespace mystl::detail
+{
+	// number of elements of first among the first k elements of the stable
+	// merge of first and second (first wins ties). the other k - i come from
+	// second, so a merge can be cut at any output index without a search of
+	// the output
+	template<typename T, class Compare>
+	inline size_t
+		co_rank(const size_t& k, const T* first, const size_t& firstCount, const T* second, const size_t& secondCount, Compare& comp)
+	{
+		size_t low = k > secondCount ? k - secondCount : 0;
+		size_t high = k < firstCount ? k : firstCount;
+
+		while (low < high)
+		{
+			size_t i = low + (high - low) / 2;
+
+			if (!comp(second[k - i - 1], first[i]))
+				low = i + 1;
+			else
+				high = i;
+		}
+
+		return low;
+	}
+
+	// stable merge into out, which must not overlap the inputs. Move moves the
+	// elements out of the inputs instead of copying them
+	template<bool Move, typename T, typename U, class Compare>
+	inline void
+		merge_runs(T* first, const size_t& firstCount, T* second, const size_t& secondCount, U* out, Compare& comp)
+	{
+		T* firstEnd = first + firstCount;
+		T* secondEnd = second + secondCount;
+
+		auto take = [](T& element) -> decltype(auto)
+		{
+			if constexpr (Move)
+				return std::move(element);
+			else
+				return static_cast<const T&>(element);
+		};
+
+		while (first != firstEnd && second != secondEnd)
+		{
+			if (comp(*second, *first))
+				*out++ = take(*second++);
+			else
+				*out++ = take(*first++);
+		}
+
+		for (; first != firstEnd; ++first)
+			*out++ = take(*first);
+
+		for (; second != secondEnd; ++second)
+			*out++ = take(*second);
+	}
+
+	// index of the element of the first run of the pair holding output
+	// position of a merge round, as co_rank counts it (0 at the end)
+	template<typename T, class Compare>
+	inline size_t
+		round_rank(const T* source, const size_t* bounds, const size_t& runs, const size_t& position, Compare& comp)
+	{
+		for (size_t pair = 0; 2 * pair < runs; pair++)
+		{
+			size_t low = bounds[2 * pair];
+			size_t middle = bounds[2 * pair + 1];
+			size_t high = 2 * pair + 2 <= runs ? bounds[2 * pair + 2] : middle;
+
+			if (position < high)
+				return co_rank(position - low, source + low, middle - low, source + middle, high - middle, comp);
+		}
+
+		return 0;
+	}
+
+	// writes outputs [begin, end) of one merge round. runs are [bounds[r],
+	// bounds[r + 1]) and the round merges runs 2p and 2p + 1 into the same
+	// place in dest (a last run without a partner is moved over). a task's
+	// outputs can span several pairs. the ranks of begin and end come from
+	// round_rank before the round starts: the merges move elements out of
+	// source, which another task's co_rank would otherwise still read
+	template<typename T, class Compare>
+	inline void
+		merge_round(T* source, T* dest, const size_t* bounds, const size_t& runs, const size_t& begin, const size_t& end, const size_t& beginRank, const size_t& endRank, Compare& comp)
+	{
+		for (size_t pair = 0; 2 * pair < runs; pair++)
+		{
+			size_t low = bounds[2 * pair];
+			size_t middle = bounds[2 * pair + 1];
+			size_t high = 2 * pair + 2 <= runs ? bounds[2 * pair + 2] : middle;
+
+			if (high <= begin)
+				continue;
+			if (low >= end)
+				break;
+
+			size_t k0 = (begin > low ? begin : low) - low;
+			size_t k1 = (end < high ? end : high) - low;
+
+			size_t i0 = begin > low ? beginRank : 0;
+			size_t i1 = end < high ? endRank : middle - low;
+
+			merge_runs<true>(source + low + i0, i1 - i0, source + middle + (k0 - i0), (k1 - i1) - (k0 - i0), dest + low + k0, comp);
+		}
+	}
+
+	// elements sampled to pick a pivot: enough that a partition of millions of
+	// elements comes out close to even
+	inline constexpr size_t pivot_sample = 127;
+
+	// a range still to be partitioned. badAllowed counts the uneven partitions
+	// left before the range is handed to the sequential sort as it is, and
+	// leftmost is false when the pivot in front of the range bounds it
+	struct sort_range
+	{
+		size_t		begin;
+		size_t		end;
+		int			badAllowed;
+		bool		leftmost;
+	};
+
+	// moves the median of an evenly spaced sample of the range to the front
+	template<typename T, class Compare>
+	inline void
+		choose_pivot(T* data, const size_t& count, Compare& comp)
+	{
+		size_t sample[pivot_sample];
+		size_t samples = count < pivot_sample ? count : pivot_sample;
+
+		for (size_t i = 0; i < samples; i++)
+			sample[i] = count / samples * i + count / samples / 2;
+
+		mystl::sort(sample, sample + samples, [&](const size_t& a, const size_t& b) { return comp(data[a], data[b]); });
+
+		using std::swap;
+		swap(data[0], data[sample[samples / 2]]);
+	}
+
+	// moves the elements for which goesLeft holds to the front of [first,
+	// last) and returns the end of them. the branchless loop swaps every
+	// element with the end of the left side and only moves that end on, so
+	// random keys cost no mispredictions
+	template<bool Branchless, typename T, class Predicate>
+	inline T*
+		partition_piece(T* first, T* last, const Predicate& goesLeft)
+	{
+		using std::swap;
+
+		if constexpr (Branchless)
+		{
+			T* store = first;
+
+			for (; first != last; ++first)
+			{
+				bool left = goesLeft(*first);
+				swap(*store, *first);
+				store += left;
+			}
+
+			return store;
+		}
+
+		while (true)
+		{
+			while (first != last && goesLeft(*first))
+				++first;
+			while (first != last && !goesLeft(*(last - 1)))
+				--last;
+
+			if (first == last)
+				return first;
+
+			swap(*first++, *--last);
+		}
+	}
+
+	// partitions the range behind the pivot at data[0] and swaps the pivot
+	// in between the sides, returning its index. every task partitions its
+	// own piece, then the elements left on the wrong side of the final split
+	// are swapped pairwise, again split over the tasks. Equal sends elements
+	// equal to the pivot to the left side as well
+	template<bool Equal, typename T, class Compare>
+	inline size_t
+		parallel_partition(const execution::parallel_policy& policy, T* data, const size_t& count, Compare& comp)
+	{
+		T* items = data + 1;
+		size_t itemCount = count - 1;
+		size_t tasks = task_count(policy, itemCount);
+
+		auto goesLeft = [&](const T& element)
+		{
+			if constexpr (Equal)
+				return !comp(data[0], element);
+			else
+				return comp(element, data[0]);
+		};
+
+		vector<size_t> lefts{};
+		lefts.resize(tasks);
+
+		parallel_tasks(policy, items, itemCount, tasks, [&](const size_t& begin, const size_t& end, const size_t& task)
+		{
+			lefts[task] = size_t(partition_piece<is_branchless_compare_v<T, Compare>>(items + begin, items + end, goesLeft) - (items + begin));
+		});
+
+		size_t split = 0;
+		for (size_t task = 0; task < tasks; task++)
+			split += lefts[task];
+
+		// the right elements in front of the split and the left elements
+		// behind it, as (start, length) runs in order. both hold as many
+		vector<std::pair<size_t, size_t>> strays[2]{};
+		size_t strayCount = 0;
+
+		for (size_t task = 0; task < tasks; task++)
+		{
+			size_t begin = task_begin(items, itemCount, tasks, task);
+			size_t middle = begin + lefts[task];
+			size_t end = task_begin(items, itemCount, tasks, task + 1);
+
+			if (middle < split && middle < end)
+			{
+				size_t length = (end < split ? end : split) - middle;
+				strays[0].push_back({ middle, length });
+				strayCount += length;
+			}
+
+			if (begin < middle && split < middle)
+				strays[1].push_back({ begin > split ? begin : split, middle - (begin > split ? begin : split) });
+		}
+
+		size_t swapTasks = task_count(policy, strayCount);
+
+		if (strayCount)
+			parallel_tasks(policy, items, strayCount, swapTasks, [&](const size_t& begin, const size_t& end, const size_t&)
+		{
+			using std::swap;
+
+			// the runs holding stray number begin, on both sides
+			size_t run[2] = {};
+			size_t offset[2] = { begin, begin };
+
+			for (size_t side = 0; side < 2; side++)
+			{
+				while (offset[side] >= strays[side][run[side]].second)
+					offset[side] -= strays[side][run[side]++].second;
+			}
+
+			for (size_t i = begin; i < end; i++)
+			{
+				swap(items[strays[0][run[0]].first + offset[0]], items[strays[1][run[1]].first + offset[1]]);
+
+				for (size_t side = 0; side < 2; side++)
+				{
+					if (++offset[side] == strays[side][run[side]].second)
+					{
+						offset[side] = 0;
+						run[side]++;
+					}
+				}
+			}
+		});
+
+		using std::swap;
+		swap(data[0], data[split]);
+
+		return split;
+	}
+
+	// parallel quicksort with sampled pivots, in place: ranges are split by
+	// parallel_partition, one at a time with every thread on it, until they
+	// are small enough to give each pool thread a few. those are then sorted
+	// with sort, largest first, claimed from the pool's shared counter. no
+	// scratch memory beyond the bookkeeping of the partitions
+	template<typename T, class Compare>
+	inline void
+		parallel_partition_sort(const execution::parallel_policy& policy, T* data, const size_t& count, Compare& comp)
+	{
+		thread_pool& pool = policy.pool ? *policy.pool : thread_pool::global();
+
+		size_t leafSize = count / (pool.size() * tasks_per_thread);
+		if (leafSize < 2 * policy.grain)
+			leafSize = 2 * policy.grain;
+
+		if (pool.size() == 1 || count <= leafSize)
+		{
+			mystl::sort(data, data + count, comp);
+			return;
+		}
+
+		vector<sort_range> pending{};
+		vector<sort_range> leaves{};
+		pending.push_back({ 0, count, int(std::bit_width(count)), true });
+
+		while (!pending.empty())
+		{
+			sort_range range = pending.back();
+			pending.pop_back();
+
+			size_t size = range.end - range.begin;
+			if (size <= leafSize || range.badAllowed == 0)
+			{
+				leaves.push_back(range);
+				continue;
+			}
+
+			T* first = data + range.begin;
+			choose_pivot(first, size, comp);
+
+			// the pivot equals the one in front of the range, so many keys
+			// are equal: they all go left, where they are already in order
+			if (!range.leftmost && !comp(first[-1], first[0]))
+			{
+				size_t pivot = parallel_partition<true>(policy, first, size, comp);
+				pending.push_back({ range.begin + pivot + 1, range.end, range.badAllowed, false });
+				continue;
+			}
+
+			size_t pivot = parallel_partition<false>(policy, first, size, comp);
+			int badAllowed = pivot < size / 8 || size - pivot - 1 < size / 8 ? range.badAllowed - 1 : range.badAllowed;
+
+			pending.push_back({ range.begin, range.begin + pivot, badAllowed, range.leftmost });
+			pending.push_back({ range.begin + pivot + 1, range.end, badAllowed, false });
+		}
+
+		mystl::sort(leaves.begin(), leaves.end(), [](const sort_range& a, const sort_range& b) { return a.end - a.begin > b.end - b.begin; });
+
+		pool.run(leaves.size(), [&](const size_t& leaf)
+		{
+			mystl::sort(data + leaves[leaf].begin, data + leaves[leaf].end, comp);
+		});
+	}
+
+	// parallel stable merge sort: the range is cut into one run per pool
+	// thread, the runs are sorted on their own, then merged pairwise in
+	// rounds. every round is split into even, cache line aligned pieces of its
+	// output with co_rank, so the last merges keep all threads busy, and
+	// pieces are claimed from the pool's shared counter, so a slow thread
+	// takes fewer. the scratch buffer is one copy of the range, allocated
+	// once; the run sorts borrow their halves of it, so nothing else is
+	// allocated. merging in place with less would cost a rotation pass per
+	// halving of the runs, on every round
+	template<typename T, class Compare>
+	inline void
+		parallel_merge_sort(const execution::parallel_policy& policy, T* data, const size_t& count, Compare& comp)
+	{
+		thread_pool& pool = policy.pool ? *policy.pool : thread_pool::global();
+
+		size_t runs = pool.size();
+		if (count / policy.grain < runs)
+			runs = count / policy.grain;
+
+		if (runs <= 1)
+		{
+			mystl::stable_sort(data, data + count, comp);
+			return;
+		}
+
+		allocator<T> alloc{};
+		T* buffer = alloc.allocate(count);
+		size_t tasks = task_count(policy, count);
+
+		vector<size_t> bounds{};
+		for (size_t run = 0; run <= runs; run++)
+			bounds.push_back(count / runs * run + (run < count % runs ? run : count % runs));
+
+		// each run is sorted where it is, with the part of the buffer under
+		// it as the merge sort's scratch
+		try
+		{
+			pool.run(runs, [&](const size_t& run)
+			{
+				merge_sort(data + bounds[run], data + bounds[run + 1], buffer + bounds[run], comp);
+			});
+		}
+		catch (...)
+		{
+			alloc.deallocate(buffer, count);
+			throw;
+		}
+
+		// elements that are not trivially copyable need live objects on both
+		// sides, so they are moved into the buffer and merged from there
+		constexpr bool trivial = std::is_trivially_copyable_v<T>;
+		T* source = data;
+		T* dest = buffer;
+
+		if constexpr (!trivial)
+		{
+			parallel_tasks(policy, buffer, count, tasks, [&](const size_t& begin, const size_t& end, const size_t&)
+			{
+				for (size_t i = begin; i < end; i++)
+					new(&buffer[i]) T(std::move(data[i]));
+			});
+
+			std::swap(source, dest);
+		}
+
+		try
+		{
+			vector<size_t> ranks{};
+			ranks.resize(tasks + 1);
+
+			while (runs > 1)
+			{
+				for (size_t task = 0; task <= tasks; task++)
+					ranks[task] = round_rank(source, bounds.data(), runs, task_begin(dest, count, tasks, task), comp);
+
+				parallel_tasks(policy, dest, count, tasks, [&](const size_t& begin, const size_t& end, const size_t& task)
+				{
+					merge_round(source, dest, bounds.data(), runs, begin, end, ranks[task], ranks[task + 1], comp);
+				});
+
+				// the merged pairs become the runs of the next round
+				size_t kept = 0;
+				for (size_t bound = 0; bound <= runs; bound += 2)
+					bounds[kept++] = bounds[bound];
+				if (runs % 2)
+					bounds[kept++] = bounds[runs];
+
+				runs = kept - 1;
+				std::swap(source, dest);
+			}
+
+			if (source != data)
+			{
+				parallel_tasks(policy, data, count, tasks, [&](const size_t& begin, const size_t& end, const size_t&)
+				{
+					for (size_t i = begin; i < end; i++)
+						data[i] = std::move(source[i]);
+				});
+			}
+		}
+		catch (...)
+		{
+			// a throwing comparison leaves the range valid but in no order
+			if constexpr (!trivial)
+				destroy(buffer, count);
+
+			alloc.deallocate(buffer, count);
+			throw;
+		}
+
+		if constexpr (!trivial)
+			destroy(buffer, count);
+
+		alloc.deallocate(buffer, count);
+	}
+}
+
+// sort/merge
+namespace mystl
+{
+	template<class Policy, class Iterator, class Compare>
+		requires execution::is_execution_policy_v<Policy>
+	inline void
+		sort(Policy&& policy, Iterator first, Iterator last, Compare comp)
+	{
+		if constexpr (std::is_same_v<std::remove_cvref_t<Policy>, execution::parallel_policy> && detail::is_parallel_range_v<Iterator>)
+		{
+			if (first != last)
+				detail::parallel_partition_sort(policy, &*first, size_t(last - first), comp);
+
+			return;
+		}
+
+		mystl::sort(first, last, comp);
+	}
+
+	template<class Policy, class Iterator>
+		requires execution::is_execution_policy_v<Policy>
+	inline void
+		sort(Policy&& policy, Iterator first, Iterator last)
+	{
+		mystl::sort(policy, first, last, std::less<>());
+	}
+
+	template<class Policy, class Iterator, class Compare>
+		requires execution::is_execution_policy_v<Policy>
+	inline void
+		stable_sort(Policy&& policy, Iterator first, Iterator last, Compare comp)
+	{
+		if constexpr (std::is_same_v<std::remove_cvref_t<Policy>, execution::parallel_policy> && detail::is_parallel_range_v<Iterator>)
+		{
+			if (first != last)
+				detail::parallel_merge_sort(policy, &*first, size_t(last - first), comp);
+
+			return;
+		}
+
+		mystl::stable_sort(first, last, comp);
+	}
+
+	template<class Policy, class Iterator>
+		requires execution::is_execution_policy_v<Policy>
+	inline void
+		stable_sort(Policy&& policy, Iterator first, Iterator last)
+	{
+		mystl::stable_sort(policy, first, last, std::less<>());
+	}
+
+	// merges the sorted ranges [first1, last1) and [first2, last2) into out,
+	// which must not overlap them. stable: equal elements of the first range
+	// come first. each task finds its inputs for its part of the output with
+	// co_rank. returns the end of the output
+	template<class Policy, class Iterator1, class Iterator2, class OutIterator, class Compare>
+		requires execution::is_execution_policy_v<Policy>
+	inline OutIterator
+		merge(Policy&& policy, Iterator1 first1, Iterator1 last1, Iterator2 first2, Iterator2 last2, OutIterator out, Compare comp)
+	{
+		if constexpr (std::is_same_v<std::remove_cvref_t<Policy>, execution::parallel_policy> && detail::is_parallel_range_v<Iterator1>
+			&& detail::is_parallel_range_v<Iterator2> && detail::is_parallel_range_v<OutIterator>
+			&& std::is_same_v<iterator_value_t<Iterator1>, iterator_value_t<Iterator2>>)
+		{
+			size_t firstCount = size_t(last1 - first1);
+			size_t secondCount = size_t(last2 - first2);
+			size_t count = firstCount + secondCount;
+
+			if (count == 0)
+				return out;
+
+			const auto* first = firstCount ? &*first1 : nullptr;
+			const auto* second = secondCount ? &*first2 : nullptr;
+			auto* dest = &*out;
+
+			detail::parallel_tasks(policy, dest, count, detail::task_count(policy, count), [&](const size_t& begin, const size_t& end, const size_t&)
+			{
+				size_t i0 = detail::co_rank(begin, first, firstCount, second, secondCount, comp);
+				size_t i1 = detail::co_rank(end, first, firstCount, second, secondCount, comp);
+
+				detail::merge_runs<false>(first + i0, i1 - i0, second + (begin - i0), (end - i1) - (begin - i0), dest + begin, comp);
+			});
+
+			return out + count;
+		}
+
+		while (first1 != last1 && first2 != last2)
+		{
+			if (comp(*first2, *first1))
+				*out++ = *first2++;
+			else
+				*out++ = *first1++;
+		}
+
+		for (; first1 != last1; ++first1)
+			*out++ = *first1;
+
+		for (; first2 != last2; ++first2)
+			*out++ = *first2;
+
+		return out;
+	}
+
+	template<class Policy, class Iterator1, class Iterator2, class OutIterator>
+		requires execution::is_execution_policy_v<Policy>
+	inline OutIterator
+		merge(Policy&& policy, Iterator1 first1, Iterator1 last1, Iterator2 first2, Iterator2 last2, OutIterator out)
+	{
+		return mystl::merge(policy, first1, last1, first2, last2, out, std::less<>());
+	}
+}
+
+#endif
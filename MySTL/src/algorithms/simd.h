@@ -0,0 +1,514 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "cpu_features.h"
+
+#if defined(MYSTL_SIMD_X86)
+#include <immintrin.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// simd																			///
+///																					///
+/// This file holds the vector kernels behind the mystl algorithms for arrays		///
+/// of int32_t, float and uint8_t. Every kernel exists once per instruction set		///
+/// (scalar, sse2, avx2, avx512): the shared bodies live in simd_kernels.inl and	///
+/// are compiled once per set with the matching target, while the small ops			///
+/// structs below wrap the intrinsics for each register width. The functions in		///
+/// mystl::simd pick the kernel for active_isa() on every call.						///
+///																					///
+///////////////////////////////////////////////////////////////////////////////////////
+
+// compiles the functions between begin and end for the given target. msvc
+// accepts every intrinsic without a target, so the markers are empty there
+#if defined(__clang__)
+#define MYSTL_SIMD_PRAGMA(x)				_Pragma(#x)
+#define MYSTL_SIMD_TARGET_BEGIN(features)	MYSTL_SIMD_PRAGMA(clang attribute push(__attribute__((target(features))), apply_to = function))
+#define MYSTL_SIMD_TARGET_END				MYSTL_SIMD_PRAGMA(clang attribute pop)
+#elif defined(__GNUC__)
+#define MYSTL_SIMD_PRAGMA(x)				_Pragma(#x)
+#define MYSTL_SIMD_TARGET_BEGIN(features)	MYSTL_SIMD_PRAGMA(GCC push_options) MYSTL_SIMD_PRAGMA(GCC target(features))
+#define MYSTL_SIMD_TARGET_END				MYSTL_SIMD_PRAGMA(GCC pop_options)
+#else
+#define MYSTL_SIMD_TARGET_BEGIN(features)
+#define MYSTL_SIMD_TARGET_END
+#endif
+
+// element types with kernels
+namespace mystl::simd
+{
+	template<typename T>
+	inline constexpr bool has_kernels_v = std::is_same_v<T, int32_t> || std::is_same_v<T, float> || std::is_same_v<T, uint8_t>;
+
+	// what accumulate adds up in: int32_t wraps (as uint32_t), uint8_t widens
+	template<typename T>
+	struct sum_type { using type = T; };
+
+	template<>
+	struct sum_type<int32_t> { using type = uint32_t; };
+
+	template<>
+	struct sum_type<uint8_t> { using type = uint64_t; };
+
+	template<typename T>
+	using sum_type_t = typename sum_type<T>::type;
+}
+
+// prefetch
+namespace mystl::simd
+{
+	// asks for the cache line holding address ahead of a load that depends on
+	// a comparison (the next levels of a search). never faults, so address
+	// may lie past the end of an array
+	inline void
+		prefetch(const void* address)
+	{
+#if defined(MYSTL_SIMD_X86)
+		_mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#elif defined(__GNUC__) || defined(__clang__)
+		__builtin_prefetch(address);
+#else
+		(void)address;
+#endif
+	}
+}
+
+// scalar kernels: the fallback and the tail loop of the vector kernels.
+// positions are returned as indices, count means not found
+namespace mystl::simd::scalar
+{
+	template<typename T>
+	constexpr size_t
+		find(const T* data, const size_t& count, const T& value)
+	{
+		for (size_t i = 0; i < count; i++)
+			if (data[i] == value)
+				return i;
+
+		return count;
+	}
+
+	template<typename T>
+	constexpr size_t
+		count(const T* data, const size_t& count, const T& value)
+	{
+		size_t matches = 0;
+
+		for (size_t i = 0; i < count; i++)
+			matches += data[i] == value;
+
+		return matches;
+	}
+
+	template<typename T>
+	constexpr size_t
+		min_element(const T* data, const size_t& count)
+	{
+		size_t best = 0;
+
+		for (size_t i = 1; i < count; i++)
+			if (data[i] < data[best])
+				best = i;
+
+		return count ? best : 0;
+	}
+
+	template<typename T>
+	constexpr size_t
+		max_element(const T* data, const size_t& count)
+	{
+		size_t best = 0;
+
+		for (size_t i = 1; i < count; i++)
+			if (data[best] < data[i])
+				best = i;
+
+		return count ? best : 0;
+	}
+
+	template<typename T>
+	constexpr sum_type_t<T>
+		accumulate(const T* data, const size_t& count)
+	{
+		sum_type_t<T> sum = 0;
+
+		for (size_t i = 0; i < count; i++)
+			sum += data[i];
+
+		return sum;
+	}
+
+	template<typename T>
+	constexpr bool
+		equal(const T* first, const T* second, const size_t& count)
+	{
+		for (size_t i = 0; i < count; i++)
+			if (!(first[i] == second[i]))
+				return false;
+
+		return true;
+	}
+}
+
+#if defined(MYSTL_SIMD_X86)
+
+// sse2 kernels (16 byte registers)
+MYSTL_SIMD_TARGET_BEGIN("sse2")
+namespace mystl::simd::sse2
+{
+	template<typename T>
+	struct ops;
+
+	template<>
+	struct ops<int32_t>
+	{
+		using vec = __m128i;
+		using acc = __m128i;
+		static constexpr size_t width = 4;
+
+		static vec load(const int32_t* ptr) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)); }
+		static void store(int32_t* ptr, vec v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(ptr), v); }
+		static vec set1(int32_t value) { return _mm_set1_epi32(value); }
+		static uint64_t eq(vec a, vec b) { return (uint64_t)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b))); }
+		static uint64_t unordered(vec) { return 0; }
+
+		// sse2 has no pminsd/pmaxsd, select through a compare mask
+		static vec min(vec a, vec b) { vec lt = _mm_cmplt_epi32(a, b); return _mm_or_si128(_mm_and_si128(lt, a), _mm_andnot_si128(lt, b)); }
+		static vec max(vec a, vec b) { vec gt = _mm_cmpgt_epi32(a, b); return _mm_or_si128(_mm_and_si128(gt, a), _mm_andnot_si128(gt, b)); }
+
+		static acc zero() { return _mm_setzero_si128(); }
+		static acc add(acc sum, vec v) { return _mm_add_epi32(sum, v); }
+		static acc combine(acc a, acc b) { return _mm_add_epi32(a, b); }
+		static uint32_t reduce_add(acc sum) { alignas(16) uint32_t lanes[4]; _mm_store_si128(reinterpret_cast<__m128i*>(lanes), sum); return lanes[0] + lanes[1] + lanes[2] + lanes[3]; }
+	};
+
+	template<>
+	struct ops<float>
+	{
+		using vec = __m128;
+		using acc = __m128;
+		static constexpr size_t width = 4;
+
+		static vec load(const float* ptr) { return _mm_loadu_ps(ptr); }
+		static void store(float* ptr, vec v) { _mm_storeu_ps(ptr, v); }
+		static vec set1(float value) { return _mm_set1_ps(value); }
+		static uint64_t eq(vec a, vec b) { return (uint64_t)_mm_movemask_ps(_mm_cmpeq_ps(a, b)); }
+		static uint64_t unordered(vec v) { return (uint64_t)_mm_movemask_ps(_mm_cmpunord_ps(v, v)); }
+
+		static vec min(vec a, vec b) { return _mm_min_ps(a, b); }
+		static vec max(vec a, vec b) { return _mm_max_ps(a, b); }
+
+		static acc zero() { return _mm_setzero_ps(); }
+		static acc add(acc sum, vec v) { return _mm_add_ps(sum, v); }
+		static acc combine(acc a, acc b) { return _mm_add_ps(a, b); }
+		static float reduce_add(acc sum) { alignas(16) float lanes[4]; _mm_store_ps(lanes, sum); return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]); }
+	};
+
+	template<>
+	struct ops<uint8_t>
+	{
+		using vec = __m128i;
+		using acc = __m128i;
+		static constexpr size_t width = 16;
+
+		static vec load(const uint8_t* ptr) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)); }
+		static void store(uint8_t* ptr, vec v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(ptr), v); }
+		static vec set1(uint8_t value) { return _mm_set1_epi8((char)value); }
+		static uint64_t eq(vec a, vec b) { return (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)); }
+		static uint64_t unordered(vec) { return 0; }
+
+		static vec min(vec a, vec b) { return _mm_min_epu8(a, b); }
+		static vec max(vec a, vec b) { return _mm_max_epu8(a, b); }
+
+		// psadbw against zero sums each group of 8 bytes into a 64 bit lane
+		static acc zero() { return _mm_setzero_si128(); }
+		static acc add(acc sum, vec v) { return _mm_add_epi64(sum, _mm_sad_epu8(v, _mm_setzero_si128())); }
+		static acc combine(acc a, acc b) { return _mm_add_epi64(a, b); }
+		static uint64_t reduce_add(acc sum) { alignas(16) uint64_t lanes[2]; _mm_store_si128(reinterpret_cast<__m128i*>(lanes), sum); return lanes[0] + lanes[1]; }
+	};
+
+#include "simd_kernels.inl"
+}
+MYSTL_SIMD_TARGET_END
+
+// avx2 kernels (32 byte registers)
+MYSTL_SIMD_TARGET_BEGIN("avx2,popcnt")
+namespace mystl::simd::avx2
+{
+	template<typename T>
+	struct ops;
+
+	template<>
+	struct ops<int32_t>
+	{
+		using vec = __m256i;
+		using acc = __m256i;
+		static constexpr size_t width = 8;
+
+		static vec load(const int32_t* ptr) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr)); }
+		static void store(int32_t* ptr, vec v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), v); }
+		static vec set1(int32_t value) { return _mm256_set1_epi32(value); }
+		static uint64_t eq(vec a, vec b) { return (uint64_t)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b))); }
+		static uint64_t unordered(vec) { return 0; }
+
+		static vec min(vec a, vec b) { return _mm256_min_epi32(a, b); }
+		static vec max(vec a, vec b) { return _mm256_max_epi32(a, b); }
+
+		static acc zero() { return _mm256_setzero_si256(); }
+		static acc add(acc sum, vec v) { return _mm256_add_epi32(sum, v); }
+		static acc combine(acc a, acc b) { return _mm256_add_epi32(a, b); }
+		static uint32_t reduce_add(acc sum) { alignas(32) uint32_t lanes[8]; _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sum); uint32_t total = 0; for (uint32_t lane : lanes) total += lane; return total; }
+	};
+
+	template<>
+	struct ops<float>
+	{
+		using vec = __m256;
+		using acc = __m256;
+		static constexpr size_t width = 8;
+
+		static vec load(const float* ptr) { return _mm256_loadu_ps(ptr); }
+		static void store(float* ptr, vec v) { _mm256_storeu_ps(ptr, v); }
+		static vec set1(float value) { return _mm256_set1_ps(value); }
+		static uint64_t eq(vec a, vec b) { return (uint64_t)_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)); }
+		static uint64_t unordered(vec v) { return (uint64_t)_mm256_movemask_ps(_mm256_cmp_ps(v, v, _CMP_UNORD_Q)); }
+
+		static vec min(vec a, vec b) { return _mm256_min_ps(a, b); }
+		static vec max(vec a, vec b) { return _mm256_max_ps(a, b); }
+
+		static acc zero() { return _mm256_setzero_ps(); }
+		static acc add(acc sum, vec v) { return _mm256_add_ps(sum, v); }
+		static acc combine(acc a, acc b) { return _mm256_add_ps(a, b); }
+		static float reduce_add(acc sum) { return sse2::ops<float>::reduce_add(_mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1))); }
+	};
+
+	template<>
+	struct ops<uint8_t>
+	{
+		using vec = __m256i;
+		using acc = __m256i;
+		static constexpr size_t width = 32;
+
+		static vec load(const uint8_t* ptr) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr)); }
+		static void store(uint8_t* ptr, vec v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), v); }
+		static vec set1(uint8_t value) { return _mm256_set1_epi8((char)value); }
+		static uint64_t eq(vec a, vec b) { return (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)); }
+		static uint64_t unordered(vec) { return 0; }
+
+		static vec min(vec a, vec b) { return _mm256_min_epu8(a, b); }
+		static vec max(vec a, vec b) { return _mm256_max_epu8(a, b); }
+
+		static acc zero() { return _mm256_setzero_si256(); }
+		static acc add(acc sum, vec v) { return _mm256_add_epi64(sum, _mm256_sad_epu8(v, _mm256_setzero_si256())); }
+		static acc combine(acc a, acc b) { return _mm256_add_epi64(a, b); }
+		static uint64_t reduce_add(acc sum) { alignas(32) uint64_t lanes[4]; _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sum); return lanes[0] + lanes[1] + lanes[2] + lanes[3]; }
+	};
+
+#include "simd_kernels.inl"
+}
+MYSTL_SIMD_TARGET_END
+
+// gcc 12 flags the placeholder registers inside its own avx512 headers as
+// uninitialized (gcc bug 105593)
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+// avx512 kernels (64 byte registers, compares write straight into a mask)
+MYSTL_SIMD_TARGET_BEGIN("avx512f,avx512bw,popcnt")
+namespace mystl::simd::avx512
+{
+	template<typename T>
+	struct ops;
+
+	template<>
+	struct ops<int32_t>
+	{
+		using vec = __m512i;
+		using acc = __m512i;
+		static constexpr size_t width = 16;
+
+		static vec load(const int32_t* ptr) { return _mm512_loadu_si512(ptr); }
+		static void store(int32_t* ptr, vec v) { _mm512_storeu_si512(ptr, v); }
+		static vec set1(int32_t value) { return _mm512_set1_epi32(value); }
+		static uint64_t eq(vec a, vec b) { return (uint64_t)_mm512_cmpeq_epi32_mask(a, b); }
+		static uint64_t unordered(vec) { return 0; }
+
+		static vec min(vec a, vec b) { return _mm512_min_epi32(a, b); }
+		static vec max(vec a, vec b) { return _mm512_max_epi32(a, b); }
+
+		static acc zero() { return _mm512_setzero_si512(); }
+		static acc add(acc sum, vec v) { return _mm512_add_epi32(sum, v); }
+		static acc combine(acc a, acc b) { return _mm512_add_epi32(a, b); }
+		static uint32_t reduce_add(acc sum) { return avx2::ops<int32_t>::reduce_add(_mm256_add_epi32(_mm512_castsi512_si256(sum), _mm512_extracti64x4_epi64(sum, 1))); }
+	};
+
+	template<>
+	struct ops<float>
+	{
+		using vec = __m512;
+		using acc = __m512;
+		static constexpr size_t width = 16;
+
+		static vec load(const float* ptr) { return _mm512_loadu_ps(ptr); }
+		static void store(float* ptr, vec v) { _mm512_storeu_ps(ptr, v); }
+		static vec set1(float value) { return _mm512_set1_ps(value); }
+		static uint64_t eq(vec a, vec b) { return (uint64_t)_mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+		static uint64_t unordered(vec v) { return (uint64_t)_mm512_cmp_ps_mask(v, v, _CMP_UNORD_Q); }
+
+		static vec min(vec a, vec b) { return _mm512_min_ps(a, b); }
+		static vec max(vec a, vec b) { return _mm512_max_ps(a, b); }
+
+		static acc zero() { return _mm512_setzero_ps(); }
+		static acc add(acc sum, vec v) { return _mm512_add_ps(sum, v); }
+		static acc combine(acc a, acc b) { return _mm512_add_ps(a, b); }
+		static float reduce_add(acc sum) { return avx2::ops<float>::reduce_add(_mm256_add_ps(_mm512_castps512_ps256(sum), _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(sum), 1)))); }
+	};
+
+	template<>
+	struct ops<uint8_t>
+	{
+		using vec = __m512i;
+		using acc = __m512i;
+		static constexpr size_t width = 64;
+
+		static vec load(const uint8_t* ptr) { return _mm512_loadu_si512(ptr); }
+		static void store(uint8_t* ptr, vec v) { _mm512_storeu_si512(ptr, v); }
+		static vec set1(uint8_t value) { return _mm512_set1_epi8((char)value); }
+		static uint64_t eq(vec a, vec b) { return (uint64_t)_mm512_cmpeq_epi8_mask(a, b); }
+		static uint64_t unordered(vec) { return 0; }
+
+		static vec min(vec a, vec b) { return _mm512_min_epu8(a, b); }
+		static vec max(vec a, vec b) { return _mm512_max_epu8(a, b); }
+
+		static acc zero() { return _mm512_setzero_si512(); }
+		static acc add(acc sum, vec v) { return _mm512_add_epi64(sum, _mm512_sad_epu8(v, _mm512_setzero_si512())); }
+		static acc combine(acc a, acc b) { return _mm512_add_epi64(a, b); }
+		static uint64_t reduce_add(acc sum) { return avx2::ops<uint8_t>::reduce_add(_mm256_add_epi64(_mm512_castsi512_si256(sum), _mm512_extracti64x4_epi64(sum, 1))); }
+	};
+
+#include "simd_kernels.inl"
+}
+MYSTL_SIMD_TARGET_END
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif
+
+// dispatch
+namespace mystl::simd
+{
+	// index of the first element equal to value, count if there is none
+	template<typename T>
+	inline size_t
+		find(const T* data, const size_t& count, const T& value)
+	{
+#if defined(MYSTL_SIMD_X86)
+		switch (active_isa())
+		{
+		case isa::avx512:	return avx512::find(data, count, value);
+		case isa::avx2:		return avx2::find(data, count, value);
+		case isa::sse2:		return sse2::find(data, count, value);
+		default:			break;
+		}
+#endif
+		return scalar::find(data, count, value);
+	}
+
+	// number of elements equal to value
+	template<typename T>
+	inline size_t
+		count(const T* data, const size_t& count, const T& value)
+	{
+#if defined(MYSTL_SIMD_X86)
+		switch (active_isa())
+		{
+		case isa::avx512:	return avx512::count(data, count, value);
+		case isa::avx2:		return avx2::count(data, count, value);
+		case isa::sse2:		return sse2::count(data, count, value);
+		default:			break;
+		}
+#endif
+		return scalar::count(data, count, value);
+	}
+
+	// index of the first smallest element, 0 for an empty range
+	template<typename T>
+	inline size_t
+		min_element(const T* data, const size_t& count)
+	{
+#if defined(MYSTL_SIMD_X86)
+		switch (active_isa())
+		{
+		case isa::avx512:	return avx512::min_element(data, count);
+		case isa::avx2:		return avx2::min_element(data, count);
+		case isa::sse2:		return sse2::min_element(data, count);
+		default:			break;
+		}
+#endif
+		return scalar::min_element(data, count);
+	}
+
+	// index of the first largest element, 0 for an empty range
+	template<typename T>
+	inline size_t
+		max_element(const T* data, const size_t& count)
+	{
+#if defined(MYSTL_SIMD_X86)
+		switch (active_isa())
+		{
+		case isa::avx512:	return avx512::max_element(data, count);
+		case isa::avx2:		return avx2::max_element(data, count);
+		case isa::sse2:		return sse2::max_element(data, count);
+		default:			break;
+		}
+#endif
+		return scalar::max_element(data, count);
+	}
+
+	// sum of all elements. float sums are added lane by lane, so the rounding
+	// can differ from a left to right loop
+	template<typename T>
+	inline sum_type_t<T>
+		accumulate(const T* data, const size_t& count)
+	{
+#if defined(MYSTL_SIMD_X86)
+		switch (active_isa())
+		{
+		case isa::avx512:	return avx512::accumulate(data, count);
+		case isa::avx2:		return avx2::accumulate(data, count);
+		case isa::sse2:		return sse2::accumulate(data, count);
+		default:			break;
+		}
+#endif
+		return scalar::accumulate(data, count);
+	}
+
+	// true when both ranges of count elements compare equal
+	template<typename T>
+	inline bool
+		equal(const T* first, const T* second, const size_t& count)
+	{
+#if defined(MYSTL_SIMD_X86)
+		switch (active_isa())
+		{
+		case isa::avx512:	return avx512::equal(first, second, count);
+		case isa::avx2:		return avx2::equal(first, second, count);
+		case isa::sse2:		return sse2::equal(first, second, count);
+		default:			break;
+		}
+#endif
+		return scalar::equal(first, second, count);
+	}
+}
+
+#endif
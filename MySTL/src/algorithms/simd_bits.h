@@ -0,0 +1,261 @@
+#ifndef SIMD_BITS_H
+#define SIMD_BITS_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "simd.h"
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// simd_bits																		///
+///																					///
+/// This file holds the word kernels behind mystl::dynamic_bitset: popcount,		///
+/// the search for the first non-zero word and the bulk and/or/xor/not of two		///
+/// arrays of 64 bit words. Like simd.h there is a scalar version and a vector		///
+/// version (avx2, which avx512 cpus run too), picked on every call through			///
+/// active_isa(). The avx2 popcount looks up each nibble with vpshufb and sums		///
+/// the bytes with vpsadbw, which beats one popcnt per word on long arrays.			///
+///																					///
+///////////////////////////////////////////////////////////////////////////////////////
+
+// scalar kernels: the fallback and the tail loop of the vector kernels
+namespace mystl::simd::scalar
+{
+	inline size_t
+		popcount(const uint64_t* words, const size_t& count)
+	{
+		size_t bits = 0;
+
+		for (size_t i = 0; i < count; i++)
+			bits += (size_t)std::popcount(words[i]);
+
+		return bits;
+	}
+
+	// index of the first word with a bit set, count if there is none
+	inline size_t
+		find_nonzero(const uint64_t* words, const size_t& count)
+	{
+		for (size_t i = 0; i < count; i++)
+			if (words[i])
+				return i;
+
+		return count;
+	}
+
+	inline void
+		bit_and(uint64_t* dest, const uint64_t* source, const size_t& count)
+	{
+		for (size_t i = 0; i < count; i++)
+			dest[i] &= source[i];
+	}
+
+	inline void
+		bit_or(uint64_t* dest, const uint64_t* source, const size_t& count)
+	{
+		for (size_t i = 0; i < count; i++)
+			dest[i] |= source[i];
+	}
+
+	inline void
+		bit_xor(uint64_t* dest, const uint64_t* source, const size_t& count)
+	{
+		for (size_t i = 0; i < count; i++)
+			dest[i] ^= source[i];
+	}
+
+	inline void
+		bit_not(uint64_t* dest, const size_t& count)
+	{
+		for (size_t i = 0; i < count; i++)
+			dest[i] = ~dest[i];
+	}
+}
+
+#if defined(MYSTL_SIMD_X86)
+
+// avx2 kernels, 4 words per register
+MYSTL_SIMD_TARGET_BEGIN("avx2,popcnt")
+namespace mystl::simd::avx2
+{
+	inline __m256i load_words(const uint64_t* ptr) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr)); }
+	inline void store_words(uint64_t* ptr, __m256i v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), v); }
+
+	inline size_t
+		popcount(const uint64_t* words, const size_t& count)
+	{
+		const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+												0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+		const __m256i nibble = _mm256_set1_epi8(0x0f);
+
+		__m256i sum = _mm256_setzero_si256();
+		size_t i = 0;
+
+		for (; i + 4 <= count; i += 4)
+		{
+			__m256i v = load_words(words + i);
+			__m256i low = _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, nibble));
+			__m256i high = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+
+			// each byte holds at most 8, psadbw sums them into the 64 bit lanes
+			sum = _mm256_add_epi64(sum, _mm256_sad_epu8(_mm256_add_epi8(low, high), _mm256_setzero_si256()));
+		}
+
+		alignas(32) uint64_t lanes[4];
+		_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sum);
+
+		size_t bits = (size_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+		for (; i < count; i++)
+			bits += (size_t)_mm_popcnt_u64(words[i]);
+
+		return bits;
+	}
+
+	inline size_t
+		find_nonzero(const uint64_t* words, const size_t& count)
+	{
+		size_t i = 0;
+
+		for (; i + 4 <= count; i += 4)
+		{
+			__m256i v = load_words(words + i);
+			if (!_mm256_testz_si256(v, v))
+				break;
+		}
+
+		return i + scalar::find_nonzero(words + i, count - i);
+	}
+
+	inline void
+		bit_and(uint64_t* dest, const uint64_t* source, const size_t& count)
+	{
+		size_t i = 0;
+
+		for (; i + 4 <= count; i += 4)
+			store_words(dest + i, _mm256_and_si256(load_words(dest + i), load_words(source + i)));
+
+		scalar::bit_and(dest + i, source + i, count - i);
+	}
+
+	inline void
+		bit_or(uint64_t* dest, const uint64_t* source, const size_t& count)
+	{
+		size_t i = 0;
+
+		for (; i + 4 <= count; i += 4)
+			store_words(dest + i, _mm256_or_si256(load_words(dest + i), load_words(source + i)));
+
+		scalar::bit_or(dest + i, source + i, count - i);
+	}
+
+	inline void
+		bit_xor(uint64_t* dest, const uint64_t* source, const size_t& count)
+	{
+		size_t i = 0;
+
+		for (; i + 4 <= count; i += 4)
+			store_words(dest + i, _mm256_xor_si256(load_words(dest + i), load_words(source + i)));
+
+		scalar::bit_xor(dest + i, source + i, count - i);
+	}
+
+	inline void
+		bit_not(uint64_t* dest, const size_t& count)
+	{
+		const __m256i ones = _mm256_set1_epi64x(-1);
+		size_t i = 0;
+
+		for (; i + 4 <= count; i += 4)
+			store_words(dest + i, _mm256_xor_si256(load_words(dest + i), ones));
+
+		scalar::bit_not(dest + i, count - i);
+	}
+}
+MYSTL_SIMD_TARGET_END
+
+#endif
+
+// dispatch. sse2 cpus take the scalar kernels
+namespace mystl::simd
+{
+	// number of set bits in count words
+	inline size_t
+		popcount(const uint64_t* words, const size_t& count)
+	{
+#if defined(MYSTL_SIMD_X86)
+		if (active_isa() >= isa::avx2)
+			return avx2::popcount(words, count);
+#endif
+		return scalar::popcount(words, count);
+	}
+
+	// index of the first word with a bit set, count if there is none
+	inline size_t
+		find_nonzero(const uint64_t* words, const size_t& count)
+	{
+#if defined(MYSTL_SIMD_X86)
+		if (active_isa() >= isa::avx2)
+			return avx2::find_nonzero(words, count);
+#endif
+		return scalar::find_nonzero(words, count);
+	}
+
+	// dest[i] &= source[i] for count words
+	inline void
+		bit_and(uint64_t* dest, const uint64_t* source, const size_t& count)
+	{
+#if defined(MYSTL_SIMD_X86)
+		if (active_isa() >= isa::avx2)
+		{
+			avx2::bit_and(dest, source, count);
+			return;
+		}
+#endif
+		scalar::bit_and(dest, source, count);
+	}
+
+	// dest[i] |= source[i] for count words
+	inline void
+		bit_or(uint64_t* dest, const uint64_t* source, const size_t& count)
+	{
+#if defined(MYSTL_SIMD_X86)
+		if (active_isa() >= isa::avx2)
+		{
+			avx2::bit_or(dest, source, count);
+			return;
+		}
+#endif
+		scalar::bit_or(dest, source, count);
+	}
+
+	// dest[i] ^= source[i] for count words
+	inline void
+		bit_xor(uint64_t* dest, const uint64_t* source, const size_t& count)
+	{
+#if defined(MYSTL_SIMD_X86)
+		if (active_isa() >= isa::avx2)
+		{
+			avx2::bit_xor(dest, source, count);
+			return;
+		}
+#endif
+		scalar::bit_xor(dest, source, count);
+	}
+
+	// dest[i] = ~dest[i] for count words
+	inline void
+		bit_not(uint64_t* dest, const size_t& count)
+	{
+#if defined(MYSTL_SIMD_X86)
+		if (active_isa() >= isa::avx2)
+		{
+			avx2::bit_not(dest, count);
+			return;
+		}
+#endif
+		scalar::bit_not(dest, count);
+	}
+}
+
+#endif
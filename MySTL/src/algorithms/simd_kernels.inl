@@ -0,0 +1,187 @@
+// simd_kernels.inl
+//
+// kernel bodies shared by every instruction set. simd.h includes this file
+// once inside each of mystl::simd::sse2, avx2 and avx512, after that
+// namespace has defined ops<T> for its register width, so there is no
+// include guard. each kernel walks whole registers and hands the tail to the
+// scalar kernel.
+
+	template<typename T>
+	inline size_t
+		find(const T* data, const size_t& count, const T& value)
+	{
+		using op = ops<T>;
+
+		typename op::vec needle = op::set1(value);
+		size_t i = 0;
+
+		for (; i + op::width <= count; i += op::width)
+		{
+			uint64_t mask = op::eq(op::load(data + i), needle);
+			if (mask)
+				return i + (size_t)std::countr_zero(mask);
+		}
+
+		return i + scalar::find(data + i, count - i, value);
+	}
+
+	template<typename T>
+	inline size_t
+		count(const T* data, const size_t& count, const T& value)
+	{
+		using op = ops<T>;
+
+		typename op::vec needle = op::set1(value);
+		size_t matches = 0;
+		size_t i = 0;
+
+		// narrow masks are packed four to a word, so there is one popcount
+		// per four registers (sse2 has no popcnt instruction to fall back on).
+		// the loads come first so the four masks never live across a call
+		if constexpr (op::width <= 16)
+		{
+			for (; i + 4 * op::width <= count; i += 4 * op::width)
+			{
+				typename op::vec v0 = op::load(data + i);
+				typename op::vec v1 = op::load(data + i + op::width);
+				typename op::vec v2 = op::load(data + i + 2 * op::width);
+				typename op::vec v3 = op::load(data + i + 3 * op::width);
+
+				uint64_t mask = op::eq(v0, needle)
+					| op::eq(v1, needle) << 16
+					| op::eq(v2, needle) << 32
+					| op::eq(v3, needle) << 48;
+
+				matches += (size_t)std::popcount(mask);
+			}
+		}
+
+		for (; i + op::width <= count; i += op::width)
+			matches += (size_t)std::popcount(op::eq(op::load(data + i), needle));
+
+		return matches + scalar::count(data + i, count - i, value);
+	}
+
+	// reduces to the smallest value, then finds its first position. a float
+	// range holding a NaN goes to the scalar kernel so the result matches the
+	// operator< loop exactly
+	template<typename T>
+	inline size_t
+		min_element(const T* data, const size_t& count)
+	{
+		using op = ops<T>;
+
+		if (count < op::width)
+			return scalar::min_element(data, count);
+
+		typename op::vec best = op::load(data);
+		uint64_t nan = op::unordered(best);
+		size_t i = op::width;
+
+		for (; i + op::width <= count; i += op::width)
+		{
+			typename op::vec v = op::load(data + i);
+			nan |= op::unordered(v);
+			best = op::min(best, v);
+		}
+
+		if (nan)
+			return scalar::min_element(data, count);
+
+		T lanes[op::width];
+		op::store(lanes, best);
+
+		T value = lanes[0];
+		for (size_t lane = 1; lane < op::width; lane++)
+			if (lanes[lane] < value)
+				value = lanes[lane];
+
+		for (; i < count; i++)
+			if (data[i] < value)
+				value = data[i];
+
+		return find(data, count, value);
+	}
+
+	template<typename T>
+	inline size_t
+		max_element(const T* data, const size_t& count)
+	{
+		using op = ops<T>;
+
+		if (count < op::width)
+			return scalar::max_element(data, count);
+
+		typename op::vec best = op::load(data);
+		uint64_t nan = op::unordered(best);
+		size_t i = op::width;
+
+		for (; i + op::width <= count; i += op::width)
+		{
+			typename op::vec v = op::load(data + i);
+			nan |= op::unordered(v);
+			best = op::max(best, v);
+		}
+
+		if (nan)
+			return scalar::max_element(data, count);
+
+		T lanes[op::width];
+		op::store(lanes, best);
+
+		T value = lanes[0];
+		for (size_t lane = 1; lane < op::width; lane++)
+			if (value < lanes[lane])
+				value = lanes[lane];
+
+		for (; i < count; i++)
+			if (value < data[i])
+				value = data[i];
+
+		return find(data, count, value);
+	}
+
+	// four independent sums so the adds do not wait on each other
+	template<typename T>
+	inline sum_type_t<T>
+		accumulate(const T* data, const size_t& count)
+	{
+		using op = ops<T>;
+
+		typename op::acc sum0 = op::zero();
+		typename op::acc sum1 = op::zero();
+		typename op::acc sum2 = op::zero();
+		typename op::acc sum3 = op::zero();
+		size_t i = 0;
+
+		for (; i + 4 * op::width <= count; i += 4 * op::width)
+		{
+			sum0 = op::add(sum0, op::load(data + i));
+			sum1 = op::add(sum1, op::load(data + i + op::width));
+			sum2 = op::add(sum2, op::load(data + i + 2 * op::width));
+			sum3 = op::add(sum3, op::load(data + i + 3 * op::width));
+		}
+
+		for (; i + op::width <= count; i += op::width)
+			sum0 = op::add(sum0, op::load(data + i));
+
+		typename op::acc sum = op::combine(op::combine(sum0, sum1), op::combine(sum2, sum3));
+
+		return op::reduce_add(sum) + scalar::accumulate(data + i, count - i);
+	}
+
+	template<typename T>
+	inline bool
+		equal(const T* first, const T* second, const size_t& count)
+	{
+		using op = ops<T>;
+
+		constexpr uint64_t all = op::width == 64 ? ~uint64_t(0) : (uint64_t(1) << op::width) - 1;
+		size_t i = 0;
+
+		for (; i + op::width <= count; i += op::width)
+			if (op::eq(op::load(first + i), op::load(second + i)) != all)
+				return false;
+
+		return scalar::equal(first + i, second + i, count - i);
+	}
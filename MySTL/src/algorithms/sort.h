@@ -0,0 +1,770 @@
+#ifndef SORT_H
+#define SORT_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "algorithm.h"
+#include "../data_structures/allocator.h"
+#include "../data_structures/iterator.h"
+#include "../data_structures/memory.h"
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// sort																			///
+///																					///
+/// This file holds the mystl sorts. sort is a pattern-defeating quicksort:			///
+/// insertion sort below 24 elements, a median of 3 (or pseudomedian of 9)			///
+/// pivot, a heapsort fallback after too many unbalanced partitions and, for		///
+/// arithmetic types with less/greater, the branchless block partition from			///
+/// BlockQuicksort. Sorted, reverse sorted and few-unique inputs finish in			///
+/// linear time. sort is constexpr and takes the branching partition in				///
+/// constant expressions. stable_sort is a merge sort with a half size buffer		///
+/// and radix_sort is an LSD radix sort over 8 bit digits for integer and			///
+/// float keys. Contiguous ranges are sorted through raw pointers.					///
+///																					///
+///////////////////////////////////////////////////////////////////////////////////////
+
+// sort helpers
+namespace mystl::detail
+{
+	inline constexpr ptrdiff_t		insertion_sort_threshold		= 24;
+	inline constexpr ptrdiff_t		ninther_threshold				= 128;
+	inline constexpr size_t			partial_insertion_sort_limit	= 8;
+	inline constexpr size_t			partition_block_size			= 64;
+	inline constexpr ptrdiff_t		merge_sort_run					= 32;
+
+	// comparisons that compile to a flag instead of a branch, which is what
+	// the block partition needs to pay off
+	template<typename T, class Compare>
+	inline constexpr bool is_branchless_compare_v = std::is_arithmetic_v<T> &&
+		(std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<T>> ||
+		 std::is_same_v<Compare, std::greater<>> || std::is_same_v<Compare, std::greater<T>>);
+
+	template<class Iterator>
+	constexpr void
+		iter_swap(Iterator a, Iterator b)
+	{
+		using std::swap;
+		swap(*a, *b);
+	}
+
+	template<class Iterator, class Compare>
+	constexpr void
+		sort2(Iterator a, Iterator b, Compare& comp)
+	{
+		if (comp(*b, *a))
+			iter_swap(a, b);
+	}
+
+	template<class Iterator, class Compare>
+	constexpr void
+		sort3(Iterator a, Iterator b, Iterator c, Compare& comp)
+	{
+		sort2(a, b, comp);
+		sort2(b, c, comp);
+		sort2(a, b, comp);
+	}
+
+	// stable, so merge sort uses it for its runs too
+	template<class Iterator, class Compare>
+	constexpr void
+		insertion_sort(Iterator begin, Iterator end, Compare& comp)
+	{
+		if (begin == end)
+			return;
+
+		for (Iterator current = begin + 1; current != end; ++current)
+		{
+			Iterator sift = current;
+			Iterator before = current - 1;
+
+			if (comp(*sift, *before))
+			{
+				iterator_value_t<Iterator> element(std::move(*sift));
+
+				do
+				{
+					*sift-- = std::move(*before);
+				} while (sift != begin && comp(element, *--before));
+
+				*sift = std::move(element);
+			}
+		}
+	}
+
+	// insertion sort without the begin check, for ranges with an element in
+	// front of them that is not greater than any of theirs
+	template<class Iterator, class Compare>
+	constexpr void
+		unguarded_insertion_sort(Iterator begin, Iterator end, Compare& comp)
+	{
+		if (begin == end)
+			return;
+
+		for (Iterator current = begin + 1; current != end; ++current)
+		{
+			Iterator sift = current;
+			Iterator before = current - 1;
+
+			if (comp(*sift, *before))
+			{
+				iterator_value_t<Iterator> element(std::move(*sift));
+
+				do
+				{
+					*sift-- = std::move(*before);
+				} while (comp(element, *--before));
+
+				*sift = std::move(element);
+			}
+		}
+	}
+
+	// insertion sort that gives up once it has moved more than
+	// partial_insertion_sort_limit elements. returns true if it finished
+	template<class Iterator, class Compare>
+	constexpr bool
+		partial_insertion_sort(Iterator begin, Iterator end, Compare& comp)
+	{
+		if (begin == end)
+			return true;
+
+		size_t moved = 0;
+
+		for (Iterator current = begin + 1; current != end; ++current)
+		{
+			Iterator sift = current;
+			Iterator before = current - 1;
+
+			if (comp(*sift, *before))
+			{
+				iterator_value_t<Iterator> element(std::move(*sift));
+
+				do
+				{
+					*sift-- = std::move(*before);
+				} while (sift != begin && comp(element, *--before));
+
+				*sift = std::move(element);
+				moved += size_t(current - sift);
+			}
+
+			if (moved > partial_insertion_sort_limit)
+				return false;
+		}
+
+		return true;
+	}
+
+	template<class Iterator, class Compare>
+	constexpr void
+		sift_down(Iterator begin, ptrdiff_t hole, const ptrdiff_t& size, Compare& comp)
+	{
+		iterator_value_t<Iterator> element(std::move(begin[hole]));
+
+		for (ptrdiff_t child = 2 * hole + 1; child < size; child = 2 * hole + 1)
+		{
+			if (child + 1 < size && comp(begin[child], begin[child + 1]))
+				child++;
+
+			if (!comp(element, begin[child]))
+				break;
+
+			begin[hole] = std::move(begin[child]);
+			hole = child;
+		}
+
+		begin[hole] = std::move(element);
+	}
+
+	template<class Iterator, class Compare>
+	constexpr void
+		heap_sort(Iterator begin, Iterator end, Compare& comp)
+	{
+		ptrdiff_t size = end - begin;
+
+		for (ptrdiff_t i = size / 2; i > 0; i--)
+			sift_down(begin, i - 1, size, comp);
+
+		for (ptrdiff_t last = size - 1; last > 0; last--)
+		{
+			iter_swap(begin, begin + last);
+			sift_down(begin, 0, last, comp);
+		}
+	}
+
+	// moves the pivot at begin to its place, with the elements less than it to
+	// its left. returns the pivot and whether the range was partitioned already
+	template<class Iterator, class Compare>
+	constexpr std::pair<Iterator, bool>
+		partition_right(Iterator begin, Iterator end, Compare& comp)
+	{
+		iterator_value_t<Iterator> pivot(std::move(*begin));
+		Iterator first = begin;
+		Iterator last = end;
+
+		// the median of 3 guarantees an element not less than the pivot
+		while (comp(*++first, pivot));
+
+		if (first - 1 == begin)
+			while (first < last && !comp(*--last, pivot));
+		else
+			while (!comp(*--last, pivot));
+
+		bool partitioned = !(first < last);
+
+		while (first < last)
+		{
+			iter_swap(first, last);
+			while (comp(*++first, pivot));
+			while (!comp(*--last, pivot));
+		}
+
+		Iterator pivotPos = first - 1;
+		*begin = std::move(*pivotPos);
+		*pivotPos = std::move(pivot);
+
+		return { pivotPos, partitioned };
+	}
+
+	// swaps num pairs of misplaced elements found by the block partition. with
+	// distinct counts on both sides the swaps become a cycle of moves
+	template<class Iterator>
+	constexpr void
+		swap_offsets(Iterator first, Iterator last, const unsigned char* left, const unsigned char* right, const size_t& num, const bool& useSwaps)
+	{
+		if (useSwaps)
+		{
+			for (size_t i = 0; i < num; i++)
+				iter_swap(first + left[i], last - right[i]);
+		}
+		else if (num > 0)
+		{
+			Iterator l = first + left[0];
+			Iterator r = last - right[0];
+			iterator_value_t<Iterator> element(std::move(*l));
+			*l = std::move(*r);
+
+			for (size_t i = 1; i < num; i++)
+			{
+				l = first + left[i];
+				*r = std::move(*l);
+				r = last - right[i];
+				*l = std::move(*r);
+			}
+
+			*r = std::move(element);
+		}
+	}
+
+	// partition_right without data dependent branches: each side records the
+	// offsets of its misplaced elements in a block of 64 (the compare result
+	// only decides whether the count moves on), then the blocks are swapped
+	template<class Iterator, class Compare>
+	constexpr std::pair<Iterator, bool>
+		partition_right_branchless(Iterator begin, Iterator end, Compare& comp)
+	{
+		iterator_value_t<Iterator> pivot(std::move(*begin));
+		Iterator first = begin;
+		Iterator last = end;
+
+		while (comp(*++first, pivot));
+
+		if (first - 1 == begin)
+			while (first < last && !comp(*--last, pivot));
+		else
+			while (!comp(*--last, pivot));
+
+		bool partitioned = !(first < last);
+
+		if (!partitioned)
+		{
+			iter_swap(first, last);
+			++first;
+
+			alignas(64) unsigned char offsetsLeft[partition_block_size];
+			alignas(64) unsigned char offsetsRight[partition_block_size];
+
+			Iterator leftBase = first;
+			Iterator rightBase = last;
+			size_t numLeft = 0, numRight = 0, startLeft = 0, startRight = 0;
+
+			while (first < last)
+			{
+				// refill the empty block(s) from the unknown middle
+				size_t unknown = size_t(last - first);
+				size_t leftSplit = numLeft == 0 ? (numRight == 0 ? unknown / 2 : unknown) : 0;
+				size_t rightSplit = numRight == 0 ? unknown - leftSplit : 0;
+
+				if (leftSplit > partition_block_size)
+					leftSplit = partition_block_size;
+				if (rightSplit > partition_block_size)
+					rightSplit = partition_block_size;
+
+				for (size_t i = 0; i < leftSplit; i++)
+				{
+					offsetsLeft[numLeft] = (unsigned char)i;
+					numLeft += !comp(*first, pivot);
+					++first;
+				}
+
+				for (size_t i = 0; i < rightSplit; i++)
+				{
+					offsetsRight[numRight] = (unsigned char)(i + 1);
+					numRight += comp(*--last, pivot);
+				}
+
+				size_t num = numLeft < numRight ? numLeft : numRight;
+				swap_offsets(leftBase, rightBase, offsetsLeft + startLeft, offsetsRight + startRight, num, numLeft == numRight);
+
+				numLeft -= num;
+				numRight -= num;
+				startLeft += num;
+				startRight += num;
+
+				if (numLeft == 0)
+				{
+					startLeft = 0;
+					leftBase = first;
+				}
+
+				if (numRight == 0)
+				{
+					startRight = 0;
+					rightBase = last;
+				}
+			}
+
+			// one block may still hold misplaced elements, move them to the middle
+			if (numLeft)
+			{
+				while (numLeft--)
+					iter_swap(leftBase + offsetsLeft[startLeft + numLeft], --last);
+
+				first = last;
+			}
+
+			if (numRight)
+			{
+				while (numRight--)
+				{
+					iter_swap(rightBase - offsetsRight[startRight + numRight], first);
+					++first;
+				}
+
+				last = first;
+			}
+		}
+
+		Iterator pivotPos = first - 1;
+		*begin = std::move(*pivotPos);
+		*pivotPos = std::move(pivot);
+
+		return { pivotPos, partitioned };
+	}
+
+	// puts the elements equal to the pivot at begin to its left. used when the
+	// pivot equals the element before the range, so that side is already sorted
+	template<class Iterator, class Compare>
+	constexpr Iterator
+		partition_left(Iterator begin, Iterator end, Compare& comp)
+	{
+		iterator_value_t<Iterator> pivot(std::move(*begin));
+		Iterator first = begin;
+		Iterator last = end;
+
+		while (comp(pivot, *--last));
+
+		if (last + 1 == end)
+			while (first < last && !comp(pivot, *++first));
+		else
+			while (!comp(pivot, *++first));
+
+		while (first < last)
+		{
+			iter_swap(first, last);
+			while (comp(pivot, *--last));
+			while (!comp(pivot, *++first));
+		}
+
+		Iterator pivotPos = last;
+		*begin = std::move(*pivotPos);
+		*pivotPos = std::move(pivot);
+
+		return pivotPos;
+	}
+
+	// swaps a few elements of each side of an unbalanced partition to break
+	// the pattern that produced it
+	template<class Iterator>
+	constexpr void
+		shuffle_partition(Iterator begin, Iterator pivotPos, Iterator end)
+	{
+		ptrdiff_t leftSize = pivotPos - begin;
+		ptrdiff_t rightSize = end - (pivotPos + 1);
+
+		if (leftSize >= insertion_sort_threshold)
+		{
+			iter_swap(begin, begin + leftSize / 4);
+			iter_swap(pivotPos - 1, pivotPos - leftSize / 4);
+
+			if (leftSize > ninther_threshold)
+			{
+				iter_swap(begin + 1, begin + (leftSize / 4 + 1));
+				iter_swap(begin + 2, begin + (leftSize / 4 + 2));
+				iter_swap(pivotPos - 2, pivotPos - (leftSize / 4 + 1));
+				iter_swap(pivotPos - 3, pivotPos - (leftSize / 4 + 2));
+			}
+		}
+
+		if (rightSize >= insertion_sort_threshold)
+		{
+			iter_swap(pivotPos + 1, pivotPos + (1 + rightSize / 4));
+			iter_swap(end - 1, end - rightSize / 4);
+
+			if (rightSize > ninther_threshold)
+			{
+				iter_swap(pivotPos + 2, pivotPos + (2 + rightSize / 4));
+				iter_swap(pivotPos + 3, pivotPos + (3 + rightSize / 4));
+				iter_swap(end - 2, end - (1 + rightSize / 4));
+				iter_swap(end - 3, end - (2 + rightSize / 4));
+			}
+		}
+	}
+
+	// recurses into the left side and loops on the right one. badAllowed is
+	// the number of unbalanced partitions left before heapsort takes over,
+	// leftmost is false when an element in front of the range bounds it
+	template<bool Branchless, class Iterator, class Compare>
+	constexpr void
+		pdqsort_loop(Iterator begin, Iterator end, Compare& comp, int badAllowed, bool leftmost)
+	{
+		while (true)
+		{
+			ptrdiff_t size = end - begin;
+
+			if (size < insertion_sort_threshold)
+			{
+				if (leftmost)
+					insertion_sort(begin, end, comp);
+				else
+					unguarded_insertion_sort(begin, end, comp);
+
+				return;
+			}
+
+			ptrdiff_t half = size / 2;
+			if (size > ninther_threshold)
+			{
+				sort3(begin, begin + half, end - 1, comp);
+				sort3(begin + 1, begin + (half - 1), end - 2, comp);
+				sort3(begin + 2, begin + (half + 1), end - 3, comp);
+				sort3(begin + (half - 1), begin + half, begin + (half + 1), comp);
+				iter_swap(begin, begin + half);
+			}
+			else
+				sort3(begin + half, begin, end - 1, comp);
+
+			// nothing in the range is less than the element in front of it. a
+			// pivot equal to that element means many equal keys: put them all
+			// on the left, which is then done
+			if (!leftmost && !comp(*(begin - 1), *begin))
+			{
+				begin = partition_left(begin, end, comp) + 1;
+				continue;
+			}
+
+			std::pair<Iterator, bool> result = Branchless ? partition_right_branchless(begin, end, comp) : partition_right(begin, end, comp);
+			Iterator pivotPos = result.first;
+
+			ptrdiff_t leftSize = pivotPos - begin;
+			ptrdiff_t rightSize = end - (pivotPos + 1);
+
+			if (leftSize < size / 8 || rightSize < size / 8)
+			{
+				if (--badAllowed == 0)
+				{
+					heap_sort(begin, end, comp);
+					return;
+				}
+
+				shuffle_partition(begin, pivotPos, end);
+			}
+			else if (result.second && partial_insertion_sort(begin, pivotPos, comp) && partial_insertion_sort(pivotPos + 1, end, comp))
+				return;
+
+			pdqsort_loop<Branchless>(begin, pivotPos, comp, badAllowed, leftmost);
+			begin = pivotPos + 1;
+			leftmost = false;
+		}
+	}
+
+	template<class Iterator, class Compare>
+	constexpr void
+		pdqsort(Iterator begin, Iterator end, Compare& comp)
+	{
+		if (end - begin < 2)
+			return;
+
+		constexpr bool branchless = is_branchless_compare_v<iterator_value_t<Iterator>, Compare>;
+		int badAllowed = int(std::bit_width(size_t(end - begin))) - 1;
+
+		// the block partition keeps uninitialized offset buffers, which
+		// constant evaluation cannot read back
+		if (std::is_constant_evaluated())
+			pdqsort_loop<false>(begin, end, comp, badAllowed, true);
+		else
+			pdqsort_loop<branchless>(begin, end, comp, badAllowed, true);
+	}
+
+	// sorts [begin, end) stably. buffer holds room for (end - begin + 1) / 2
+	// elements, the left half is moved out to it and merged back
+	template<class Iterator, class Compare>
+	inline void
+		merge_sort(Iterator begin, Iterator end, iterator_value_t<Iterator>* buffer, Compare& comp)
+	{
+		using T = iterator_value_t<Iterator>;
+
+		ptrdiff_t size = end - begin;
+		if (size <= merge_sort_run)
+		{
+			insertion_sort(begin, end, comp);
+			return;
+		}
+
+		Iterator middle = begin + size / 2;
+		merge_sort(begin, middle, buffer, comp);
+		merge_sort(middle, end, buffer, comp);
+
+		// already in order, e.g. sorted input
+		if (!comp(*middle, *(middle - 1)))
+			return;
+
+		size_t leftSize = size_t(middle - begin);
+		for (size_t i = 0; i < leftSize; i++)
+			new(&buffer[i]) T(std::move(begin[i]));
+
+		T* left = buffer;
+		T* leftEnd = buffer + leftSize;
+		Iterator right = middle;
+		Iterator out = begin;
+
+		try
+		{
+			// ties take the left element first, which keeps the sort stable
+			while (left != leftEnd && right != end)
+			{
+				if (comp(*right, *left))
+					*out++ = std::move(*right++);
+				else
+					*out++ = std::move(*left++);
+			}
+		}
+		catch (...)
+		{
+			// a throwing comparison leaves every element in the range, in
+			// some order
+			while (left != leftEnd)
+				*out++ = std::move(*left++);
+
+			destroy(buffer, leftSize);
+			throw;
+		}
+
+		while (left != leftEnd)
+			*out++ = std::move(*left++);
+
+		destroy(buffer, leftSize);
+	}
+
+	// maps a key to an unsigned integer with the same order, so radix sort
+	// only sorts unsigned digits: signed integers flip the sign bit, floats
+	// flip every bit when negative and only the sign bit otherwise
+	template<typename K>
+	inline auto
+		radix_key(const K& key)
+	{
+		using U = std::conditional_t<sizeof(K) == 1, uint8_t,
+				  std::conditional_t<sizeof(K) == 2, uint16_t,
+				  std::conditional_t<sizeof(K) == 4, uint32_t, uint64_t>>>;
+
+		constexpr U sign = U(U(1) << (sizeof(K) * 8 - 1));
+
+		if constexpr (std::is_floating_point_v<K>)
+		{
+			U bits = std::bit_cast<U>(key);
+			return U(bits & sign ? ~bits : bits | sign);
+		}
+		else if constexpr (std::is_signed_v<K>)
+			return U(U(key) ^ sign);
+		else
+			return U(key);
+	}
+
+	// the identity key of radix_sort(first, last)
+	struct radix_identity
+	{
+		template<typename T>
+		constexpr const T& operator()(const T& value) const { return value; }
+	};
+}
+
+// sort
+namespace mystl
+{
+	// sorts [first, last) by comp, not stable. O(n log n) in the worst case.
+	// usable in constant expressions, e.g. to sort a lookup table
+	template<class Iterator, class Compare>
+	constexpr void
+		sort(Iterator first, Iterator last, Compare comp)
+	{
+		if (first == last)
+			return;
+
+		if constexpr (is_contiguous_iterator_v<Iterator>)
+			detail::pdqsort(&*first, &*first + (last - first), comp);
+		else
+			detail::pdqsort(first, last, comp);
+	}
+
+	template<class Iterator>
+	constexpr void
+		sort(Iterator first, Iterator last)
+	{
+		mystl::sort(first, last, std::less<>());
+	}
+
+	// sorts [first, last) by comp, keeping equal elements in their order.
+	// allocates room for half the range
+	template<class Iterator, class Compare>
+	inline void
+		stable_sort(Iterator first, Iterator last, Compare comp)
+	{
+		using T = iterator_value_t<Iterator>;
+
+		ptrdiff_t size = last - first;
+		if (size <= detail::merge_sort_run)
+		{
+			detail::insertion_sort(first, last, comp);
+			return;
+		}
+
+		allocator<T> alloc{};
+		size_t bufferSize = size_t(size + 1) / 2;
+		T* buffer = alloc.allocate(bufferSize);
+
+		try
+		{
+			if constexpr (is_contiguous_iterator_v<Iterator>)
+				detail::merge_sort(&*first, &*first + size, buffer, comp);
+			else
+				detail::merge_sort(first, last, buffer, comp);
+		}
+		catch (...)
+		{
+			alloc.deallocate(buffer, bufferSize);
+			throw;
+		}
+
+		alloc.deallocate(buffer, bufferSize);
+	}
+
+	template<class Iterator>
+	inline void
+		stable_sort(Iterator first, Iterator last)
+	{
+		mystl::stable_sort(first, last, std::less<>());
+	}
+
+	// stable LSD radix sort of a contiguous range of trivially copyable
+	// elements by key(element), an integer or floating point value. one pass
+	// counts every digit, then each 8 bit digit that is not the same for all
+	// elements costs one scatter into a buffer as large as the range. floats
+	// order -0.0 before 0.0 and put NaNs at the ends by their sign
+	template<class Iterator, class Key>
+	inline void
+		radix_sort(Iterator first, Iterator last, Key key)
+	{
+		using T = iterator_value_t<Iterator>;
+		using K = std::remove_cvref_t<std::invoke_result_t<Key&, const T&>>;
+		using U = decltype(detail::radix_key(std::declval<K>()));
+
+		static_assert(is_contiguous_iterator_v<Iterator>, "radix_sort needs a contiguous range");
+		static_assert(std::is_trivially_copyable_v<T>, "radix_sort copies the elements as bytes");
+		static_assert(std::is_arithmetic_v<K> && !std::is_same_v<K, bool>, "radix_sort keys are integers or floating point values");
+
+		constexpr size_t digits = sizeof(U);
+		const size_t size = size_t(last - first);
+
+		if (size < 2)
+			return;
+
+		T* data = &*first;
+
+		// small ranges: a stable insertion sort on the mapped keys
+		if (size <= size_t(detail::insertion_sort_threshold) * 4)
+		{
+			auto comp = [&](const T& a, const T& b) { return detail::radix_key(K(key(a))) < detail::radix_key(K(key(b))); };
+			detail::insertion_sort(data, data + size, comp);
+			return;
+		}
+
+		size_t counts[digits][256] = {};
+		for (size_t i = 0; i < size; i++)
+		{
+			U bits = detail::radix_key(K(key(data[i])));
+			for (size_t d = 0; d < digits; d++)
+				counts[d][(bits >> (d * 8)) & 0xff]++;
+		}
+
+		allocator<T> alloc{};
+		T* buffer = alloc.allocate(size);
+		T* source = data;
+		T* dest = buffer;
+
+		for (size_t d = 0; d < digits; d++)
+		{
+			size_t* count = counts[d];
+			size_t shift = d * 8;
+
+			// every element has the same digit, the pass would not move anything
+			if (count[(detail::radix_key(K(key(source[0]))) >> shift) & 0xff] == size)
+				continue;
+
+			size_t offsets[256];
+			size_t total = 0;
+			for (size_t b = 0; b < 256; b++)
+			{
+				offsets[b] = total;
+				total += count[b];
+			}
+
+			for (size_t i = 0; i < size; i++)
+			{
+				size_t digit = (detail::radix_key(K(key(source[i]))) >> shift) & 0xff;
+				std::memcpy(static_cast<void*>(dest + offsets[digit]++), static_cast<const void*>(source + i), sizeof(T));
+			}
+
+			std::swap(source, dest);
+		}
+
+		if (source != data)
+			std::memcpy(static_cast<void*>(data), static_cast<const void*>(source), size * sizeof(T));
+
+		alloc.deallocate(buffer, size);
+	}
+
+	template<class Iterator>
+	inline void
+		radix_sort(Iterator first, Iterator last)
+	{
+		mystl::radix_sort(first, last, detail::radix_identity());
+	}
+}
+
+#endif
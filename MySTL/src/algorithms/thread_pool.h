@@ -0,0 +1,231 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "../data_structures/vector.h"
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// thread_pool																		///
+///																					///
+/// This class is a fixed set of worker threads for the parallel algorithms.		///
+/// Work is handed over as a fork-join job: run(tasks, fn) calls fn(task) for		///
+/// every task in [0, tasks), with the calling thread taking tasks alongside		///
+/// the workers, and returns once all of them are done. Tasks are claimed			///
+/// through one atomic counter, so uneven tasks balance themselves. A run from		///
+/// inside a task executes inline instead of waiting on the pool.					///
+///																					///
+///////////////////////////////////////////////////////////////////////////////////////
+
+namespace mystl
+{
+	class thread_pool
+	{
+	// constructor/destructor
+	public:
+		explicit							thread_pool(const size_t& threads = std::thread::hardware_concurrency());
+											thread_pool(const thread_pool&) = delete;
+											~thread_pool();
+
+	// size functions
+	public:
+					size_t					size() const;
+
+	// job functions
+	public:
+		template<class Function>
+					void					run(const size_t& tasks, const Function& fn);
+
+		// shared pool with one thread per hardware thread, created on first use
+		static		thread_pool&			global();
+
+	// operators
+	public:
+					thread_pool&			operator=(const thread_pool&) = delete;
+
+	// helpers
+	private:
+		struct job
+		{
+			void					(*invoke)(const void* fn, const size_t& task);
+			const void*				fn;
+			size_t					tasks;
+			std::atomic<size_t>		next{ 0 };
+			std::exception_ptr		error{};
+			std::mutex				errorMutex{};
+		};
+
+		template<class Function>
+		static		void					invoke(const void* fn, const size_t& task);
+
+		static		void					work(job& current);
+		static		bool&					inside_pool();
+					void					worker_loop();
+
+	// variables
+	private:
+					vector<std::thread>		m_Workers{};
+
+					std::mutex				m_RunMutex{};
+					std::mutex				m_Mutex{};
+					std::condition_variable	m_Wake{};
+					std::condition_variable	m_Done{};
+
+					job*					m_Job			= nullptr;
+					size_t					m_Generation	= 0;
+					size_t					m_Active		= 0;
+					bool					m_Stop			= false;
+	};
+
+	// threads counts the calling thread, so a pool of n threads starts n - 1 workers
+	inline thread_pool::thread_pool(const size_t& threads)
+	{
+		size_t workers = threads > 1 ? threads - 1 : 0;
+
+		m_Workers.reserve(workers);
+		for (size_t i = 0; i < workers; i++)
+			m_Workers.emplace_back([this]() { worker_loop(); });
+	}
+
+	inline thread_pool::~thread_pool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Stop = true;
+		}
+
+		m_Wake.notify_all();
+
+		for (std::thread& worker : m_Workers)
+			worker.join();
+	}
+
+	inline size_t
+		thread_pool::size() const
+	{
+		return m_Workers.size() + 1;
+	}
+
+	// the first exception thrown by a task is rethrown here once every task
+	// has finished
+	template<class Function>
+	inline void
+		thread_pool::run(const size_t& tasks, const Function& fn)
+	{
+		if (tasks <= 1 || m_Workers.empty() || inside_pool())
+		{
+			for (size_t task = 0; task < tasks; task++)
+				fn(task);
+
+			return;
+		}
+
+		std::lock_guard<std::mutex> runLock(m_RunMutex);
+
+		job current{ &invoke<Function>, &fn, tasks };
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Job = &current;
+			m_Generation++;
+		}
+
+		m_Wake.notify_all();
+
+		inside_pool() = true;
+		work(current);
+		inside_pool() = false;
+
+		// every task is claimed at this point, wait for the ones still running
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_Done.wait(lock, [this]() { return m_Active == 0; });
+			m_Job = nullptr;
+		}
+
+		if (current.error)
+			std::rethrow_exception(current.error);
+	}
+
+	inline thread_pool&
+		thread_pool::global()
+	{
+		static thread_pool pool{};
+		return pool;
+	}
+
+	template<class Function>
+	inline void
+		thread_pool::invoke(const void* fn, const size_t& task)
+	{
+		(*static_cast<const Function*>(fn))(task);
+	}
+
+	inline void
+		thread_pool::work(job& current)
+	{
+		for (size_t task = current.next.fetch_add(1); task < current.tasks; task = current.next.fetch_add(1))
+		{
+			try
+			{
+				current.invoke(current.fn, task);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(current.errorMutex);
+				if (!current.error)
+					current.error = std::current_exception();
+			}
+		}
+	}
+
+	inline bool&
+		thread_pool::inside_pool()
+	{
+		thread_local bool inside = false;
+		return inside;
+	}
+
+	inline void
+		thread_pool::worker_loop()
+	{
+		inside_pool() = true;
+		size_t seen = 0;
+
+		while (true)
+		{
+			job* current = nullptr;
+
+			{
+				std::unique_lock<std::mutex> lock(m_Mutex);
+				m_Wake.wait(lock, [&]() { return m_Stop || m_Generation != seen; });
+
+				if (m_Stop)
+					return;
+
+				seen = m_Generation;
+				current = m_Job;
+
+				if (!current)
+					continue;
+
+				m_Active++;
+			}
+
+			work(*current);
+
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				if (--m_Active == 0)
+					m_Done.notify_all();
+			}
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,141 @@
+#ifndef ALLOCATOR_H
+#define ALLOCATOR_H
+
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <new>
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// allocator																		///
+///																					///
+/// This class is the default allocator used by the mystl containers. It hands		///
+/// out raw storage through ::operator new. Containers take the allocator as a		///
+/// template argument and rebind it to their node types, so any allocator that		///
+/// works with std::allocator_traits (arenas, pools, NUMA heaps, pmr) can be		///
+/// plugged in per container without a virtual call on the hot path.				///
+///																					///
+///////////////////////////////////////////////////////////////////////////////////////
+
+namespace mystl
+{
+	template<typename T>
+	class allocator
+	{
+	// typedefs
+	public:
+		using		value_type				= T;
+		using		pointer_type			= T*;
+
+		template<typename U>
+		struct rebind { using other = allocator<U>; };
+
+	// constructor/destructor
+	public:
+		constexpr							allocator() = default;
+
+		template<typename U>
+		constexpr							allocator(const allocator<U>&) { }
+
+	// allocation functions
+	public:
+		[[nodiscard]] pointer_type			allocate(const size_t& count);
+					void					deallocate(pointer_type ptr, const size_t& count);
+
+	// equality operators
+	public:
+		template<typename U>
+		constexpr	bool					operator==(const allocator<U>&) const { return true; }
+		template<typename U>
+		constexpr	bool					operator!=(const allocator<U>&) const { return false; }
+	};
+
+	// over-aligned types go through the aligned operator new, like new T would
+	template<typename T>
+	inline typename allocator<T>::pointer_type
+		allocator<T>::allocate(const size_t& count)
+	{
+		if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+			return static_cast<pointer_type>(::operator new(count * sizeof(T), std::align_val_t(alignof(T))));
+		else
+			return static_cast<pointer_type>(::operator new(count * sizeof(T)));
+	}
+
+	template<typename T>
+	inline void
+		allocator<T>::deallocate(pointer_type ptr, const size_t& count)
+	{
+		if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+			::operator delete(ptr, count * sizeof(T), std::align_val_t(alignof(T)));
+		else
+			::operator delete(ptr, count * sizeof(T));
+	}
+
+	// hands out blocks aligned to Align bytes (at least alignof(T)) through the
+	// aligned operator new. aligned_vector uses it to start data() on a cache
+	// line or a full avx register
+	template<typename T, size_t Align>
+	class aligned_allocator
+	{
+		static_assert(Align && !(Align & (Align - 1)), "alignment must be a power of two");
+
+	// typedefs
+	public:
+		using		value_type				= T;
+		using		pointer_type			= T*;
+
+		static constexpr size_t				alignment	= Align < alignof(T) ? alignof(T) : Align;
+
+		template<typename U>
+		struct rebind { using other = aligned_allocator<U, Align>; };
+
+	// constructor/destructor
+	public:
+		constexpr							aligned_allocator() = default;
+
+		template<typename U>
+		constexpr							aligned_allocator(const aligned_allocator<U, Align>&) { }
+
+	// allocation functions
+	public:
+		[[nodiscard]] pointer_type			allocate(const size_t& count);
+					void					deallocate(pointer_type ptr, const size_t& count);
+
+	// equality operators
+	public:
+		template<typename U>
+		constexpr	bool					operator==(const aligned_allocator<U, Align>&) const { return true; }
+		template<typename U>
+		constexpr	bool					operator!=(const aligned_allocator<U, Align>&) const { return false; }
+	};
+
+	template<typename T, size_t Align>
+	inline typename aligned_allocator<T, Align>::pointer_type
+		aligned_allocator<T, Align>::allocate(const size_t& count)
+	{
+		return static_cast<pointer_type>(::operator new(count * sizeof(T), std::align_val_t(alignment)));
+	}
+
+	template<typename T, size_t Align>
+	inline void
+		aligned_allocator<T, Align>::deallocate(pointer_type ptr, const size_t& count)
+	{
+		::operator delete(ptr, count * sizeof(T), std::align_val_t(alignment));
+	}
+
+	// the allocator a container should use for its node type U
+	template<class Allocator, typename U>
+	using rebind_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<U>;
+
+	// optional extension: T* reallocate(T* ptr, size_t oldCount, size_t newCount)
+	// resizes a block without the container copying it (e.g. through mremap).
+	// the contents are kept bitwise, so containers only use it for trivially
+	// relocatable types. returns nullptr, leaving ptr untouched, when it cannot
+	template<class Allocator>
+	inline constexpr bool has_reallocate_v = requires(Allocator& allocator, typename Allocator::value_type* ptr, size_t count)
+	{
+		{ allocator.reallocate(ptr, count, count) } -> std::same_as<typename Allocator::value_type*>;
+	};
+}
+
+#endif
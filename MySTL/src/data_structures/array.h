@@ -12,6 +12,8 @@
 
 #endif
 
+#include <utility>
+
 #include "iterator.h"
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -20,14 +22,18 @@
 /// This class is a templated array class meant to mimic the C++ STL array.			///
 /// The array takes in a type and a size. If no size is specified, the size			///
 /// defaults to 1. Note that in release mode, bounds checking is disabled.			///
+/// An optional third argument aligns the elements (see aligned_array).				///
 ///																					///
 ///////////////////////////////////////////////////////////////////////////////////////
 
 namespace mystl 
 {
-	template<typename T, size_t m_Size = 1>
+	template<typename T, size_t m_Size = 1, size_t Align = alignof(T)>
 	class array
 	{
+		static_assert(Align && !(Align & (Align - 1)), "alignment must be a power of two");
+		static_assert(Align >= alignof(T), "alignment cannot be weaker than the element type's");
+
 	// typedefs
 	public:
 		using		value_type				= T;
@@ -38,11 +44,11 @@ namespace mystl
 		using		const_reference_type	= const value_type&;
 		using		const_pointer_type		= const value_type*;
 		
-		using		const_iterator			= const_iterator<array<T, m_Size>>;
-		using		iterator				= iterator<array<T, m_Size>>;
+		using		const_iterator			= mystl::const_iterator<array<T, m_Size, Align>>;
+		using		iterator				= mystl::iterator<array<T, m_Size, Align>>;
 
-		using		const_reverse_iterator	= const_reverse_iterator<const_iterator>;
-		using		reverse_iterator		= reverse_iterator<iterator>;
+		using		const_reverse_iterator	= mystl::const_reverse_iterator<const_iterator>;
+		using		reverse_iterator		= mystl::reverse_iterator<iterator>;
 
 	// constructor/destructor
 	public:
@@ -73,14 +79,17 @@ namespace mystl
 
 	// mutator functions
 	public:
-					[[noreturn]] void		fill(const_reference_type filler);
-					[[noreturn]] void		swap(array& other);
+		constexpr	void					fill(const_reference_type filler);
+		constexpr	void					swap(array& other);
 
 	// iterator functions
 	public:
 		constexpr	const_iterator			cbegin() const;
 		constexpr	const_iterator			cend() const;
 
+		constexpr	const_iterator			begin() const;
+		constexpr	const_iterator			end() const;
+
 		constexpr	iterator				begin();
 		constexpr	iterator				end();
 
@@ -92,173 +101,196 @@ namespace mystl
 
 	// variables
 	private:
-					value_type				m_Data[m_Size]{};
+		alignas(Align) value_type			m_Data[m_Size]{};
 	};
 
-	template<typename T, size_t m_Size>
+	template<typename T, size_t m_Size, size_t Align>
 	constexpr size_t 
-		array<T, m_Size>::size() const
+		array<T, m_Size, Align>::size() const
 	{
 		return m_Size;
 	}
 
-	template<typename T, size_t m_Size>
+	template<typename T, size_t m_Size, size_t Align>
 	constexpr size_t 
-		array<T, m_Size>::max_size() const
+		array<T, m_Size, Align>::max_size() const
 	{
 		return m_Size;
 	}
 
-	template<typename T, size_t m_Size>
+	template<typename T, size_t m_Size, size_t Align>
 	constexpr bool 
-		array<T, m_Size>::empty() const
+		array<T, m_Size, Align>::empty() const
 	{
 		return m_Size == 0;
 	}
 
-	template<typename T, size_t m_Size>
-	constexpr typename array<T, m_Size>::reference_type
-		array<T, m_Size>::operator[](const size_t& index)
+	template<typename T, size_t m_Size, size_t Align>
+	constexpr typename array<T, m_Size, Align>::reference_type
+		array<T, m_Size, Align>::operator[](const size_t& index)
 	{
 		OUT_OF_RANGE(index);
 		return m_Data[index];
 	}
 
-	template<typename T, size_t m_Size>
-	constexpr typename array<T, m_Size>::const_reference_type
-		array<T, m_Size>::operator[](const size_t& index) const
+	template<typename T, size_t m_Size, size_t Align>
+	constexpr typename array<T, m_Size, Align>::const_reference_type
+		array<T, m_Size, Align>::operator[](const size_t& index) const
 	{
 		OUT_OF_RANGE(index);
 		return m_Data[index];
 	}
 
-	template<typename T, size_t m_Size>
-	constexpr typename array<T, m_Size>::const_reference_type
-		array<T, m_Size>::at(const size_t& index) const
+	template<typename T, size_t m_Size, size_t Align>
+	constexpr typename array<T, m_Size, Align>::const_reference_type
+		array<T, m_Size, Align>::at(const size_t& index) const
 	{
 		OUT_OF_RANGE(index);
 		return m_Data[index];
 	}
 
-	template<typename T, size_t m_Size>
-	constexpr typename array<T, m_Size>::reference_type
-		array<T, m_Size>::front()
+	template<typename T, size_t m_Size, size_t Align>
+	constexpr typename array<T, m_Size, Align>::reference_type
+		array<T, m_Size, Align>::front()
 	{
 		EMPTY_ARRAY();
 		return m_Data[0];
 	}
 
-	template<typename T, size_t m_Size>
-	constexpr typename array<T, m_Size>::reference_type
-		array<T, m_Size>::back()
+	template<typename T, size_t m_Size, size_t Align>
+	constexpr typename array<T, m_Size, Align>::reference_type
+		array<T, m_Size, Align>::back()
 	{
 		EMPTY_ARRAY();
 		return m_Data[m_Size - 1];
 	}
 
-	template<typename T, size_t m_Size>
-	constexpr typename array<T, m_Size>::const_reference_type
-		array<T, m_Size>::front() const
+	template<typename T, size_t m_Size, size_t Align>
+	constexpr typename array<T, m_Size, Align>::const_reference_type
+		array<T, m_Size, Align>::front() const
 	{
 		EMPTY_ARRAY();
 		return m_Data[0];
 	}
 
-	template<typename T, size_t m_Size>
-	constexpr typename array<T, m_Size>::const_reference_type
-		array<T, m_Size>::back() const
+	template<typename T, size_t m_Size, size_t Align>
+	constexpr typename array<T, m_Size, Align>::const_reference_type
+		array<T, m_Size, Align>::back() const
 	{
 		EMPTY_ARRAY();
 		return m_Data[m_Size - 1];
 	}
 
-	template<typename T, size_t m_Size>
-	constexpr typename array<T, m_Size>::pointer_type
-		array<T, m_Size>::data()
+	template<typename T, size_t m_Size, size_t Align>
+	constexpr typename array<T, m_Size, Align>::pointer_type
+		array<T, m_Size, Align>::data()
 	{
 		return m_Data;
 	}
 
-	template<typename T, size_t m_Size>
-	constexpr typename array<T, m_Size>::const_pointer_type
-		array<T, m_Size>::data() const
+	template<typename T, size_t m_Size, size_t Align>
+	constexpr typename array<T, m_Size, Align>::const_pointer_type
+		array<T, m_Size, Align>::data() const
 	{
 		return m_Data;
 	}
 
-	template<typename T, size_t m_Size>
-	inline void 
-		array<T, m_Size>::fill(const_reference_type filler)
+	template<typename T, size_t m_Size, size_t Align>
+	constexpr void
+		array<T, m_Size, Align>::fill(const_reference_type filler)
 	{
 		EMPTY_ARRAY();
 		for (size_t i = 0; i < m_Size; i++)
 			m_Data[i] = filler;
 	}
 
-	template<typename T, size_t m_Size>
-	inline void 
-		array<T, m_Size>::swap(array& other)
+	// swaps element by element, so no temporary array is built
+	template<typename T, size_t m_Size, size_t Align>
+	constexpr void
+		array<T, m_Size, Align>::swap(array& other)
 	{
-		array temp = *this;
-		*this = other;
-		other = temp;
+		using std::swap;
+		for (size_t i = 0; i < m_Size; i++)
+			swap(m_Data[i], other.m_Data[i]);
 	}
 
-	template<typename T, size_t m_Size>
-	constexpr typename array<T, m_Size>::const_iterator
-		array<T, m_Size>::cbegin() const
+	template<typename T, size_t m_Size, size_t Align>
+	constexpr typename array<T, m_Size, Align>::const_iterator
+		array<T, m_Size, Align>::cbegin() const
 	{
 		return const_iterator(m_Data);
 	}
 
-	template<typename T, size_t m_Size>
-	constexpr typename array<T, m_Size>::const_iterator
-		array<T, m_Size>::cend() const
+	template<typename T, size_t m_Size, size_t Align>
+	constexpr typename array<T, m_Size, Align>::const_iterator
+		array<T, m_Size, Align>::cend() const
 	{
 		return const_iterator(m_Data + m_Size);
 	}
 
-	template<typename T, size_t m_Size>
-	constexpr typename array<T, m_Size>::iterator
-		array<T, m_Size>::begin()
+	template<typename T, size_t m_Size, size_t Align>
+	constexpr typename array<T, m_Size, Align>::const_iterator
+		array<T, m_Size, Align>::begin() const
+	{
+		return cbegin();
+	}
+
+	template<typename T, size_t m_Size, size_t Align>
+	constexpr typename array<T, m_Size, Align>::const_iterator
+		array<T, m_Size, Align>::end() const
+	{
+		return cend();
+	}
+
+	template<typename T, size_t m_Size, size_t Align>
+	constexpr typename array<T, m_Size, Align>::iterator
+		array<T, m_Size, Align>::begin()
 	{
 		return iterator(m_Data);
 	}
 
-	template<typename T, size_t m_Size>
-	constexpr typename array<T, m_Size>::iterator
-		array<T, m_Size>::end()
+	template<typename T, size_t m_Size, size_t Align>
+	constexpr typename array<T, m_Size, Align>::iterator
+		array<T, m_Size, Align>::end()
 	{
 		return iterator(m_Data + m_Size);
 	}
 
-	template<typename T, size_t m_Size>
-	constexpr typename array<T, m_Size>::const_reverse_iterator
-		array<T, m_Size>::crbegin() const
+	template<typename T, size_t m_Size, size_t Align>
+	constexpr typename array<T, m_Size, Align>::const_reverse_iterator
+		array<T, m_Size, Align>::crbegin() const
 	{
 		return const_reverse_iterator(cend());
 	}
 
-	template<typename T, size_t m_Size>
-	constexpr typename array<T, m_Size>::const_reverse_iterator
-		array<T, m_Size>::crend() const
+	template<typename T, size_t m_Size, size_t Align>
+	constexpr typename array<T, m_Size, Align>::const_reverse_iterator
+		array<T, m_Size, Align>::crend() const
 	{
 		return const_reverse_iterator(cbegin());
 	}
 
-	template<typename T, size_t m_Size>
-	constexpr typename array<T, m_Size>::reverse_iterator
-		array<T, m_Size>::rbegin()
+	template<typename T, size_t m_Size, size_t Align>
+	constexpr typename array<T, m_Size, Align>::reverse_iterator
+		array<T, m_Size, Align>::rbegin()
 	{
 		return reverse_iterator(end());
 	}
 
-	template<typename T, size_t m_Size>
-	constexpr typename array<T, m_Size>::reverse_iterator
-		array<T, m_Size>::rend()
+	template<typename T, size_t m_Size, size_t Align>
+	constexpr typename array<T, m_Size, Align>::reverse_iterator
+		array<T, m_Size, Align>::rend()
 	{
 		return reverse_iterator(begin());
 	}
 }
 
-#endif
\ No newline at end of file
+// aligned_array
+namespace mystl
+{
+	// array whose data() starts on an Align byte boundary, 64 (a cache line) by default
+	template<typename T, size_t N, size_t Align = 64>
+	using aligned_array = array<T, N, Align>;
+}
+
+#endif
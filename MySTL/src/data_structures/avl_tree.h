@@ -5,16 +5,17 @@
 
 namespace mystl
 {
-	template<typename T>
-	class avl_tree : public binary_search_tree<T>
+	template<typename T, class Allocator = allocator<T>>
+	class avl_tree : public binary_search_tree<T, Allocator>
 	{
 	// base class
 	public:
-		using base_class = binary_search_tree<T>;
+		using base_class = binary_search_tree<T, Allocator>;
 
 	// typedefs
 	public:
 		using value_type = base_class::value_type;
+		using allocator_type = base_class::allocator_type;
 
 		using reference_type = base_class::reference_type;
 		using pointer_type = base_class::pointer_type;
@@ -46,30 +47,32 @@ namespace mystl
 		constexpr size_t height_diff(binary_node_ptr root);
 	};
 
-	template<typename T>
+	template<typename T, class Allocator>
 	template<typename ...Args>
-	constexpr typename avl_tree<T>::binary_node_ptr avl_tree<T>::emplace(Args && ...args)
+	constexpr typename avl_tree<T, Allocator>::binary_node_ptr avl_tree<T, Allocator>::emplace(Args && ...args)
 	{
 		auto temp = base_class::emplace(std::forward<Args>(args)...);
 
-		restructure(m_Root);
+		restructure(this->m_Root);
+
+		return temp;
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	template<typename ...Args>
-	constexpr typename avl_tree<T>::binary_node_ptr avl_tree<T>::emplace(binary_node_ptr& root, Args && ...args)
+	constexpr typename avl_tree<T, Allocator>::binary_node_ptr avl_tree<T, Allocator>::emplace(binary_node_ptr& root, Args && ...args)
 	{
 		return binary_node_ptr();
 	}
 
-	template<typename T>
-	constexpr typename avl_tree<T>::binary_node_ptr avl_tree<T>::push(const_reference_type element)
+	template<typename T, class Allocator>
+	constexpr typename avl_tree<T, Allocator>::binary_node_ptr avl_tree<T, Allocator>::push(const_reference_type element)
 	{
 		return binary_node_ptr();
 	}
 
-	template<typename T>
-	constexpr void avl_tree<T>::restructure(binary_node_ptr& root)
+	template<typename T, class Allocator>
+	constexpr void avl_tree<T, Allocator>::restructure(binary_node_ptr& root)
 	{
 
 	}
@@ -95,8 +98,8 @@ namespace mystl
 	//		 / \	
 	//		T2 T3
 	//
-	template<typename T>
-	constexpr void avl_tree<T>::left_rotate(binary_node_ptr& z)
+	template<typename T, class Allocator>
+	constexpr void avl_tree<T, Allocator>::left_rotate(binary_node_ptr& z)
 	{
 		binary_node_ptr y = z->right;
 		binary_node_ptr t2 = y->left;
@@ -128,8 +131,8 @@ namespace mystl
 	//		 / \	
 	//		T2 T3
 	//
-	template<typename T>
-	constexpr void avl_tree<T>::right_rotate(binary_node_ptr& z)
+	template<typename T, class Allocator>
+	constexpr void avl_tree<T, Allocator>::right_rotate(binary_node_ptr& z)
 	{
 		binary_node_ptr y = z->left;
 		binary_node_ptr t3 = y->right;
@@ -140,20 +143,20 @@ namespace mystl
 		z->parent = y;
 	}
 
-	template<typename T>
-	constexpr size_t avl_tree<T>::left_height(binary_node_ptr root)
+	template<typename T, class Allocator>
+	constexpr size_t avl_tree<T, Allocator>::left_height(binary_node_ptr root)
 	{
 		return height(root->left);
 	}
 
-	template<typename T>
-	constexpr size_t avl_tree<T>::right_height(binary_node_ptr root)
+	template<typename T, class Allocator>
+	constexpr size_t avl_tree<T, Allocator>::right_height(binary_node_ptr root)
 	{
 		return height(root->right);
 	}
 
-	template<typename T>
-	constexpr size_t avl_tree<T>::height_diff(binary_node_ptr root)
+	template<typename T, class Allocator>
+	constexpr size_t avl_tree<T, Allocator>::height_diff(binary_node_ptr root)
 	{
 		return left_height(root) - right_height(root);
 	}
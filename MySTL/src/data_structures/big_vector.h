@@ -0,0 +1,204 @@
+#ifndef BIG_VECTOR_H
+#define BIG_VECTOR_H
+
+#include <cstddef>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include "growth_policy.h"
+#include "vector.h"
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// big_vector																		///
+///																					///
+/// This class is a vector for buffers of hundreds of megabytes or more. It is		///
+/// mystl::vector with mmap_allocator, which maps large blocks straight from		///
+/// the kernel (asking for huge pages) and resizes them with mremap. Trivially		///
+/// relocatable elements are then never copied when the vector grows or				///
+/// shrinks: the kernel moves the page tables, so the resident set does not			///
+/// double during a reallocation. Small blocks come from ::operator new.			///
+///																					///
+///////////////////////////////////////////////////////////////////////////////////////
+
+// mmap_allocator
+namespace mystl
+{
+	// how mmap_allocator asks for huge pages on blocks of 2 MiB and up
+	enum class huge_pages
+	{
+		none,			// regular pages only
+		transparent,	// madvise(MADV_HUGEPAGE): the kernel backs the block with huge pages when it can
+		reserved		// MAP_HUGETLB from the reserved pool, transparent if the pool is empty
+	};
+
+	template<typename T, huge_pages Pages = huge_pages::transparent>
+	class mmap_allocator
+	{
+	// typedefs
+	public:
+		using		value_type				= T;
+		using		pointer_type			= T*;
+
+		template<typename U>
+		struct rebind { using other = mmap_allocator<U, Pages>; };
+
+	// sizes
+	public:
+		static constexpr size_t				page_size		= size_t(4) << 10;
+		static constexpr size_t				huge_page_size	= size_t(2) << 20;
+
+		// blocks smaller than this come from ::operator new
+		static constexpr size_t				mmap_threshold	= size_t(128) << 10;
+
+	// constructor/destructor
+	public:
+		constexpr							mmap_allocator() = default;
+
+		template<typename U>
+		constexpr							mmap_allocator(const mmap_allocator<U, Pages>&) { }
+
+	// allocation functions
+	public:
+		[[nodiscard]] pointer_type			allocate(const size_t& count);
+					void					deallocate(pointer_type ptr, const size_t& count);
+		[[nodiscard]] pointer_type			reallocate(pointer_type ptr, const size_t& oldCount, const size_t& newCount);
+
+	// equality operators
+	public:
+		template<typename U>
+		constexpr	bool					operator==(const mmap_allocator<U, Pages>&) const { return true; }
+		template<typename U>
+		constexpr	bool					operator!=(const mmap_allocator<U, Pages>&) const { return false; }
+
+	// helpers
+	private:
+		static constexpr size_t				mapped_bytes(const size_t& count);
+		static		void					advise(void* ptr, const size_t& bytes);
+	};
+
+	template<typename T, huge_pages Pages>
+	inline typename mmap_allocator<T, Pages>::pointer_type
+		mmap_allocator<T, Pages>::allocate(const size_t& count)
+	{
+		size_t bytes = mapped_bytes(count);
+
+		if (!bytes)
+			return static_cast<pointer_type>(::operator new(count * sizeof(T)));
+
+#if defined(__linux__)
+		void* ptr = MAP_FAILED;
+
+#if defined(MAP_HUGETLB)
+		if constexpr (Pages == huge_pages::reserved)
+		{
+			if (bytes % huge_page_size == 0)
+				ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		}
+#endif
+
+		if (ptr == MAP_FAILED)
+			ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+		if (ptr == MAP_FAILED)
+			throw std::bad_alloc();
+
+		advise(ptr, bytes);
+
+		return static_cast<pointer_type>(ptr);
+#else
+		return static_cast<pointer_type>(::operator new(count * sizeof(T)));
+#endif
+	}
+
+	template<typename T, huge_pages Pages>
+	inline void
+		mmap_allocator<T, Pages>::deallocate(pointer_type ptr, const size_t& count)
+	{
+		size_t bytes = mapped_bytes(count);
+
+		if (!bytes)
+		{
+			::operator delete(ptr, count * sizeof(T));
+			return;
+		}
+
+#if defined(__linux__)
+		munmap(ptr, bytes);
+#endif
+	}
+
+	// grows or shrinks a mapped block with mremap. shrinking unmaps the tail,
+	// so the pages go straight back to the kernel. blocks on the heap side of
+	// the threshold return nullptr and are copied by the container
+	template<typename T, huge_pages Pages>
+	inline typename mmap_allocator<T, Pages>::pointer_type
+		mmap_allocator<T, Pages>::reallocate(pointer_type ptr, const size_t& oldCount, const size_t& newCount)
+	{
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+		size_t oldBytes = mapped_bytes(oldCount);
+		size_t newBytes = mapped_bytes(newCount);
+
+		if (!oldBytes || !newBytes)
+			return nullptr;
+
+		if (oldBytes == newBytes)
+			return ptr;
+
+		void* resized = mremap(ptr, oldBytes, newBytes, MREMAP_MAYMOVE);
+		if (resized == MAP_FAILED)
+			return nullptr;
+
+		if (newBytes > oldBytes)
+			advise(resized, newBytes);
+
+		return static_cast<pointer_type>(resized);
+#else
+		return nullptr;
+#endif
+	}
+
+	// size of the mapping behind count elements, 0 for heap blocks. blocks of
+	// a huge page or more are rounded to whole huge pages
+	template<typename T, huge_pages Pages>
+	constexpr size_t
+		mmap_allocator<T, Pages>::mapped_bytes(const size_t& count)
+	{
+#if defined(__linux__)
+		size_t bytes = count * sizeof(T);
+
+		if (bytes < mmap_threshold)
+			return 0;
+
+		size_t granule = Pages != huge_pages::none && bytes >= huge_page_size ? huge_page_size : page_size;
+
+		return (bytes + granule - 1) & ~(granule - 1);
+#else
+		return 0;
+#endif
+	}
+
+	template<typename T, huge_pages Pages>
+	inline void
+		mmap_allocator<T, Pages>::advise(void* ptr, const size_t& bytes)
+	{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+		if constexpr (Pages != huge_pages::none)
+		{
+			if (bytes >= huge_page_size)
+				madvise(ptr, bytes, MADV_HUGEPAGE);
+		}
+#endif
+	}
+}
+
+// big_vector
+namespace mystl
+{
+	template<typename T, class GrowthPolicy = growth::huge_page_aligned, huge_pages Pages = huge_pages::transparent>
+	using big_vector = vector<T, GrowthPolicy, mmap_allocator<T, Pages>>;
+}
+
+#endif
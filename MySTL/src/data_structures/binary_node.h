@@ -1,6 +1,8 @@
 #ifndef BINARY_NODE_H
 #define BINARY_NODE_H
 
+#include <utility>
+
 namespace mystl
 {
 	template<typename T>
@@ -20,6 +22,9 @@ namespace mystl
 	public:
 		constexpr				binary_node() : data(value_type()), left(nullptr), right(nullptr), parent(nullptr) { }
 		constexpr				binary_node(const_reference_type data) : data(data), left(nullptr), right(nullptr), parent(nullptr) { }
+
+		template<typename... Args>
+		constexpr	explicit	binary_node(std::in_place_t, Args&&... args) : data(std::forward<Args>(args)...), left(nullptr), right(nullptr), parent(nullptr) { }
 								~binary_node() = default;
 	};
 }
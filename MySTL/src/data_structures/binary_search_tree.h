@@ -1,18 +1,23 @@
 #ifndef BINARY_SEARCH_TREE_H
 #define BINARY_SEARCH_TREE_H
 
+#include <utility>
+
+#include "allocator.h"
 #include "binary_node.h"
 #include "vector.h"
 #include "queue.h"
+#include "telemetry.h"
 
 namespace mystl
 {
-	template<typename T>
+	template<typename T, class Allocator = allocator<T>>
 	class binary_search_tree
 	{
 	// typedefs
 	public:
 		using value_type = T;
+		using allocator_type = Allocator;
 
 		using reference_type = T&;
 		using pointer_type = T*;
@@ -20,12 +25,15 @@ namespace mystl
 		using const_reference_type = const T&;
 		using const_pointer_type = const T*;
 
-		using binary_node = binary_node<T>;
+		using binary_node = mystl::binary_node<T>;
 		using binary_node_ptr = binary_node*;
+		using node_allocator = rebind_allocator<Allocator, binary_node>;
 
 	// constructor/destructor
 	public:
 		constexpr binary_search_tree();
+		constexpr explicit binary_search_tree(const Allocator& allocator);
+		constexpr binary_search_tree(binary_search_tree&& other) noexcept;
 		~binary_search_tree();
 
 	// element access
@@ -43,6 +51,8 @@ namespace mystl
 		constexpr size_t size() const;
 		constexpr bool empty() const;
 
+		constexpr telemetry::counters telemetry_stats() const;
+
 	// mutator functions
 	public:
 		template<typename... Args>
@@ -53,6 +63,11 @@ namespace mystl
 	// mutator functions
 	public:
 		constexpr void erase(const_reference_type element);
+		void swap(binary_search_tree& other);
+
+	// operators
+	public:
+		constexpr binary_search_tree& operator=(binary_search_tree&& other);
 
 	// conversion functions
 	public:
@@ -81,134 +96,191 @@ namespace mystl
 		constexpr binary_node_ptr search(const_reference_type element, binary_node_ptr root) const;
 		constexpr size_t max_height(binary_node_ptr root);
 		constexpr void delete_tree(binary_node_ptr root);
-		constexpr bool find(const_reference_type element, binary_node_ptr root);
+		constexpr bool find(const_reference_type element, binary_node_ptr root) const;
 		constexpr binary_node_ptr erase(binary_node_ptr root, const_reference_type element);
 
+	// node allocation
+	protected:
+		template<typename... Args>
+		constexpr binary_node_ptr create_node(Args&&... args);
+		constexpr void destroy_node(binary_node_ptr node);
+
 	// variables
 	protected:
 		binary_node_ptr m_Root = nullptr;
 		size_t m_Size = 0;
+		node_allocator m_Allocator{};
+		MYSTL_NO_UNIQUE_ADDRESS telemetry::probe<binary_search_tree> m_Telemetry{};
 	};
 
-	template<typename T>
-	constexpr binary_search_tree<T>::binary_search_tree() : m_Root(nullptr), m_Size(0) { }
+	template<typename T, class Allocator>
+	constexpr binary_search_tree<T, Allocator>::binary_search_tree() : m_Root(nullptr), m_Size(0) { }
+
+	template<typename T, class Allocator>
+	constexpr binary_search_tree<T, Allocator>::binary_search_tree(const Allocator& allocator) : m_Root(nullptr), m_Size(0), m_Allocator(allocator) { }
+
+	// takes other's nodes; other is left empty
+	template<typename T, class Allocator>
+	constexpr binary_search_tree<T, Allocator>::binary_search_tree(binary_search_tree&& other) noexcept : m_Root(other.m_Root), m_Size(other.m_Size), m_Allocator(std::move(other.m_Allocator)), m_Telemetry(std::move(other.m_Telemetry))
+	{
+		other.m_Root = nullptr;
+		other.m_Size = 0;
+	}
 
-	template<typename T>
-	inline binary_search_tree<T>::~binary_search_tree()
+	template<typename T, class Allocator>
+	inline binary_search_tree<T, Allocator>::~binary_search_tree()
 	{
 		delete_tree(m_Root);
 	}
 
-	template<typename T>
-	constexpr typename binary_search_tree<T>::binary_node_ptr 
-		binary_search_tree<T>::search(const_reference_type element) const
+	template<typename T, class Allocator>
+	constexpr typename binary_search_tree<T, Allocator>::binary_node_ptr 
+		binary_search_tree<T, Allocator>::search(const_reference_type element) const
 	{
 		return search(element, m_Root);
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	constexpr bool 
-		binary_search_tree<T>::contains(const_reference_type element) const
+		binary_search_tree<T, Allocator>::contains(const_reference_type element) const
 	{
 		return find(element, m_Root);
 	}
 
-	template<typename T>
-	constexpr typename binary_search_tree<T>::binary_node_ptr
-		binary_search_tree<T>::root()
+	template<typename T, class Allocator>
+	constexpr typename binary_search_tree<T, Allocator>::binary_node_ptr
+		binary_search_tree<T, Allocator>::root()
 	{
 		return m_Root;
 	}
 
-	template<typename T>
-	constexpr typename binary_search_tree<T>::binary_node_ptr 
-		binary_search_tree<T>::root() const
+	template<typename T, class Allocator>
+	constexpr typename binary_search_tree<T, Allocator>::binary_node_ptr 
+		binary_search_tree<T, Allocator>::root() const
 	{
 		return m_Root;
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	constexpr size_t 
-		binary_search_tree<T>::height(binary_node_ptr root) const
+		binary_search_tree<T, Allocator>::height(binary_node_ptr root) const
 	{
 		return max_height(root);
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	constexpr size_t 
-		binary_search_tree<T>::depth(binary_node_ptr root) const
+		binary_search_tree<T, Allocator>::depth(binary_node_ptr root) const
 	{
 		return max_height(m_Root) - max_height(root);
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	constexpr size_t 
-		binary_search_tree<T>::size() const
+		binary_search_tree<T, Allocator>::size() const
 	{
 		return m_Size;
 	}
 
-	template<typename T>
-	constexpr bool binary_search_tree<T>::empty() const
+	template<typename T, class Allocator>
+	constexpr bool binary_search_tree<T, Allocator>::empty() const
 	{
 		return !m_Root;
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
+	constexpr telemetry::counters binary_search_tree<T, Allocator>::telemetry_stats() const
+	{
+		return m_Telemetry.stats();
+	}
+
+	template<typename T, class Allocator>
 	template<typename ...Args>
-	constexpr typename binary_search_tree<T>::binary_node_ptr
-		binary_search_tree<T>::emplace(Args && ...args)
+	constexpr typename binary_search_tree<T, Allocator>::binary_node_ptr
+		binary_search_tree<T, Allocator>::emplace(Args && ...args)
 	{
-		return emplace(m_Root, nullptr, std::forward<Args>(args)...);
+		return emplace(m_Root, binary_node_ptr(nullptr), std::forward<Args>(args)...);
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	template<typename ...Args>
-	constexpr typename binary_search_tree<T>::binary_node_ptr 
-		binary_search_tree<T>::emplace(binary_node_ptr& root, binary_node_ptr parent, Args && ...args)
+	constexpr typename binary_search_tree<T, Allocator>::binary_node_ptr 
+		binary_search_tree<T, Allocator>::emplace(binary_node_ptr& root, binary_node_ptr parent, Args && ...args)
 	{
-		binary_node_ptr temp = new binary_node(std::forward<Args>(args)...);
+		binary_node_ptr temp = create_node(std::forward<Args>(args)...);
+		binary_node_ptr* link = &root;
 
-		if (!root)
+		while (*link)
 		{
-			root = temp;
-			root->parent = parent;
-			m_Size++;
-			return temp;
+			parent = *link;
+
+			if (temp->data < parent->data)
+				link = &parent->left;
+			else if (temp->data > parent->data)
+				link = &parent->right;
+			else
+			{
+				destroy_node(temp);
+				return parent;
+			}
 		}
-		else if (temp->data < root->data)
-			return emplace(root->left, std::forward<Args>(args)...);
-		else if (temp->data > root->data)
-			return emplace(root->right, std::forward<Args>(args)...);
-		else
-			return temp;
+
+		*link = temp;
+		temp->parent = parent;
+		m_Size++;
+
+		return temp;
 	}
 
-	template<typename T>
-	constexpr typename binary_search_tree<T>::binary_node_ptr 
-		binary_search_tree<T>::push(const_reference_type element)
+	template<typename T, class Allocator>
+	constexpr typename binary_search_tree<T, Allocator>::binary_node_ptr 
+		binary_search_tree<T, Allocator>::push(const_reference_type element)
 	{
 		return emplace(element);
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	constexpr void 
-		binary_search_tree<T>::erase(const_reference_type element)
+		binary_search_tree<T, Allocator>::erase(const_reference_type element)
 	{
-		m_Size--;
-		erase(m_Root, element);
+		m_Root = erase(m_Root, element);
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
+	inline void
+		binary_search_tree<T, Allocator>::swap(binary_search_tree& other)
+	{
+		std::swap(m_Root, other.m_Root);
+		std::swap(m_Size, other.m_Size);
+		std::swap(m_Allocator, other.m_Allocator);
+		std::swap(m_Telemetry, other.m_Telemetry);
+	}
+
+	template<typename T, class Allocator>
+	constexpr binary_search_tree<T, Allocator>&
+		binary_search_tree<T, Allocator>::operator=(binary_search_tree&& other)
+	{
+		if (this == &other)
+			return *this;
+
+		delete_tree(m_Root);
+		m_Root = nullptr;
+		m_Size = 0;
+		swap(other);
+
+		return *this;
+	}
+
+	template<typename T, class Allocator>
 	constexpr vector<T> 
-		binary_search_tree<T>::to_vector() const
+		binary_search_tree<T, Allocator>::to_vector() const
 	{
-		return;
+		return inorder();
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	constexpr vector<T>
-		binary_search_tree<T>::preorder() const
+		binary_search_tree<T, Allocator>::preorder() const
 	{
 		vector<T> order(m_Size);
 
@@ -217,9 +289,9 @@ namespace mystl
 		return order;
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	constexpr vector<T>
-		binary_search_tree<T>::inorder() const
+		binary_search_tree<T, Allocator>::inorder() const
 	{
 		vector<T> order(m_Size);
 
@@ -228,9 +300,9 @@ namespace mystl
 		return order;
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	constexpr vector<T> 
-		binary_search_tree<T>::postorder() const
+		binary_search_tree<T, Allocator>::postorder() const
 	{
 		vector<T> order(m_Size);
 		
@@ -239,9 +311,9 @@ namespace mystl
 		return order;
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	constexpr vector<vector<T>> 
-		binary_search_tree<T>::level_order() const
+		binary_search_tree<T, Allocator>::level_order() const
 	{
 		vector<vector<T>> order(m_Size);
 
@@ -250,16 +322,16 @@ namespace mystl
 		return order;
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	constexpr vector<vector<T>> 
-		binary_search_tree<T>::breadth_first() const
+		binary_search_tree<T, Allocator>::breadth_first() const
 	{
 		return level_order();
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	constexpr void 
-		binary_search_tree<T>::preorder(binary_node_ptr root, vector<T>& order) const
+		binary_search_tree<T, Allocator>::preorder(binary_node_ptr root, vector<T>& order) const
 	{
 		if (!root)
 			return;
@@ -269,9 +341,9 @@ namespace mystl
 		preorder(root->right, order);
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	constexpr void 
-		binary_search_tree<T>::inorder(binary_node_ptr root, vector<T>& order) const
+		binary_search_tree<T, Allocator>::inorder(binary_node_ptr root, vector<T>& order) const
 	{
 		if (!root)
 			return;
@@ -281,9 +353,9 @@ namespace mystl
 		inorder(root->right, order);
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	constexpr void 
-		binary_search_tree<T>::postorder(binary_node_ptr root, vector<T>& order) const
+		binary_search_tree<T, Allocator>::postorder(binary_node_ptr root, vector<T>& order) const
 	{
 		if (!root)
 			return;
@@ -293,9 +365,9 @@ namespace mystl
 		order.emplace_back(root->data);
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	constexpr void 
-		binary_search_tree<T>::level_order(binary_node_ptr root, vector<vector<T>>& order) const
+		binary_search_tree<T, Allocator>::level_order(binary_node_ptr root, vector<vector<T>>& order) const
 	{
 		queue<binary_node_ptr> temp{};
 
@@ -324,16 +396,16 @@ namespace mystl
 		}
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	constexpr void 
-		binary_search_tree<T>::breadth_first(binary_node_ptr root, vector<vector<T>>& order) const
+		binary_search_tree<T, Allocator>::breadth_first(binary_node_ptr root, vector<vector<T>>& order) const
 	{
 		level_order(root, order);
 	}
 
-	template<typename T>
-	constexpr typename binary_search_tree<T>::binary_node_ptr 
-		binary_search_tree<T>::search(const_reference_type element, binary_node_ptr root) const
+	template<typename T, class Allocator>
+	constexpr typename binary_search_tree<T, Allocator>::binary_node_ptr 
+		binary_search_tree<T, Allocator>::search(const_reference_type element, binary_node_ptr root) const
 	{
 		if (!root)
 			return nullptr;
@@ -345,9 +417,9 @@ namespace mystl
 			return search(element, root->right);
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	constexpr size_t 
-		binary_search_tree<T>::max_height(binary_node_ptr root)
+		binary_search_tree<T, Allocator>::max_height(binary_node_ptr root)
 	{
 		if (!root)
 			return 0;
@@ -358,9 +430,9 @@ namespace mystl
 		return left_height > right_height ? (left_height + 1) : (right_height + 1);
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	constexpr void 
-		binary_search_tree<T>::delete_tree(binary_node_ptr root)
+		binary_search_tree<T, Allocator>::delete_tree(binary_node_ptr root)
 	{
 		if (!root)
 			return;
@@ -368,28 +440,28 @@ namespace mystl
 		delete_tree(root->right);
 		delete_tree(root->left);
 
-		delete root;
+		destroy_node(root);
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	constexpr bool 
-		binary_search_tree<T>::find(const_reference_type element, binary_node_ptr root)
+		binary_search_tree<T, Allocator>::find(const_reference_type element, binary_node_ptr root) const
 	{
 		if (!root)
 			return false;
 		else if (root->data == element)
 			return true;
 		else if (element < root->data)
-			find(element, root->left);
+			return find(element, root->left);
 		else if (element > root->data)
-			find(element, root->right);
+			return find(element, root->right);
 
 		return false;
 	}
 
-	template<typename T>
-	constexpr typename binary_search_tree<T>::binary_node_ptr
-		binary_search_tree<T>::erase(binary_node_ptr root, const_reference_type element)
+	template<typename T, class Allocator>
+	constexpr typename binary_search_tree<T, Allocator>::binary_node_ptr
+		binary_search_tree<T, Allocator>::erase(binary_node_ptr root, const_reference_type element)
 	{
 		if (!root)
 			return nullptr;
@@ -399,18 +471,15 @@ namespace mystl
 			root->right = erase(root->right, element);
 		else
 		{
-			if (!root->left && !root->right)
-				return nullptr;
-			else if (!root->left)
+			// a node with at most one child is replaced by that child
+			if (!root->left || !root->right)
 			{
-				binary_node_ptr temp = root->right;
-				delete root;
-				return temp;
-			}
-			else if (!root->right)
-			{
-				binary_node_ptr temp = root->left;
-				delete root;
+				binary_node_ptr temp = root->left ? root->left : root->right;
+				if (temp)
+					temp->parent = root->parent;
+
+				destroy_node(root);
+				m_Size--;
 				return temp;
 			}
 			
@@ -429,6 +498,27 @@ namespace mystl
 
 		return root;
 	}
+
+	template<typename T, class Allocator>
+	template<typename ...Args>
+	constexpr typename binary_search_tree<T, Allocator>::binary_node_ptr
+		binary_search_tree<T, Allocator>::create_node(Args && ...args)
+	{
+		binary_node_ptr node = m_Allocator.allocate(1);
+		m_Telemetry.allocated(node, sizeof(binary_node));
+		new(node) binary_node(std::in_place, std::forward<Args>(args)...);
+
+		return node;
+	}
+
+	template<typename T, class Allocator>
+	constexpr void
+		binary_search_tree<T, Allocator>::destroy_node(binary_node_ptr node)
+	{
+		node->~binary_node();
+		m_Telemetry.freed(node, sizeof(binary_node));
+		m_Allocator.deallocate(node, 1);
+	}
 }
 
 #endif
\ No newline at end of file
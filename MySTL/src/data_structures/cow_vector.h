@@ -0,0 +1,637 @@
+#ifndef COW_VECTOR_H
+#define COW_VECTOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "allocator.h"
+#include "growth_policy.h"
+#include "iterator.h"
+#include "memory.h"
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// cow_vector																		///
+///																					///
+/// This class is a copy-on-write vector. Copies share one buffer whose				///
+/// reference count is atomic, so copying (handing a snapshot to another			///
+/// thread) is O(1). The first mutation of a shared buffer clones it; a buffer		///
+/// with a single owner is mutated in place exactly like mystl::vector. Const		///
+/// access reads the element pointer directly, with no extra indirection.			///
+/// Non-const access (operator[], data(), begin()) counts as a mutation and			///
+/// marks the buffer unshareable: the reference it returned may still be			///
+/// written through, so copies are deep until mark_shareable() is called.			///
+///																					///
+///////////////////////////////////////////////////////////////////////////////////////
+
+namespace mystl
+{
+	template<typename T, class GrowthPolicy = growth::standard, class Allocator = allocator<T>>
+	class cow_vector
+	{
+	// typedefs
+	public:
+		using		value_type				= T;
+		using		allocator_type			= Allocator;
+
+		using		reference_type			= T&;
+		using		pointer_type			= T*;
+
+		using		const_reference_type	= const T&;
+		using		const_pointer_type		= const T*;
+
+		using		const_iterator			= mystl::const_iterator<cow_vector<T, GrowthPolicy, Allocator>>;
+		using		iterator				= mystl::iterator<cow_vector<T, GrowthPolicy, Allocator>>;
+
+	// constructor/destructor
+	public:
+		constexpr							cow_vector() = default;
+		constexpr	explicit				cow_vector(const Allocator& allocator);
+											cow_vector(const size_t& count, const_reference_type fillElement);
+											cow_vector(const cow_vector& other);
+											cow_vector(cow_vector&& other) noexcept;
+											~cow_vector();
+
+	// size functions
+	public:
+		constexpr	size_t					size() const;
+		constexpr	size_t					capacity() const;
+		constexpr	bool					empty() const;
+
+		// owners of the buffer, 0 when there is none
+					size_t					use_count() const;
+					bool					is_shared() const;
+
+		// false while a reference or iterator from non-const access may be in use
+					bool					is_shareable() const;
+					void					mark_shareable();
+
+	// const access functions
+	public:
+		constexpr	const_reference_type	operator[](const size_t& index) const;
+		constexpr	const_reference_type	at(const size_t& index) const;
+
+		constexpr	const_reference_type	front() const;
+		constexpr	const_reference_type	back() const;
+
+		constexpr	const_pointer_type		data() const;
+		constexpr	const_pointer_type		cdata() const;
+
+	// mutable access functions (clone a shared buffer first)
+	public:
+					reference_type			operator[](const size_t& index);
+					reference_type			front();
+					reference_type			back();
+					pointer_type			data();
+
+	// mutator functions (the returned references do not mark the buffer
+	// unshareable, do not write through them after copying the vector)
+	public:
+					reference_type			push_back(T&& element);
+					reference_type			push_back(const_reference_type element);
+
+		template<typename... Args>
+					reference_type			emplace_back(Args&&... args);
+
+					value_type				pop_back();
+
+					void					clear();
+					void					reserve(const size_t& size);
+					void					resize(const size_t& size);
+					void					resize(const size_t& size, const_reference_type fillElement);
+					void					shrink_to_fit();
+					void					swap(cow_vector& other) noexcept;
+
+	// operators
+	public:
+					cow_vector&				operator=(const cow_vector& other);
+					cow_vector&				operator=(cow_vector&& other) noexcept;
+
+	// iterator functions
+	public:
+		constexpr	const_iterator			cbegin() const;
+		constexpr	const_iterator			cend() const;
+
+		constexpr	const_iterator			begin() const;
+		constexpr	const_iterator			end() const;
+
+					iterator				begin();
+					iterator				end();
+
+	// helpers
+	private:
+		// sits in front of the elements, in the same allocation
+		struct control
+		{
+			std::atomic<size_t>		refs;
+		};
+
+		// whole elements reserved in front of the data for the control block
+		static constexpr size_t				header_slots	= (sizeof(control) + sizeof(T) - 1) / sizeof(T);
+
+					void					detach();
+					void					leak();
+					void					rebuild(const size_t& newCapacity);
+					void					release();
+
+					control*				allocate_block(const size_t& capacity);
+					void					free_block(control* block, const size_t& capacity);
+
+	// variables
+	private:
+					pointer_type			m_Data		= nullptr;
+					control*				m_Shared	= nullptr;
+					size_t					m_Size		= 0;
+					size_t					m_Capacity	= 0;
+					bool					m_Leaked	= false;
+					Allocator				m_Allocator{};
+	};
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr cow_vector<T, GrowthPolicy, Allocator>::cow_vector(const Allocator& allocator) : m_Allocator(allocator)
+	{ }
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline cow_vector<T, GrowthPolicy, Allocator>::cow_vector(const size_t& count, const_reference_type fillElement)
+	{
+		reserve(count);
+		for (size_t i = 0; i < count; i++)
+			new(&m_Data[i]) T(fillElement);
+
+		m_Size = count;
+	}
+
+	// shares other's buffer, unless a mutable reference into it is out
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline cow_vector<T, GrowthPolicy, Allocator>::cow_vector(const cow_vector& other) : m_Allocator(other.m_Allocator)
+	{
+		if (other.m_Leaked)
+		{
+			reserve(other.m_Size);
+			uninitialized_copy(other.m_Data, other.m_Size, m_Data);
+			m_Size = other.m_Size;
+			return;
+		}
+
+		m_Data = other.m_Data;
+		m_Shared = other.m_Shared;
+		m_Size = other.m_Size;
+		m_Capacity = other.m_Capacity;
+
+		if (m_Shared)
+			m_Shared->refs.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline cow_vector<T, GrowthPolicy, Allocator>::cow_vector(cow_vector&& other) noexcept
+		: m_Data(other.m_Data), m_Shared(other.m_Shared), m_Size(other.m_Size), m_Capacity(other.m_Capacity), m_Leaked(other.m_Leaked), m_Allocator(other.m_Allocator)
+	{
+		other.m_Data = nullptr;
+		other.m_Shared = nullptr;
+		other.m_Size = 0;
+		other.m_Capacity = 0;
+		other.m_Leaked = false;
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline cow_vector<T, GrowthPolicy, Allocator>::~cow_vector()
+	{
+		release();
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr size_t
+		cow_vector<T, GrowthPolicy, Allocator>::size() const
+	{
+		return m_Size;
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr size_t
+		cow_vector<T, GrowthPolicy, Allocator>::capacity() const
+	{
+		return m_Capacity;
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr bool
+		cow_vector<T, GrowthPolicy, Allocator>::empty() const
+	{
+		return m_Size == 0;
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline size_t
+		cow_vector<T, GrowthPolicy, Allocator>::use_count() const
+	{
+		return m_Shared ? m_Shared->refs.load(std::memory_order_acquire) : 0;
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline bool
+		cow_vector<T, GrowthPolicy, Allocator>::is_shared() const
+	{
+		return use_count() > 1;
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline bool
+		cow_vector<T, GrowthPolicy, Allocator>::is_shareable() const
+	{
+		return !m_Leaked;
+	}
+
+	// the caller promises no reference or iterator from non-const access is
+	// used any more, so copies share the buffer again
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline void
+		cow_vector<T, GrowthPolicy, Allocator>::mark_shareable()
+	{
+		m_Leaked = false;
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename cow_vector<T, GrowthPolicy, Allocator>::const_reference_type
+		cow_vector<T, GrowthPolicy, Allocator>::operator[](const size_t& index) const
+	{
+		return m_Data[index];
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename cow_vector<T, GrowthPolicy, Allocator>::const_reference_type
+		cow_vector<T, GrowthPolicy, Allocator>::at(const size_t& index) const
+	{
+		return m_Data[index];
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename cow_vector<T, GrowthPolicy, Allocator>::const_reference_type
+		cow_vector<T, GrowthPolicy, Allocator>::front() const
+	{
+		return m_Data[0];
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename cow_vector<T, GrowthPolicy, Allocator>::const_reference_type
+		cow_vector<T, GrowthPolicy, Allocator>::back() const
+	{
+		return m_Data[m_Size - 1];
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename cow_vector<T, GrowthPolicy, Allocator>::const_pointer_type
+		cow_vector<T, GrowthPolicy, Allocator>::data() const
+	{
+		return m_Data;
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename cow_vector<T, GrowthPolicy, Allocator>::const_pointer_type
+		cow_vector<T, GrowthPolicy, Allocator>::cdata() const
+	{
+		return m_Data;
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline typename cow_vector<T, GrowthPolicy, Allocator>::reference_type
+		cow_vector<T, GrowthPolicy, Allocator>::operator[](const size_t& index)
+	{
+		leak();
+		return m_Data[index];
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline typename cow_vector<T, GrowthPolicy, Allocator>::reference_type
+		cow_vector<T, GrowthPolicy, Allocator>::front()
+	{
+		leak();
+		return m_Data[0];
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline typename cow_vector<T, GrowthPolicy, Allocator>::reference_type
+		cow_vector<T, GrowthPolicy, Allocator>::back()
+	{
+		leak();
+		return m_Data[m_Size - 1];
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline typename cow_vector<T, GrowthPolicy, Allocator>::pointer_type
+		cow_vector<T, GrowthPolicy, Allocator>::data()
+	{
+		leak();
+		return m_Data;
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline typename cow_vector<T, GrowthPolicy, Allocator>::reference_type
+		cow_vector<T, GrowthPolicy, Allocator>::push_back(T&& element)
+	{
+		return emplace_back(std::move(element));
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline typename cow_vector<T, GrowthPolicy, Allocator>::reference_type
+		cow_vector<T, GrowthPolicy, Allocator>::push_back(const_reference_type element)
+	{
+		return emplace_back(element);
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	template<typename... Args>
+	inline typename cow_vector<T, GrowthPolicy, Allocator>::reference_type
+		cow_vector<T, GrowthPolicy, Allocator>::emplace_back(Args&&... args)
+	{
+		if (m_Size < m_Capacity && !is_shared())
+		{
+			new(&m_Data[m_Size]) T(std::forward<Args>(args)...);
+			return m_Data[m_Size++];
+		}
+
+		// built first so args may refer to elements of the old buffer
+		T element(std::forward<Args>(args)...);
+
+		rebuild(m_Size < m_Capacity ? m_Capacity : GrowthPolicy::next_capacity(m_Capacity, m_Size + 1, sizeof(T)));
+		new(&m_Data[m_Size]) T(std::move(element));
+
+		return m_Data[m_Size++];
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline typename cow_vector<T, GrowthPolicy, Allocator>::value_type
+		cow_vector<T, GrowthPolicy, Allocator>::pop_back()
+	{
+		if (m_Size == 0)
+			return value_type();
+
+		detach();
+
+		value_type element(std::move(m_Data[m_Size - 1]));
+		destroy(m_Data + --m_Size, 1);
+
+		return element;
+	}
+
+	// a shared buffer is left to its other owners
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline void
+		cow_vector<T, GrowthPolicy, Allocator>::clear()
+	{
+		if (is_shared())
+		{
+			release();
+			return;
+		}
+
+		destroy(m_Data, m_Size);
+		m_Size = 0;
+		m_Leaked = false;
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline void
+		cow_vector<T, GrowthPolicy, Allocator>::reserve(const size_t& size)
+	{
+		if (size > m_Capacity)
+			rebuild(size);
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline void
+		cow_vector<T, GrowthPolicy, Allocator>::resize(const size_t& size)
+	{
+		if (size == m_Size)
+			return;
+
+		detach();
+
+		if (size < m_Size)
+		{
+			destroy(m_Data + size, m_Size - size);
+			m_Size = size;
+			return;
+		}
+
+		reserve(size);
+
+		for (; m_Size < size; m_Size++)
+			new(&m_Data[m_Size]) T();
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline void
+		cow_vector<T, GrowthPolicy, Allocator>::resize(const size_t& size, const_reference_type fillElement)
+	{
+		if (size <= m_Size)
+		{
+			resize(size);
+			return;
+		}
+
+		T element(fillElement);
+		reserve(size);
+		detach();
+
+		for (; m_Size < size; m_Size++)
+			new(&m_Data[m_Size]) T(element);
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline void
+		cow_vector<T, GrowthPolicy, Allocator>::shrink_to_fit()
+	{
+		if (m_Capacity > m_Size && !is_shared())
+		{
+			if (m_Size)
+				rebuild(m_Size);
+			else
+				release();
+		}
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline void
+		cow_vector<T, GrowthPolicy, Allocator>::swap(cow_vector& other) noexcept
+	{
+		std::swap(m_Data, other.m_Data);
+		std::swap(m_Shared, other.m_Shared);
+		std::swap(m_Size, other.m_Size);
+		std::swap(m_Capacity, other.m_Capacity);
+		std::swap(m_Leaked, other.m_Leaked);
+		std::swap(m_Allocator, other.m_Allocator);
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline cow_vector<T, GrowthPolicy, Allocator>&
+		cow_vector<T, GrowthPolicy, Allocator>::operator=(const cow_vector& other)
+	{
+		cow_vector copy(other);
+		swap(copy);
+
+		return *this;
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline cow_vector<T, GrowthPolicy, Allocator>&
+		cow_vector<T, GrowthPolicy, Allocator>::operator=(cow_vector&& other) noexcept
+	{
+		cow_vector moved(std::move(other));
+		swap(moved);
+
+		return *this;
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename cow_vector<T, GrowthPolicy, Allocator>::const_iterator
+		cow_vector<T, GrowthPolicy, Allocator>::cbegin() const
+	{
+		return const_iterator(m_Data);
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename cow_vector<T, GrowthPolicy, Allocator>::const_iterator
+		cow_vector<T, GrowthPolicy, Allocator>::cend() const
+	{
+		return const_iterator(m_Data + m_Size);
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename cow_vector<T, GrowthPolicy, Allocator>::const_iterator
+		cow_vector<T, GrowthPolicy, Allocator>::begin() const
+	{
+		return cbegin();
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename cow_vector<T, GrowthPolicy, Allocator>::const_iterator
+		cow_vector<T, GrowthPolicy, Allocator>::end() const
+	{
+		return cend();
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline typename cow_vector<T, GrowthPolicy, Allocator>::iterator
+		cow_vector<T, GrowthPolicy, Allocator>::begin()
+	{
+		leak();
+		return iterator(m_Data);
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline typename cow_vector<T, GrowthPolicy, Allocator>::iterator
+		cow_vector<T, GrowthPolicy, Allocator>::end()
+	{
+		leak();
+		return iterator(m_Data + m_Size);
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline void
+		cow_vector<T, GrowthPolicy, Allocator>::detach()
+	{
+		if (is_shared())
+			rebuild(m_Capacity);
+	}
+
+	// detaches and remembers that a mutable reference into the buffer is out
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline void
+		cow_vector<T, GrowthPolicy, Allocator>::leak()
+	{
+		detach();
+		m_Leaked = true;
+	}
+
+	// moves the elements to a new block of newCapacity. a sole owner relocates
+	// them like vector::realloc, a shared buffer is copied and left to the
+	// other owners
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline void
+		cow_vector<T, GrowthPolicy, Allocator>::rebuild(const size_t& newCapacity)
+	{
+		// newCapacity may alias m_Capacity, which release() resets
+		const size_t capacity = newCapacity;
+		const size_t size = m_Size;
+
+		control* block = allocate_block(capacity);
+		pointer_type data = reinterpret_cast<pointer_type>(block) + header_slots;
+
+		if (!is_shared())
+		{
+			relocate(data, m_Data, m_Size);
+
+			if (m_Shared)
+				free_block(m_Shared, m_Capacity);
+		}
+		else if constexpr (std::is_nothrow_copy_constructible_v<T>)
+		{
+			uninitialized_copy(m_Data, m_Size, data);
+			release();
+		}
+		else
+		{
+			size_t built = 0;
+
+			try
+			{
+				for (; built < m_Size; built++)
+					new(&data[built]) T(m_Data[built]);
+			}
+			catch (...)
+			{
+				destroy(data, built);
+				free_block(block, capacity);
+				throw;
+			}
+
+			// the other owners may drop the old block meanwhile, so this
+			// owner's reference goes through release() like any other
+			release();
+		}
+
+		m_Shared = block;
+		m_Data = data;
+		m_Size = size;
+		m_Capacity = capacity;
+		m_Leaked = false;
+	}
+
+	// drops this owner. the last one destroys the elements and frees the block
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline void
+		cow_vector<T, GrowthPolicy, Allocator>::release()
+	{
+		if (m_Shared && m_Shared->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			destroy(m_Data, m_Size);
+			free_block(m_Shared, m_Capacity);
+		}
+
+		m_Data = nullptr;
+		m_Shared = nullptr;
+		m_Size = 0;
+		m_Capacity = 0;
+		m_Leaked = false;
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline typename cow_vector<T, GrowthPolicy, Allocator>::control*
+		cow_vector<T, GrowthPolicy, Allocator>::allocate_block(const size_t& capacity)
+	{
+		pointer_type block = m_Allocator.allocate(header_slots + capacity);
+		return new(static_cast<void*>(block)) control{ 1 };
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline void
+		cow_vector<T, GrowthPolicy, Allocator>::free_block(control* block, const size_t& capacity)
+	{
+		block->~control();
+		m_Allocator.deallocate(reinterpret_cast<pointer_type>(block), header_slots + capacity);
+	}
+}
+
+#endif
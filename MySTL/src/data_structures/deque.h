@@ -16,12 +16,13 @@
 
 namespace mystl
 {
-	template<typename T>
+	template<typename T, class Allocator = allocator<T>>
 	class deque
 	{
 	// typedefs
 	public:
 		using		value_type				= T;
+		using		allocator_type			= Allocator;
 
 		using		reference_type			= T&;
 		using		pointer_type			= T*;
@@ -29,8 +30,8 @@ namespace mystl
 		using		const_reference_type	= const T&;
 		using		const_pointer_type		= const T*;
 
-		using		const_iterator			= list_const_iterator<list<T>>;
-		using		iterator				= list_iterator<list<T>>;
+		using		const_iterator			= list_const_iterator<list<T, Allocator>>;
+		using		iterator				= list_iterator<list<T, Allocator>>;
 
 		using		const_reverse_iterator	= list_const_reverse_iterator<const_iterator>;
 		using		reverse_iterator		= list_reverse_iterator<iterator>;
@@ -39,7 +40,10 @@ namespace mystl
 	public:
 		constexpr							deque();
 		constexpr							deque(const size_t& size);
+		constexpr	explicit				deque(const Allocator& allocator);
 		constexpr							deque(const size_t& size, const_reference_type fillElement);
+		constexpr							deque(const deque& other) = default;
+		constexpr							deque(deque&& other) noexcept = default;
 
 	// element access
 	public:
@@ -72,6 +76,15 @@ namespace mystl
 		constexpr	value_type				pop_front();
 		constexpr	value_type				pop_back();
 
+	// mutator functions
+	public:
+					void					swap(deque& other);
+
+	// operators
+	public:
+		constexpr	deque&					operator=(const deque& other) = default;
+		constexpr	deque&					operator=(deque&& other) noexcept = default;
+
 	// iterator functions
 	public:
 		constexpr	const_iterator			cbegin() const;
@@ -88,187 +101,200 @@ namespace mystl
 
 	// variables
 	private:
-					list<T>					m_Data;
+					list<T, Allocator>		m_Data;
 	};
 
-	template<typename T>
-	constexpr deque<T>::deque() : m_Data()
+	template<typename T, class Allocator>
+	constexpr deque<T, Allocator>::deque() : m_Data()
+	{
+
+	}
+
+	template<typename T, class Allocator>
+	constexpr deque<T, Allocator>::deque(const size_t& size) : m_Data(size)
 	{
 
 	}
 
-	template<typename T>
-	constexpr deque<T>::deque(const size_t& size) : m_Data(size)
+	template<typename T, class Allocator>
+	constexpr deque<T, Allocator>::deque(const Allocator& allocator) : m_Data(allocator)
 	{
 
 	}
 
-	template<typename T>
-	constexpr deque<T>::deque(const size_t& size, const_reference_type fillElement) : m_Data(size, fillElement)
+	template<typename T, class Allocator>
+	constexpr deque<T, Allocator>::deque(const size_t& size, const_reference_type fillElement) : m_Data(size, fillElement)
 	{
 
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	constexpr bool 
-		deque<T>::empty() const
+		deque<T, Allocator>::empty() const
 	{
 		return m_Data.empty();
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	constexpr size_t 
-		deque<T>::size() const
+		deque<T, Allocator>::size() const
 	{
 		return m_Data.size();
 	}
 
-	template<typename T>
-	constexpr typename deque<T>::reference_type 
-		deque<T>::operator[](const size_t& offset)
+	template<typename T, class Allocator>
+	constexpr typename deque<T, Allocator>::reference_type 
+		deque<T, Allocator>::operator[](const size_t& offset)
 	{
 		return m_Data[offset];
 	}
 
-	template<typename T>
-	constexpr typename deque<T>::reference_type 
-		deque<T>::front()
+	template<typename T, class Allocator>
+	constexpr typename deque<T, Allocator>::reference_type 
+		deque<T, Allocator>::front()
 	{
 		return m_Data.front();
 	}
 
-	template<typename T>
-	constexpr typename deque<T>::reference_type 
-		deque<T>::back()
+	template<typename T, class Allocator>
+	constexpr typename deque<T, Allocator>::reference_type 
+		deque<T, Allocator>::back()
 	{
 		return m_Data.back();
 	}
 
-	template<typename T>
-	constexpr typename deque<T>::const_reference_type 
-		deque<T>::front() const
+	template<typename T, class Allocator>
+	constexpr typename deque<T, Allocator>::const_reference_type 
+		deque<T, Allocator>::front() const
 	{
 		return m_Data.front();
 	}
 
-	template<typename T>
-	constexpr typename deque<T>::const_reference_type 
-		deque<T>::back() const
+	template<typename T, class Allocator>
+	constexpr typename deque<T, Allocator>::const_reference_type 
+		deque<T, Allocator>::back() const
 	{
 		return m_Data.back();
 	}
 
-	template<typename T>
-	constexpr typename deque<T>::reference_type 
-		deque<T>::push_front(T&& element)
+	template<typename T, class Allocator>
+	constexpr typename deque<T, Allocator>::reference_type 
+		deque<T, Allocator>::push_front(T&& element)
 	{
-		return m_Data.emplace_front(element);
+		return m_Data.emplace_front(std::move(element));
 	}
 
-	template<typename T>
-	constexpr typename deque<T>::reference_type 
-		deque<T>::push_front(const_reference_type element)
+	template<typename T, class Allocator>
+	constexpr typename deque<T, Allocator>::reference_type 
+		deque<T, Allocator>::push_front(const_reference_type element)
 	{
 		return m_Data.emplace_front(element);
 	}
 
-	template<typename T>
-	constexpr typename deque<T>::reference_type 
-		deque<T>::push_back(T&& element)
+	template<typename T, class Allocator>
+	constexpr typename deque<T, Allocator>::reference_type 
+		deque<T, Allocator>::push_back(T&& element)
 	{
-		return m_Data.emplace_back(element);
+		return m_Data.emplace_back(std::move(element));
 	}
 	
-	template<typename T>
-	constexpr typename deque<T>::reference_type 
-		deque<T>::push_back(const_reference_type element)
+	template<typename T, class Allocator>
+	constexpr typename deque<T, Allocator>::reference_type 
+		deque<T, Allocator>::push_back(const_reference_type element)
 	{
 		return m_Data.emplace_back(element);
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	template<typename ...Args>
-	constexpr typename deque<T>::reference_type deque<T>::emplace_front(Args && ...args)
+	constexpr typename deque<T, Allocator>::reference_type deque<T, Allocator>::emplace_front(Args && ...args)
 	{
 		return m_Data.emplace_front(std::forward<Args>(args)...);
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	template<typename ...Args>
-	constexpr typename deque<T>::reference_type deque<T>::emplace_back(Args && ...args)
+	constexpr typename deque<T, Allocator>::reference_type deque<T, Allocator>::emplace_back(Args && ...args)
 	{
 		return m_Data.emplace_back(std::forward<Args>(args)...);
 	}
 
-	template<typename T>
-	constexpr typename deque<T>::value_type 
-		deque<T>::pop_front()
+	template<typename T, class Allocator>
+	constexpr typename deque<T, Allocator>::value_type 
+		deque<T, Allocator>::pop_front()
 	{
 		return m_Data.pop_front();
 	}
 
-	template<typename T>
-	constexpr typename deque<T>::value_type 
-		deque<T>::pop_back()
+	template<typename T, class Allocator>
+	constexpr typename deque<T, Allocator>::value_type 
+		deque<T, Allocator>::pop_back()
 	{
 		return m_Data.pop_back();
 	}
 
-	template<typename T>
-	constexpr typename deque<T>::const_iterator 
-		deque<T>::cbegin() const
+	template<typename T, class Allocator>
+	constexpr typename deque<T, Allocator>::const_iterator 
+		deque<T, Allocator>::cbegin() const
 	{
 		return m_Data.cbegin();
 	}
 
-	template<typename T>
-	constexpr typename deque<T>::const_iterator 
-		deque<T>::cend() const
+	template<typename T, class Allocator>
+	constexpr typename deque<T, Allocator>::const_iterator 
+		deque<T, Allocator>::cend() const
 	{
 		return m_Data.cend();
 	}
 
-	template<typename T>
-	constexpr typename deque<T>::iterator 
-		deque<T>::begin()
+	template<typename T, class Allocator>
+	constexpr typename deque<T, Allocator>::iterator 
+		deque<T, Allocator>::begin()
 	{
 		return m_Data.begin();
 	}
 
-	template<typename T>
-	constexpr typename deque<T>::iterator 
-		deque<T>::end()
+	template<typename T, class Allocator>
+	constexpr typename deque<T, Allocator>::iterator 
+		deque<T, Allocator>::end()
 	{
 		return m_Data.end();
 	}
 
-	template<typename T>
-	constexpr typename deque<T>::const_reverse_iterator 
-		deque<T>::crbegin() const
+	template<typename T, class Allocator>
+	constexpr typename deque<T, Allocator>::const_reverse_iterator 
+		deque<T, Allocator>::crbegin() const
 	{
 		return m_Data.crbegin();
 	}
 
-	template<typename T>
-	constexpr typename deque<T>::const_reverse_iterator 
-		deque<T>::crend() const
+	template<typename T, class Allocator>
+	constexpr typename deque<T, Allocator>::const_reverse_iterator 
+		deque<T, Allocator>::crend() const
 	{
 		return m_Data.crend();
 	}
 
-	template<typename T>
-	constexpr typename deque<T>::reverse_iterator 
-		deque<T>::rbegin()
+	template<typename T, class Allocator>
+	constexpr typename deque<T, Allocator>::reverse_iterator 
+		deque<T, Allocator>::rbegin()
 	{
 		return m_Data.rbegin();
 	}
 
-	template<typename T>
-	constexpr typename deque<T>::reverse_iterator 
-		deque<T>::rend()
+	template<typename T, class Allocator>
+	constexpr typename deque<T, Allocator>::reverse_iterator 
+		deque<T, Allocator>::rend()
 	{
 		return m_Data.rend();
 	}
+
+	template<typename T, class Allocator>
+	inline void
+		deque<T, Allocator>::swap(deque& other)
+	{
+		m_Data.swap(other.m_Data);
+	}
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,651 @@
+#ifndef DYNAMIC_BITSET_H
+#define DYNAMIC_BITSET_H
+
+#include <assert.h>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include "allocator.h"
+#include "growth_policy.h"
+#include "../algorithms/simd_bits.h"
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// dynamic_bitset																	///
+///																					///
+/// This class is a resizable sequence of bits packed into 64 bit words, one		///
+/// bit per flag instead of the byte a vector<bool> spends. Whole-set work runs		///
+/// a word (or an avx2 register of four words) at a time through the kernels in		///
+/// simd_bits.h: count() is a popcount, find_first()/find_next() skip empty			///
+/// words and count trailing zeros, and the bulk &, |, ^, ~ and shifts never		///
+/// touch single bits. The bits past size() in the last word are kept zero, so		///
+/// none of these need a special case for the tail.									///
+///																					///
+///////////////////////////////////////////////////////////////////////////////////////
+
+namespace mystl
+{
+	template<class GrowthPolicy = growth::standard, class Allocator = allocator<uint64_t>>
+	class dynamic_bitset
+	{
+	// typedefs
+	public:
+		using		word_type				= uint64_t;
+		using		allocator_type			= rebind_allocator<Allocator, word_type>;
+
+		static constexpr size_t				bits_per_word	= 64;
+		static constexpr size_t				npos			= (size_t)-1;
+
+	// constructor/destructor
+	public:
+		constexpr							dynamic_bitset() = default;
+		constexpr	explicit				dynamic_bitset(const Allocator& allocator);
+					explicit				dynamic_bitset(const size_t& size, const bool& value = false);
+											dynamic_bitset(const dynamic_bitset& other);
+											dynamic_bitset(dynamic_bitset&& other) noexcept;
+											~dynamic_bitset();
+
+	// size functions
+	public:
+		constexpr	size_t					size() const;
+		constexpr	size_t					capacity() const;
+		constexpr	size_t					num_words() const;
+		constexpr	bool					empty() const;
+
+	// bit access functions
+	public:
+		constexpr	bool					test(const size_t& index) const;
+		constexpr	bool					operator[](const size_t& index) const;
+
+		// the packed words, bits past size() are zero
+		constexpr	const word_type*		data() const;
+
+	// search functions
+	public:
+					size_t					count() const;
+					bool					any() const;
+					bool					none() const;
+					bool					all() const;
+
+		// index of the first set bit (after index), npos if there is none
+					size_t					find_first() const;
+					size_t					find_next(const size_t& index) const;
+
+	// mutator functions
+	public:
+		constexpr	dynamic_bitset&			set(const size_t& index, const bool& value = true);
+		constexpr	dynamic_bitset&			reset(const size_t& index);
+		constexpr	dynamic_bitset&			flip(const size_t& index);
+
+		// every bit at once
+					dynamic_bitset&			set();
+					dynamic_bitset&			reset();
+					dynamic_bitset&			flip();
+
+					void					push_back(const bool& value);
+					void					pop_back();
+
+					void					clear();
+					void					reserve(const size_t& size);
+					void					resize(const size_t& size, const bool& value = false);
+					void					swap(dynamic_bitset& other) noexcept;
+
+	// operators. both sides of &, |, ^ must have the same size
+	public:
+					dynamic_bitset&			operator&=(const dynamic_bitset& other);
+					dynamic_bitset&			operator|=(const dynamic_bitset& other);
+					dynamic_bitset&			operator^=(const dynamic_bitset& other);
+
+		// shifts move bit i to i + count (<<) or i - count (>>) like std::bitset,
+		// the size stays the same
+					dynamic_bitset&			operator<<=(const size_t& count);
+					dynamic_bitset&			operator>>=(const size_t& count);
+
+					dynamic_bitset			operator~() const;
+					dynamic_bitset			operator<<(const size_t& count) const;
+					dynamic_bitset			operator>>(const size_t& count) const;
+
+					bool					operator==(const dynamic_bitset& other) const;
+					bool					operator!=(const dynamic_bitset& other) const;
+
+					dynamic_bitset&			operator=(const dynamic_bitset& other);
+					dynamic_bitset&			operator=(dynamic_bitset&& other) noexcept;
+
+	// helpers
+	private:
+		static constexpr size_t				words_for(const size_t& bits);
+
+					void					clear_tail();
+					void					realloc(const size_t& newCapacity);
+					size_t					scan_from(const size_t& word) const;
+
+	// variables
+	private:
+					word_type*				m_Words		= nullptr;
+					size_t					m_Size		= 0;
+					size_t					m_Capacity	= 0;
+					allocator_type			m_Allocator{};
+	};
+
+	template<class GrowthPolicy, class Allocator>
+	constexpr dynamic_bitset<GrowthPolicy, Allocator>::dynamic_bitset(const Allocator& allocator) : m_Allocator(allocator)
+	{ }
+
+	template<class GrowthPolicy, class Allocator>
+	inline dynamic_bitset<GrowthPolicy, Allocator>::dynamic_bitset(const size_t& size, const bool& value)
+	{
+		resize(size, value);
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline dynamic_bitset<GrowthPolicy, Allocator>::dynamic_bitset(const dynamic_bitset& other) : m_Allocator(other.m_Allocator)
+	{
+		reserve(other.m_Size);
+
+		if (other.m_Size)
+			std::memcpy(m_Words, other.m_Words, other.num_words() * sizeof(word_type));
+
+		m_Size = other.m_Size;
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline dynamic_bitset<GrowthPolicy, Allocator>::dynamic_bitset(dynamic_bitset&& other) noexcept
+		: m_Words(other.m_Words), m_Size(other.m_Size), m_Capacity(other.m_Capacity), m_Allocator(other.m_Allocator)
+	{
+		other.m_Words = nullptr;
+		other.m_Size = 0;
+		other.m_Capacity = 0;
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline dynamic_bitset<GrowthPolicy, Allocator>::~dynamic_bitset()
+	{
+		if (m_Words)
+			m_Allocator.deallocate(m_Words, m_Capacity);
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	constexpr size_t
+		dynamic_bitset<GrowthPolicy, Allocator>::size() const
+	{
+		return m_Size;
+	}
+
+	// in bits
+	template<class GrowthPolicy, class Allocator>
+	constexpr size_t
+		dynamic_bitset<GrowthPolicy, Allocator>::capacity() const
+	{
+		return m_Capacity * bits_per_word;
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	constexpr size_t
+		dynamic_bitset<GrowthPolicy, Allocator>::num_words() const
+	{
+		return words_for(m_Size);
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	constexpr bool
+		dynamic_bitset<GrowthPolicy, Allocator>::empty() const
+	{
+		return m_Size == 0;
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	constexpr bool
+		dynamic_bitset<GrowthPolicy, Allocator>::test(const size_t& index) const
+	{
+		return (m_Words[index / bits_per_word] >> (index % bits_per_word)) & 1;
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	constexpr bool
+		dynamic_bitset<GrowthPolicy, Allocator>::operator[](const size_t& index) const
+	{
+		return test(index);
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	constexpr const typename dynamic_bitset<GrowthPolicy, Allocator>::word_type*
+		dynamic_bitset<GrowthPolicy, Allocator>::data() const
+	{
+		return m_Words;
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline size_t
+		dynamic_bitset<GrowthPolicy, Allocator>::count() const
+	{
+		return simd::popcount(m_Words, num_words());
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline bool
+		dynamic_bitset<GrowthPolicy, Allocator>::any() const
+	{
+		return simd::find_nonzero(m_Words, num_words()) != num_words();
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline bool
+		dynamic_bitset<GrowthPolicy, Allocator>::none() const
+	{
+		return !any();
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline bool
+		dynamic_bitset<GrowthPolicy, Allocator>::all() const
+	{
+		return count() == m_Size;
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline size_t
+		dynamic_bitset<GrowthPolicy, Allocator>::find_first() const
+	{
+		return scan_from(0);
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline size_t
+		dynamic_bitset<GrowthPolicy, Allocator>::find_next(const size_t& index) const
+	{
+		size_t next = index + 1;
+		if (next >= m_Size)
+			return npos;
+
+		// the rest of index's own word first, then whole words
+		size_t word = next / bits_per_word;
+		word_type bits = m_Words[word] & (~word_type(0) << (next % bits_per_word));
+
+		if (bits)
+			return word * bits_per_word + (size_t)std::countr_zero(bits);
+
+		return scan_from(word + 1);
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	constexpr dynamic_bitset<GrowthPolicy, Allocator>&
+		dynamic_bitset<GrowthPolicy, Allocator>::set(const size_t& index, const bool& value)
+	{
+		word_type mask = word_type(1) << (index % bits_per_word);
+
+		if (value)
+			m_Words[index / bits_per_word] |= mask;
+		else
+			m_Words[index / bits_per_word] &= ~mask;
+
+		return *this;
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	constexpr dynamic_bitset<GrowthPolicy, Allocator>&
+		dynamic_bitset<GrowthPolicy, Allocator>::reset(const size_t& index)
+	{
+		return set(index, false);
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	constexpr dynamic_bitset<GrowthPolicy, Allocator>&
+		dynamic_bitset<GrowthPolicy, Allocator>::flip(const size_t& index)
+	{
+		m_Words[index / bits_per_word] ^= word_type(1) << (index % bits_per_word);
+		return *this;
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline dynamic_bitset<GrowthPolicy, Allocator>&
+		dynamic_bitset<GrowthPolicy, Allocator>::set()
+	{
+		if (m_Size)
+			std::memset(m_Words, 0xff, num_words() * sizeof(word_type));
+
+		clear_tail();
+		return *this;
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline dynamic_bitset<GrowthPolicy, Allocator>&
+		dynamic_bitset<GrowthPolicy, Allocator>::reset()
+	{
+		if (m_Size)
+			std::memset(m_Words, 0, num_words() * sizeof(word_type));
+
+		return *this;
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline dynamic_bitset<GrowthPolicy, Allocator>&
+		dynamic_bitset<GrowthPolicy, Allocator>::flip()
+	{
+		simd::bit_not(m_Words, num_words());
+
+		clear_tail();
+		return *this;
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline void
+		dynamic_bitset<GrowthPolicy, Allocator>::push_back(const bool& value)
+	{
+		if (m_Size == capacity())
+			realloc(GrowthPolicy::next_capacity(m_Capacity, m_Capacity + 1, sizeof(word_type)));
+
+		// a word is zeroed when the first bit lands in it
+		if (m_Size % bits_per_word == 0)
+			m_Words[m_Size / bits_per_word] = 0;
+
+		set(m_Size++, value);
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline void
+		dynamic_bitset<GrowthPolicy, Allocator>::pop_back()
+	{
+		if (m_Size == 0)
+			return;
+
+		reset(--m_Size);
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline void
+		dynamic_bitset<GrowthPolicy, Allocator>::clear()
+	{
+		m_Size = 0;
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline void
+		dynamic_bitset<GrowthPolicy, Allocator>::reserve(const size_t& size)
+	{
+		if (words_for(size) > m_Capacity)
+			realloc(words_for(size));
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline void
+		dynamic_bitset<GrowthPolicy, Allocator>::resize(const size_t& size, const bool& value)
+	{
+		if (size <= m_Size)
+		{
+			m_Size = size;
+			clear_tail();
+			return;
+		}
+
+		if (words_for(size) > m_Capacity)
+			realloc(GrowthPolicy::next_capacity(m_Capacity, words_for(size), sizeof(word_type)));
+
+		size_t first = num_words();
+
+		// the tail of the current last word is zero already
+		if (value && m_Size % bits_per_word)
+			m_Words[m_Size / bits_per_word] |= ~word_type(0) << (m_Size % bits_per_word);
+
+		std::memset(m_Words + first, value ? 0xff : 0, (words_for(size) - first) * sizeof(word_type));
+
+		m_Size = size;
+		clear_tail();
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline void
+		dynamic_bitset<GrowthPolicy, Allocator>::swap(dynamic_bitset& other) noexcept
+	{
+		std::swap(m_Words, other.m_Words);
+		std::swap(m_Size, other.m_Size);
+		std::swap(m_Capacity, other.m_Capacity);
+		std::swap(m_Allocator, other.m_Allocator);
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline dynamic_bitset<GrowthPolicy, Allocator>&
+		dynamic_bitset<GrowthPolicy, Allocator>::operator&=(const dynamic_bitset& other)
+	{
+		assert("dynamic_bitset sizes differ" && m_Size == other.m_Size);
+
+		simd::bit_and(m_Words, other.m_Words, num_words());
+		return *this;
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline dynamic_bitset<GrowthPolicy, Allocator>&
+		dynamic_bitset<GrowthPolicy, Allocator>::operator|=(const dynamic_bitset& other)
+	{
+		assert("dynamic_bitset sizes differ" && m_Size == other.m_Size);
+
+		simd::bit_or(m_Words, other.m_Words, num_words());
+		return *this;
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline dynamic_bitset<GrowthPolicy, Allocator>&
+		dynamic_bitset<GrowthPolicy, Allocator>::operator^=(const dynamic_bitset& other)
+	{
+		assert("dynamic_bitset sizes differ" && m_Size == other.m_Size);
+
+		simd::bit_xor(m_Words, other.m_Words, num_words());
+		return *this;
+	}
+
+	// word i takes the bits of words i - shift and i - shift - 1, walking down
+	// so no source word is overwritten before it is read
+	template<class GrowthPolicy, class Allocator>
+	inline dynamic_bitset<GrowthPolicy, Allocator>&
+		dynamic_bitset<GrowthPolicy, Allocator>::operator<<=(const size_t& count)
+	{
+		if (count >= m_Size)
+			return reset();
+
+		const size_t words = num_words();
+		const size_t shift = count / bits_per_word;
+		const size_t offset = count % bits_per_word;
+
+		if (offset == 0)
+		{
+			for (size_t i = words; i-- > shift;)
+				m_Words[i] = m_Words[i - shift];
+		}
+		else
+		{
+			for (size_t i = words - 1; i > shift; i--)
+				m_Words[i] = (m_Words[i - shift] << offset) | (m_Words[i - shift - 1] >> (bits_per_word - offset));
+
+			m_Words[shift] = m_Words[0] << offset;
+		}
+
+		std::memset(m_Words, 0, shift * sizeof(word_type));
+
+		clear_tail();
+		return *this;
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline dynamic_bitset<GrowthPolicy, Allocator>&
+		dynamic_bitset<GrowthPolicy, Allocator>::operator>>=(const size_t& count)
+	{
+		if (count >= m_Size)
+			return reset();
+
+		const size_t words = num_words();
+		const size_t shift = count / bits_per_word;
+		const size_t offset = count % bits_per_word;
+		const size_t last = words - shift - 1;
+
+		if (offset == 0)
+		{
+			for (size_t i = 0; i <= last; i++)
+				m_Words[i] = m_Words[i + shift];
+		}
+		else
+		{
+			for (size_t i = 0; i < last; i++)
+				m_Words[i] = (m_Words[i + shift] >> offset) | (m_Words[i + shift + 1] << (bits_per_word - offset));
+
+			m_Words[last] = m_Words[words - 1] >> offset;
+		}
+
+		std::memset(m_Words + last + 1, 0, shift * sizeof(word_type));
+
+		return *this;
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline dynamic_bitset<GrowthPolicy, Allocator>
+		dynamic_bitset<GrowthPolicy, Allocator>::operator~() const
+	{
+		dynamic_bitset result(*this);
+		result.flip();
+
+		return result;
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline dynamic_bitset<GrowthPolicy, Allocator>
+		dynamic_bitset<GrowthPolicy, Allocator>::operator<<(const size_t& count) const
+	{
+		dynamic_bitset result(*this);
+		result <<= count;
+
+		return result;
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline dynamic_bitset<GrowthPolicy, Allocator>
+		dynamic_bitset<GrowthPolicy, Allocator>::operator>>(const size_t& count) const
+	{
+		dynamic_bitset result(*this);
+		result >>= count;
+
+		return result;
+	}
+
+	// the zero tail lets whole words be compared
+	template<class GrowthPolicy, class Allocator>
+	inline bool
+		dynamic_bitset<GrowthPolicy, Allocator>::operator==(const dynamic_bitset& other) const
+	{
+		if (m_Size != other.m_Size)
+			return false;
+
+		return m_Size == 0 || std::memcmp(m_Words, other.m_Words, num_words() * sizeof(word_type)) == 0;
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline bool
+		dynamic_bitset<GrowthPolicy, Allocator>::operator!=(const dynamic_bitset& other) const
+	{
+		return !(*this == other);
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline dynamic_bitset<GrowthPolicy, Allocator>&
+		dynamic_bitset<GrowthPolicy, Allocator>::operator=(const dynamic_bitset& other)
+	{
+		if (this == &other)
+			return *this;
+
+		dynamic_bitset copy(other);
+		swap(copy);
+
+		return *this;
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline dynamic_bitset<GrowthPolicy, Allocator>&
+		dynamic_bitset<GrowthPolicy, Allocator>::operator=(dynamic_bitset&& other) noexcept
+	{
+		dynamic_bitset moved(std::move(other));
+		swap(moved);
+
+		return *this;
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	constexpr size_t
+		dynamic_bitset<GrowthPolicy, Allocator>::words_for(const size_t& bits)
+	{
+		return (bits + bits_per_word - 1) / bits_per_word;
+	}
+
+	// zeroes the bits past size() in the last word
+	template<class GrowthPolicy, class Allocator>
+	inline void
+		dynamic_bitset<GrowthPolicy, Allocator>::clear_tail()
+	{
+		if (m_Size % bits_per_word)
+			m_Words[m_Size / bits_per_word] &= (word_type(1) << (m_Size % bits_per_word)) - 1;
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline void
+		dynamic_bitset<GrowthPolicy, Allocator>::realloc(const size_t& newCapacity)
+	{
+		word_type* newBlock = m_Allocator.allocate(newCapacity);
+
+		if (m_Words)
+		{
+			if (m_Size)
+				std::memcpy(newBlock, m_Words, num_words() * sizeof(word_type));
+
+			m_Allocator.deallocate(m_Words, m_Capacity);
+		}
+
+		m_Words = newBlock;
+		m_Capacity = newCapacity;
+	}
+
+	// index of the first set bit in words word and up
+	template<class GrowthPolicy, class Allocator>
+	inline size_t
+		dynamic_bitset<GrowthPolicy, Allocator>::scan_from(const size_t& word) const
+	{
+		const size_t words = num_words();
+		if (word >= words)
+			return npos;
+
+		size_t found = word + simd::find_nonzero(m_Words + word, words - word);
+		if (found == words)
+			return npos;
+
+		return found * bits_per_word + (size_t)std::countr_zero(m_Words[found]);
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline dynamic_bitset<GrowthPolicy, Allocator>
+		operator&(const dynamic_bitset<GrowthPolicy, Allocator>& left, const dynamic_bitset<GrowthPolicy, Allocator>& right)
+	{
+		dynamic_bitset<GrowthPolicy, Allocator> result(left);
+		result &= right;
+
+		return result;
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline dynamic_bitset<GrowthPolicy, Allocator>
+		operator|(const dynamic_bitset<GrowthPolicy, Allocator>& left, const dynamic_bitset<GrowthPolicy, Allocator>& right)
+	{
+		dynamic_bitset<GrowthPolicy, Allocator> result(left);
+		result |= right;
+
+		return result;
+	}
+
+	template<class GrowthPolicy, class Allocator>
+	inline dynamic_bitset<GrowthPolicy, Allocator>
+		operator^(const dynamic_bitset<GrowthPolicy, Allocator>& left, const dynamic_bitset<GrowthPolicy, Allocator>& right)
+	{
+		dynamic_bitset<GrowthPolicy, Allocator> result(left);
+		result ^= right;
+
+		return result;
+	}
+}
+
+#endif
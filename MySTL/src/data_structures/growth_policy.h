@@ -0,0 +1,134 @@
+#ifndef GROWTH_POLICY_H
+#define GROWTH_POLICY_H
+
+#include <cstddef>
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// growth_policy																	///
+///																					///
+/// This file holds the growth policies used by vector. A growth policy decides		///
+/// the next capacity once the vector is full. Policies are passed as a template	///
+/// argument, so the default ones cost nothing at runtime. Wrapping a policy in		///
+/// growth::instrumented records how many reallocations happened and how many		///
+/// bytes were moved, which can be read back through vector::growth_policy().		///
+///																					///
+///////////////////////////////////////////////////////////////////////////////////////
+
+// every policy provides:
+//	static constexpr size_t	next_capacity(capacity, required, elementSize)
+//		returns a capacity >= required
+//	constexpr void			reallocated(oldCapacity, newCapacity, bytesMoved)
+//		called by the vector after every reallocation of a live block
+namespace mystl::growth
+{
+	// shared helper: never hand back less than what was asked for
+	constexpr size_t at_least(const size_t& capacity, const size_t& required)
+	{
+		return capacity < required ? required : capacity;
+	}
+
+	// grows by 1.5x
+	struct factor_1_5
+	{
+		static constexpr size_t next_capacity(const size_t& capacity, const size_t& required, const size_t&)
+		{
+			return at_least(capacity + (capacity >> 1), required);
+		}
+
+		constexpr void reallocated(const size_t&, const size_t&, const size_t&) { }
+	};
+
+	// grows by 2x
+	struct factor_2
+	{
+		static constexpr size_t next_capacity(const size_t& capacity, const size_t& required, const size_t&)
+		{
+			return at_least(capacity << 1, required);
+		}
+
+		constexpr void reallocated(const size_t&, const size_t&, const size_t&) { }
+	};
+
+	// doubles while the vector is small (size < 10), then grows by 1.5x
+	struct standard
+	{
+		static constexpr size_t next_capacity(const size_t& capacity, const size_t& required, const size_t& elementSize)
+		{
+			return capacity < 10
+				? factor_2::next_capacity(capacity, required, elementSize)
+				: factor_1_5::next_capacity(capacity, required, elementSize);
+		}
+
+		constexpr void reallocated(const size_t&, const size_t&, const size_t&) { }
+	};
+
+	// rounds the capacity up to the next power of two
+	struct power_of_two
+	{
+		static constexpr size_t next_capacity(const size_t& capacity, const size_t& required, const size_t&)
+		{
+			size_t target = at_least(capacity + 1, required);
+			size_t power = 1;
+
+			while (power < target)
+				power <<= 1;
+
+			return power;
+		}
+
+		constexpr void reallocated(const size_t&, const size_t&, const size_t&) { }
+	};
+
+	// behaves like standard until the block reaches PageSize bytes, then grows
+	// by 1.5x and rounds the block size up to a whole number of pages so the
+	// allocator can hand back page (or huge page) aligned mappings
+	template<size_t PageSize = 4096>
+	struct page_aligned
+	{
+		static_assert(PageSize && !(PageSize & (PageSize - 1)), "page size must be a power of two");
+
+		static constexpr size_t next_capacity(const size_t& capacity, const size_t& required, const size_t& elementSize)
+		{
+			size_t target = standard::next_capacity(capacity, required, elementSize);
+
+			if (target * elementSize < PageSize)
+				return target;
+
+			size_t bytes = factor_1_5::next_capacity(capacity, required, elementSize) * elementSize;
+			bytes = (bytes + PageSize - 1) & ~(PageSize - 1);
+
+			return at_least(bytes / elementSize, required);
+		}
+
+		constexpr void reallocated(const size_t&, const size_t&, const size_t&) { }
+	};
+
+	using huge_page_aligned = page_aligned<size_t(2) << 20>;
+
+	// wraps any policy and counts what the vector did with it
+	template<class Policy = standard>
+	struct instrumented
+	{
+		static constexpr size_t next_capacity(const size_t& capacity, const size_t& required, const size_t& elementSize)
+		{
+			return Policy::next_capacity(capacity, required, elementSize);
+		}
+
+		constexpr void reallocated(const size_t& oldCapacity, const size_t& newCapacity, const size_t& bytesMoved)
+		{
+			m_Reallocations++;
+			m_BytesMoved += bytesMoved;
+			m_Policy.reallocated(oldCapacity, newCapacity, bytesMoved);
+		}
+
+		constexpr size_t reallocations() const { return m_Reallocations; }
+		constexpr size_t bytes_moved() const { return m_BytesMoved; }
+		constexpr void reset() { m_Reallocations = 0; m_BytesMoved = 0; }
+
+		size_t	m_Reallocations	= 0;
+		size_t	m_BytesMoved	= 0;
+		Policy	m_Policy{};
+	};
+}
+
+#endif
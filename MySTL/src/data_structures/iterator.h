@@ -1,6 +1,9 @@
 #ifndef ITERATOR_H
 #define ITERATOR_H
 
+#include <iterator>
+#include <type_traits>
+
 ///////////////////////////////////////////////////////////////////////////////////////
 /// iterator class																	///
 ///																					///
@@ -14,6 +17,7 @@
 // iterator					(220 - 363) ///
 // const_reverse_iterator	(366 - 558) ///
 // reverse_iterator			(561 - 697) ///
+// index_iterator			(703 - 885) ///
 ///////////////////////////////////////////
 
 // const_iterator			(19 - 221)
@@ -46,7 +50,7 @@ namespace mystl
 		constexpr	const_iterator			operator++(int);
 
 		constexpr	const_iterator&			operator+=(const size_t& offset);
-		constexpr	const_iterator&			operator+(const size_t& offset) const;
+		constexpr	const_iterator			operator+(const size_t& offset) const;
 
 	// modifier functions: decrement
 	public:
@@ -54,7 +58,7 @@ namespace mystl
 		constexpr	const_iterator			operator--(int);
 
 		constexpr	const_iterator&			operator-=(const size_t& offset);
-		constexpr	const_iterator&			operator-(const size_t& offset) const;
+		constexpr	const_iterator			operator-(const size_t& offset) const;
 
 	// pointer difference
 	public:
@@ -125,12 +129,12 @@ namespace mystl
 	}
 
 	template<class C>
-	constexpr const_iterator<C>&
+	constexpr const_iterator<C>
 		const_iterator<C>::operator+(const size_t& offset) const
 	{
 		const_iterator it = *this;
 		it += offset;
-		return *this;
+		return it;
 	}
 
 	template<class C>
@@ -158,7 +162,7 @@ namespace mystl
 	}
 
 	template<class C>
-	constexpr const_iterator<C>& 
+	constexpr const_iterator<C> 
 		const_iterator<C>::operator-(const size_t& offset) const
 	{
 		const_iterator it = *this;
@@ -257,7 +261,7 @@ namespace mystl
 		 constexpr	iterator		operator--(int);
 
 		 constexpr	iterator&		operator-=(const size_t& offset);
-		 constexpr	iterator&		operator-(const size_t& offset) const;
+		 constexpr	iterator		operator-(const size_t& offset) const;
 		 constexpr	ptrdiff_t		operator-(const iterator& other) const;
 	};
 
@@ -346,16 +350,16 @@ namespace mystl
 	}
 
 	template<class C>
-	constexpr iterator<C>& 
+	constexpr iterator<C> 
 		iterator<C>::operator-(const size_t& offset) const
 	{
 		iterator it = *this;
 		it -= offset;
-		return *this;
+		return it;
 	}
 
 	template<class C>
-	constexpr ptrdiff_t 
+	constexpr typename iterator<C>::ptrdiff_t 
 		iterator<C>::operator-(const iterator& other) const
 	{
 		return this->m_Ptr - other.m_Ptr;
@@ -696,4 +700,221 @@ namespace mystl
 	}
 }
 
+// index_iterator			(703 - 885)
+namespace mystl
+{
+	// random access iterator for containers that are not one contiguous block
+	// (stable_vector, soa_vector). it holds the container and an index and
+	// dereferences through C::operator[], so proxy references work as well
+	template<class C, bool Const>
+	class index_iterator
+	{
+	// typedefs
+	public:
+		using		container_type				= std::conditional_t<Const, const C, C>;
+		using		value_type				= typename C::value_type;
+		using		reference_type			= std::conditional_t<Const, typename C::const_reference_type, typename C::reference_type>;
+		using		ptrdiff_t				= std::ptrdiff_t;
+
+		// std::iterator_traits would call an iterator with proxy references an
+		// input iterator, which std::stable_sort and std::rotate do not take
+		using		iterator_category		= std::random_access_iterator_tag;
+
+	// constructors
+	public:
+		constexpr							index_iterator(container_type* container, const size_t& index);
+		template<bool OtherConst> requires (Const && !OtherConst)
+		constexpr							index_iterator(const index_iterator<C, OtherConst>& other);
+
+	// element access
+	public:
+		constexpr	reference_type			operator[](const size_t& offset) const;
+		constexpr	reference_type			operator*() const;
+		constexpr	auto					operator->() const requires std::is_reference_v<reference_type>;
+		constexpr	size_t					index() const;
+
+	// increment/decrement
+	public:
+		constexpr	index_iterator&			operator++();
+		constexpr	index_iterator			operator++(int);
+		constexpr	index_iterator&			operator--();
+		constexpr	index_iterator			operator--(int);
+
+		constexpr	index_iterator&			operator+=(const size_t& offset);
+		constexpr	index_iterator&			operator-=(const size_t& offset);
+		constexpr	index_iterator			operator+(const size_t& offset) const;
+		constexpr	index_iterator			operator-(const size_t& offset) const;
+		constexpr	ptrdiff_t				operator-(const index_iterator& other) const;
+
+	// equality operators
+	public:
+		constexpr	bool					operator==(const index_iterator& other) const;
+		constexpr	bool					operator!=(const index_iterator& other) const;
+		constexpr	bool					operator<(const index_iterator& other) const;
+
+	// variables
+	private:
+		friend class index_iterator<C, !Const>;
+
+					container_type*			m_Container	= nullptr;
+					size_t					m_Index		= 0;
+	};
+
+	template<class C, bool Const>
+	constexpr index_iterator<C, Const>::index_iterator(container_type* container, const size_t& index) : m_Container(container), m_Index(index)
+	{ }
+
+	template<class C, bool Const>
+	template<bool OtherConst> requires (Const && !OtherConst)
+	constexpr index_iterator<C, Const>::index_iterator(const index_iterator<C, OtherConst>& other) : m_Container(other.m_Container), m_Index(other.m_Index)
+	{ }
+
+	template<class C, bool Const>
+	constexpr typename index_iterator<C, Const>::reference_type
+		index_iterator<C, Const>::operator[](const size_t& offset) const
+	{
+		return (*m_Container)[m_Index + offset];
+	}
+
+	template<class C, bool Const>
+	constexpr typename index_iterator<C, Const>::reference_type
+		index_iterator<C, Const>::operator*() const
+	{
+		return (*m_Container)[m_Index];
+	}
+
+	template<class C, bool Const>
+	constexpr auto
+		index_iterator<C, Const>::operator->() const requires std::is_reference_v<reference_type>
+	{
+		return &(*m_Container)[m_Index];
+	}
+
+	template<class C, bool Const>
+	constexpr size_t
+		index_iterator<C, Const>::index() const
+	{
+		return m_Index;
+	}
+
+	template<class C, bool Const>
+	constexpr index_iterator<C, Const>&
+		index_iterator<C, Const>::operator++()
+	{
+		m_Index++;
+		return *this;
+	}
+
+	template<class C, bool Const>
+	constexpr index_iterator<C, Const>
+		index_iterator<C, Const>::operator++(int)
+	{
+		index_iterator it = *this;
+		m_Index++;
+		return it;
+	}
+
+	template<class C, bool Const>
+	constexpr index_iterator<C, Const>&
+		index_iterator<C, Const>::operator--()
+	{
+		m_Index--;
+		return *this;
+	}
+
+	template<class C, bool Const>
+	constexpr index_iterator<C, Const>
+		index_iterator<C, Const>::operator--(int)
+	{
+		index_iterator it = *this;
+		m_Index--;
+		return it;
+	}
+
+	template<class C, bool Const>
+	constexpr index_iterator<C, Const>&
+		index_iterator<C, Const>::operator+=(const size_t& offset)
+	{
+		m_Index += offset;
+		return *this;
+	}
+
+	template<class C, bool Const>
+	constexpr index_iterator<C, Const>&
+		index_iterator<C, Const>::operator-=(const size_t& offset)
+	{
+		m_Index -= offset;
+		return *this;
+	}
+
+	template<class C, bool Const>
+	constexpr index_iterator<C, Const>
+		index_iterator<C, Const>::operator+(const size_t& offset) const
+	{
+		return index_iterator(m_Container, m_Index + offset);
+	}
+
+	template<class C, bool Const>
+	constexpr index_iterator<C, Const>
+		index_iterator<C, Const>::operator-(const size_t& offset) const
+	{
+		return index_iterator(m_Container, m_Index - offset);
+	}
+
+	template<class C, bool Const>
+	constexpr typename index_iterator<C, Const>::ptrdiff_t
+		index_iterator<C, Const>::operator-(const index_iterator& other) const
+	{
+		return ptrdiff_t(m_Index) - ptrdiff_t(other.m_Index);
+	}
+
+	template<class C, bool Const>
+	constexpr bool
+		index_iterator<C, Const>::operator==(const index_iterator& other) const
+	{
+		return m_Index == other.m_Index;
+	}
+
+	template<class C, bool Const>
+	constexpr bool
+		index_iterator<C, Const>::operator!=(const index_iterator& other) const
+	{
+		return m_Index != other.m_Index;
+	}
+
+	template<class C, bool Const>
+	constexpr bool
+		index_iterator<C, Const>::operator<(const index_iterator& other) const
+	{
+		return m_Index < other.m_Index;
+	}
+}
+
+// contiguous iterator traits
+namespace mystl
+{
+	// true for iterators whose elements sit next to each other in memory, so
+	// algorithms may work on the raw range [&*first, &*first + count). covers
+	// the standard contiguous iterators too (std::span columns of soa_vector)
+	template<class Iterator>
+	struct is_contiguous_iterator : std::bool_constant<std::is_pointer_v<Iterator> || std::contiguous_iterator<Iterator>> { };
+
+	template<class C>
+	struct is_contiguous_iterator<const_iterator<C>> : std::true_type { };
+
+	template<class C>
+	struct is_contiguous_iterator<iterator<C>> : std::true_type { };
+
+	template<class Iterator>
+	inline constexpr bool is_contiguous_iterator_v = is_contiguous_iterator<Iterator>::value;
+
+	// true for standard input iterators that cannot be walked twice (e.g.
+	// std::istream_iterator), so a range of them cannot be counted up front
+	template<class Iterator>
+	struct is_single_pass_iterator : std::bool_constant<std::input_iterator<Iterator> && !std::forward_iterator<Iterator>> { };
+
+	template<class Iterator>
+	inline constexpr bool is_single_pass_iterator_v = is_single_pass_iterator<Iterator>::value;
+}
+
 #endif
\ No newline at end of file
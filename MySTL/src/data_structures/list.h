@@ -1,8 +1,12 @@
 #ifndef LIST_H
 #define LIST_H
 
+#include <utility>
+
+#include "allocator.h"
 #include "node.h"
 #include "list_iterator.h"
+#include "telemetry.h"
 
 // TODO:
 // write sort algorithms
@@ -11,24 +15,26 @@
 // list class
 namespace mystl
 {
-	template<typename T>
+	template<typename T, class Allocator = allocator<T>>
 	class list
 	{
 	// typedefs
 	public:
 		using		value_type				= T;
+		using		allocator_type			= Allocator;
 
 		using		reference_type			= value_type&;
 		using		pointer_type			= value_type*;
 
-		using		node					= node<T>;
+		using		node					= mystl::node<T>;
 		using		node_ptr				= node*;
+		using		node_allocator			= rebind_allocator<Allocator, node>;
 
 		using		const_reference_type	= const value_type&;
 		using		const_pointer_type		= const value_type*;
 
-		using		const_iterator			= list_const_iterator<list<T>>;
-		using		iterator				= list_iterator<list<T>>;
+		using		const_iterator			= list_const_iterator<list<T, Allocator>>;
+		using		iterator				= list_iterator<list<T, Allocator>>;
 
 		using		const_reverse_iterator	= list_const_reverse_iterator<const_iterator>;
 		using		reverse_iterator		= list_reverse_iterator<iterator>;
@@ -37,7 +43,10 @@ namespace mystl
 	public:
 		constexpr							list();
 		constexpr							list(const size_t& size);
+		constexpr	explicit				list(const Allocator& allocator);
 		constexpr							list(const size_t& size, const_reference_type fillElement);
+		constexpr							list(const list& other);
+		constexpr							list(list&& other) noexcept;
 											~list();
 
 	// size functions
@@ -45,6 +54,9 @@ namespace mystl
 		constexpr	bool					empty() const;
 		constexpr	size_t					size() const;
 
+		constexpr	allocator_type			get_allocator() const;
+		constexpr	telemetry::counters		telemetry_stats() const;
+
 	// element access
 	public:
 		constexpr	reference_type			operator[](const size_t& offset);
@@ -83,9 +95,14 @@ namespace mystl
 
 	// mutators
 	public:
-					[[noreturn]] void		clear();
-					[[noreturn]] void		swap(list& other);
-					[[noreturn]] void		resize(const size_t& size);
+					void					clear();
+					void					swap(list& other);
+					void					resize(const size_t& size);
+
+	// operators
+	public:
+		constexpr	list&					operator=(const list& other);
+		constexpr	list&					operator=(list&& other);
 
 	// mutators
 	public:
@@ -93,8 +110,8 @@ namespace mystl
 		constexpr	iterator				erase(iterator position);
 		constexpr	iterator				erase(iterator first, iterator last);
 
-		constexpr	reference_type			remove(T&& element);
-		constexpr	reference_type			remove(const_reference_type element);
+		constexpr	size_t					remove(T&& element);
+		constexpr	size_t					remove(const_reference_type element);
 
 		template<class Predicate>
 		constexpr	void					remove_if(const Predicate& predicate);
@@ -124,52 +141,94 @@ namespace mystl
 		constexpr	reverse_iterator		rbegin();
 		constexpr	reverse_iterator		rend();
 
+	// node allocation
 	private:
-					node_ptr				m_Head	= nullptr;
-					node_ptr				m_Tail	= nullptr;
-					size_t					m_Size	= 0;
+		template<typename... Args>
+		constexpr	node_ptr				create_node(Args&&... args);
+		constexpr	void					destroy_node(node_ptr ptr);
+
+	private:
+					node_ptr				m_Head		= nullptr;
+					node_ptr				m_Tail		= nullptr;
+					size_t					m_Size		= 0;
+					node_allocator			m_Allocator{};
+		MYSTL_NO_UNIQUE_ADDRESS telemetry::probe<list> m_Telemetry{};
 	};
 
-	template<typename T>
-	constexpr list<T>::list() : m_Head(nullptr), m_Tail(nullptr), m_Size(0)
+	template<typename T, class Allocator>
+	constexpr list<T, Allocator>::list() : m_Head(nullptr), m_Tail(nullptr), m_Size(0)
 	{
 
 	}
 
-	template<typename T>
-	constexpr list<T>::list(const size_t& size) : m_Head(nullptr), m_Tail(nullptr), m_Size(size)
+	template<typename T, class Allocator>
+	constexpr list<T, Allocator>::list(const size_t& size) : m_Head(nullptr), m_Tail(nullptr), m_Size(size)
 	{
 
 	}
 
-	template<typename T>
-	constexpr list<T>::list(const size_t& size, const_reference_type fillElement) : m_Head(nullptr), m_Tail(nullptr), m_Size(size)
+	template<typename T, class Allocator>
+	constexpr list<T, Allocator>::list(const size_t& size, const_reference_type fillElement) : m_Head(nullptr), m_Tail(nullptr), m_Size(size)
 	{
 		for (size_t i = 0; i < size; i++)
 			emplace_front(fillElement);
 	}
 
-	template<typename T>
-	inline list<T>::~list()
+	template<typename T, class Allocator>
+	constexpr list<T, Allocator>::list(const Allocator& allocator) : m_Head(nullptr), m_Tail(nullptr), m_Size(0), m_Allocator(allocator)
+	{
+
+	}
+
+	template<typename T, class Allocator>
+	constexpr list<T, Allocator>::list(const list& other) : m_Head(nullptr), m_Tail(nullptr), m_Size(0), m_Allocator(other.m_Allocator)
+	{
+		for (node_ptr temp = other.m_Head; temp; temp = temp->next)
+			emplace_back(temp->data);
+	}
+
+	// takes other's nodes; other is left empty
+	template<typename T, class Allocator>
+	constexpr list<T, Allocator>::list(list&& other) noexcept : m_Head(other.m_Head), m_Tail(other.m_Tail), m_Size(other.m_Size), m_Allocator(std::move(other.m_Allocator)), m_Telemetry(std::move(other.m_Telemetry))
+	{
+		other.m_Head = nullptr;
+		other.m_Tail = nullptr;
+		other.m_Size = 0;
+	}
+
+	template<typename T, class Allocator>
+	inline list<T, Allocator>::~list()
 	{
 		while (!empty())
 			pop_front();
 	}
 
-	template<typename T>
-	constexpr bool list<T>::empty() const
+	template<typename T, class Allocator>
+	constexpr bool list<T, Allocator>::empty() const
 	{
 		return !m_Head;
 	}
 
-	template<typename T>
-	constexpr size_t list<T>::size() const
+	template<typename T, class Allocator>
+	constexpr size_t list<T, Allocator>::size() const
 	{
 		return m_Size;
 	}
 
-	template<typename T>
-	constexpr typename list<T>::reference_type list<T>::operator[](const size_t& offset)
+	template<typename T, class Allocator>
+	constexpr typename list<T, Allocator>::allocator_type list<T, Allocator>::get_allocator() const
+	{
+		return allocator_type(m_Allocator);
+	}
+
+	template<typename T, class Allocator>
+	constexpr telemetry::counters list<T, Allocator>::telemetry_stats() const
+	{
+		return m_Telemetry.stats();
+	}
+
+	template<typename T, class Allocator>
+	constexpr typename list<T, Allocator>::reference_type list<T, Allocator>::operator[](const size_t& offset)
 	{
 		node_ptr temp = m_Head;
 		
@@ -179,61 +238,61 @@ namespace mystl
 		return temp->data;
 	}
 
-	template<typename T>
-	constexpr typename list<T>::const_reference_type list<T>::operator[](const size_t& offset) const
+	template<typename T, class Allocator>
+	constexpr typename list<T, Allocator>::const_reference_type list<T, Allocator>::operator[](const size_t& offset) const
 	{
 		return this->operator[](offset);
 	}
 
-	template<typename T>
-	constexpr typename list<T>::reference_type list<T>::front()
+	template<typename T, class Allocator>
+	constexpr typename list<T, Allocator>::reference_type list<T, Allocator>::front()
 	{
 		return m_Head->data;
 	}
 
-	template<typename T>
-	constexpr typename list<T>::reference_type list<T>::back()
+	template<typename T, class Allocator>
+	constexpr typename list<T, Allocator>::reference_type list<T, Allocator>::back()
 	{
 		return m_Tail->data;
 	}
 
-	template<typename T>
-	constexpr typename list<T>::const_reference_type list<T>::front() const
+	template<typename T, class Allocator>
+	constexpr typename list<T, Allocator>::const_reference_type list<T, Allocator>::front() const
 	{
 		return m_Head->data;
 	}
 
-	template<typename T>
-	constexpr typename list<T>::const_reference_type list<T>::back() const
+	template<typename T, class Allocator>
+	constexpr typename list<T, Allocator>::const_reference_type list<T, Allocator>::back() const
 	{
 		return m_Tail->data;
 	}
 
-	template<typename T>
-	constexpr void list<T>::assign(const size_t& size, const_reference_type fillElement)
+	template<typename T, class Allocator>
+	constexpr void list<T, Allocator>::assign(const size_t& size, const_reference_type fillElement)
 	{
 		for (size_t i = 0; i < size; i++)
 			emplace_front(fillElement);
 	}
 
-	template<typename T>
-	constexpr void list<T>::assign(iterator first, iterator last)
+	template<typename T, class Allocator>
+	constexpr void list<T, Allocator>::assign(iterator first, iterator last)
 	{
 
 	}
 
-	template<typename T>
-	constexpr void list<T>::assign(pointer_type first, pointer_type second)
+	template<typename T, class Allocator>
+	constexpr void list<T, Allocator>::assign(pointer_type first, pointer_type second)
 	{
 		while (first != second)
 			emplace_front(*(first++));
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	template<typename ...Args>
-	constexpr typename list<T>::reference_type list<T>::emplace_front(Args && ...args)
+	constexpr typename list<T, Allocator>::reference_type list<T, Allocator>::emplace_front(Args && ...args)
 	{
-		node_ptr temp = new node(std::forward<Args>(args)...);
+		node_ptr temp = create_node(std::forward<Args>(args)...);
 
 		if (!m_Head)
 		{
@@ -251,11 +310,11 @@ namespace mystl
 		return m_Head->data;
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	template<typename ...Args>
-	constexpr typename list<T>::reference_type list<T>::emplace_back(Args && ...args)
+	constexpr typename list<T, Allocator>::reference_type list<T, Allocator>::emplace_back(Args && ...args)
 	{
-		node_ptr temp = new node(std::forward<Args>(args)...);
+		node_ptr temp = create_node(std::forward<Args>(args)...);
 
 		if (!m_Head)
 		{
@@ -273,15 +332,17 @@ namespace mystl
 		return m_Tail->data;
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	template<typename ...Args>
-	constexpr typename list<T>::iterator list<T>::emplace(iterator position, Args && ...args)
+	constexpr typename list<T, Allocator>::iterator list<T, Allocator>::emplace(iterator position, Args && ...args)
 	{
-		node_ptr temp = new node(std::forward<Args>(args)...);
+		node_ptr temp = create_node(std::forward<Args>(args)...);
 
 		if (!m_Head)
 		{
-			emplace_front(args);
+			m_Head = temp;
+			m_Tail = temp;
+			m_Size++;
 			return begin();
 		}
 
@@ -303,150 +364,185 @@ namespace mystl
 		return position;
 	}
 
-	template<typename T>
-	constexpr typename list<T>::reference_type list<T>::push_front(T&& element)
+	template<typename T, class Allocator>
+	constexpr typename list<T, Allocator>::reference_type list<T, Allocator>::push_front(T&& element)
 	{
-		return emplace_front(element);
+		return emplace_front(std::move(element));
 	}
 
-	template<typename T>
-	constexpr typename list<T>::reference_type list<T>::push_front(const_reference_type element)
+	template<typename T, class Allocator>
+	constexpr typename list<T, Allocator>::reference_type list<T, Allocator>::push_front(const_reference_type element)
 	{
 		return emplace_front(element);
 	}
 
-	template<typename T>
-	constexpr typename list<T>::reference_type list<T>::push_back(T&& element)
+	template<typename T, class Allocator>
+	constexpr typename list<T, Allocator>::reference_type list<T, Allocator>::push_back(T&& element)
 	{
-		return emplace_back(element);
+		return emplace_back(std::move(element));
 	}
 
-	template<typename T>
-	constexpr typename list<T>::reference_type list<T>::push_back(const_reference_type element)
+	template<typename T, class Allocator>
+	constexpr typename list<T, Allocator>::reference_type list<T, Allocator>::push_back(const_reference_type element)
 	{
 		return emplace_back(element);
 	}
 
-	template<typename T>
-	constexpr typename list<T>::value_type list<T>::pop_front()
+	template<typename T, class Allocator>
+	constexpr typename list<T, Allocator>::value_type list<T, Allocator>::pop_front()
 	{
 		if (!m_Head)
 			return value_type();
 
 		node_ptr temp = m_Head;
 		m_Head = m_Head->next;
-		value_type val = temp->data;
 
-		delete temp;
+		if (m_Head)
+			m_Head->prev = nullptr;
+		else
+			m_Tail = nullptr;
+
+		value_type val = std::move(temp->data);
+
+		destroy_node(temp);
 		m_Size--;
 
 		return val;
 	}
 
-	template<typename T>
-	constexpr typename list<T>::value_type list<T>::pop_back()
+	template<typename T, class Allocator>
+	constexpr typename list<T, Allocator>::value_type list<T, Allocator>::pop_back()
 	{
 		if (!m_Head)
 			return value_type();
 
 		node_ptr temp = m_Tail;
 		m_Tail = m_Tail->prev;
-		m_Tail->next = nullptr;
-		value_type val = temp->data;
 
-		delete temp;
+		if (m_Tail)
+			m_Tail->next = nullptr;
+		else
+			m_Head = nullptr;
+
+		value_type val = std::move(temp->data);
+
+		destroy_node(temp);
 		m_Size--;
 
 		return val;
 	}
 
-	template<typename T>
-	constexpr typename list<T>::reference_type list<T>::insert(iterator position, T&& element)
+	template<typename T, class Allocator>
+	constexpr typename list<T, Allocator>::reference_type list<T, Allocator>::insert(iterator position, T&& element)
 	{
 		emplace(position, element);
 	}
 
-	template<typename T>
-	inline void list<T>::clear()
+	template<typename T, class Allocator>
+	inline void list<T, Allocator>::clear()
 	{
 		while (m_Head)
 			pop_front();
 	}
 
 	
-	template<typename T>
-	inline void list<T>::swap(list& other)
+	template<typename T, class Allocator>
+	inline void list<T, Allocator>::swap(list& other)
 	{
-		node_ptr tempHead = m_Head;
-		node_ptr tempTail = m_Tail;
-		size_t tempSize = m_Size;
+		std::swap(m_Head, other.m_Head);
+		std::swap(m_Tail, other.m_Tail);
+		std::swap(m_Size, other.m_Size);
+		std::swap(m_Allocator, other.m_Allocator);
+		std::swap(m_Telemetry, other.m_Telemetry);
+	}
 
-		m_Head = other.m_Head;
-		m_Tail = other.m_Tail;
-		m_Size = other.m_Size;
+	template<typename T, class Allocator>
+	constexpr list<T, Allocator>& list<T, Allocator>::operator=(const list& other)
+	{
+		if (this == &other)
+			return *this;
+
+		list copy(other);
+		swap(copy);
 
-		other.m_Head = tempHead;
-		other.m_Tail = tempTail;
-		other.m_Size = tempSize;
+		return *this;
 	}
 
-	template<typename T>
-	inline void list<T>::resize(const size_t& size)
+	template<typename T, class Allocator>
+	constexpr list<T, Allocator>& list<T, Allocator>::operator=(list&& other)
+	{
+		if (this == &other)
+			return *this;
+
+		clear();
+		swap(other);
+
+		return *this;
+	}
+
+	template<typename T, class Allocator>
+	inline void list<T, Allocator>::resize(const size_t& size)
 	{
 		while (m_Size > size)
 			pop_back();
 	}
 
-	template<typename T>
-	constexpr typename list<T>::reference_type list<T>::remove(T&& element)
+	template<typename T, class Allocator>
+	constexpr size_t list<T, Allocator>::remove(T&& element)
 	{
 		node_ptr temp = m_Head;
 
-		while (temp->data != element)
-		{
-			if (!temp->next)
-				return reference_type();
-
+		while (temp && temp->data != element)
 			temp = temp->next;
-		}
 
-		temp->prev->next = temp->next;
-		temp->next->prev = temp->prev;
-		
-		reference_type data = temp->data;
+		if (!temp)
+			return 0;
 
-		delete temp;
+		if (temp->prev)
+			temp->prev->next = temp->next;
+		else
+			m_Head = temp->next;
+
+		if (temp->next)
+			temp->next->prev = temp->prev;
+		else
+			m_Tail = temp->prev;
+
+		destroy_node(temp);
 		m_Size--;
 
-		return data;
+		return 1;
 	}
 
-	template<typename T>
-	constexpr typename list<T>::reference_type list<T>::remove(const_reference_type element)
+	template<typename T, class Allocator>
+	constexpr size_t list<T, Allocator>::remove(const_reference_type element)
 	{
 		node_ptr temp = m_Head;
 
-		while (temp->data != element)
-		{
-			if (!temp->next)
-				return reference_type();
-
+		while (temp && temp->data != element)
 			temp = temp->next;
-		}
 
-		temp->prev->next = temp->next;
-		temp->next->prev = temp->prev;
+		if (!temp)
+			return 0;
+
+		if (temp->prev)
+			temp->prev->next = temp->next;
+		else
+			m_Head = temp->next;
 
-		reference_type data = temp->data;
+		if (temp->next)
+			temp->next->prev = temp->prev;
+		else
+			m_Tail = temp->prev;
 
-		delete temp;
+		destroy_node(temp);
 		m_Size--;
 
-		return data;
+		return 1;
 	}
 
-	template<typename T>
-	constexpr typename list<T>::iterator list<T>::erase(iterator position)
+	template<typename T, class Allocator>
+	constexpr typename list<T, Allocator>::iterator list<T, Allocator>::erase(iterator position)
 	{
 		node_ptr temp = m_Head;
 
@@ -458,8 +554,8 @@ namespace mystl
 		return position;
 	}
 
-	template<typename T>
-	constexpr typename list<T>::iterator list<T>::erase(iterator first, iterator last)
+	template<typename T, class Allocator>
+	constexpr typename list<T, Allocator>::iterator list<T, Allocator>::erase(iterator first, iterator last)
 	{
 		iterator temp = first;
 		while (first != last)
@@ -468,27 +564,27 @@ namespace mystl
 		return temp;
 	}
 
-	template<typename T>
-	constexpr void list<T>::sort()
+	template<typename T, class Allocator>
+	constexpr void list<T, Allocator>::sort()
 	{
 		// implemented later using merge sort
 	}
 
-	template<typename T>
-	constexpr void list<T>::merge(list& other)
+	template<typename T, class Allocator>
+	constexpr void list<T, Allocator>::merge(list& other)
 	{
 		m_Tail->next = other.m_Head;
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	template<class Compare>
-	constexpr void list<T>::merge(list& other, const Compare& comparator)
+	constexpr void list<T, Allocator>::merge(list& other, const Compare& comparator)
 	{
 		// implemented later using merge sort
 	}
 
-	template<typename T>
-	constexpr void list<T>::reverse()
+	template<typename T, class Allocator>
+	constexpr void list<T, Allocator>::reverse()
 	{
 		if (!m_Head)
 			return;
@@ -510,67 +606,86 @@ namespace mystl
 		m_Head = prev;
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	template<class Predicate>
-	constexpr void list<T>::remove_if(const Predicate& predicate)
+	constexpr void list<T, Allocator>::remove_if(const Predicate& predicate)
 	{
 		// implement later
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	template<class Compare>
-	constexpr void list<T>::sort(const Compare& comparator)
+	constexpr void list<T, Allocator>::sort(const Compare& comparator)
 	{
 		// implement using merge sort later
 	}
 
-	template<typename T>
-	constexpr typename list<T>::const_iterator list<T>::cbegin() const
+	template<typename T, class Allocator>
+	constexpr typename list<T, Allocator>::const_iterator list<T, Allocator>::cbegin() const
 	{
 		return const_iterator(m_Head);
 	}
 
-	template<typename T>
-	constexpr typename list<T>::const_iterator list<T>::cend() const
+	template<typename T, class Allocator>
+	constexpr typename list<T, Allocator>::const_iterator list<T, Allocator>::cend() const
 	{
-		return const_iterator(m_Tail->next);
+		return const_iterator(nullptr);
 	}
 
-	template<typename T>
-	constexpr typename list<T>::iterator list<T>::begin()
+	template<typename T, class Allocator>
+	constexpr typename list<T, Allocator>::iterator list<T, Allocator>::begin()
 	{
 		return iterator(m_Head);
 	}
 
-	template<typename T>
-	constexpr typename list<T>::iterator list<T>::end()
+	template<typename T, class Allocator>
+	constexpr typename list<T, Allocator>::iterator list<T, Allocator>::end()
 	{
-		return iterator(m_Tail->next);
+		return iterator(nullptr);
 	}
 
-	template<typename T>
-	constexpr typename list<T>::const_reverse_iterator list<T>::crbegin() const
+	template<typename T, class Allocator>
+	constexpr typename list<T, Allocator>::const_reverse_iterator list<T, Allocator>::crbegin() const
 	{
 		return const_reverse_iterator(cend());
 	}
 
-	template<typename T>
-	constexpr typename list<T>::const_reverse_iterator list<T>::crend() const
+	template<typename T, class Allocator>
+	constexpr typename list<T, Allocator>::const_reverse_iterator list<T, Allocator>::crend() const
 	{
 		return const_reverse_iterator(cbegin());
 	}
 
-	template<typename T>
-	constexpr typename list<T>::reverse_iterator list<T>::rbegin()
+	template<typename T, class Allocator>
+	constexpr typename list<T, Allocator>::reverse_iterator list<T, Allocator>::rbegin()
 	{
 		return reverse_iterator(end());
 	}
 
-	template<typename T>
-	constexpr typename list<T>::reverse_iterator list<T>::rend()
+	template<typename T, class Allocator>
+	constexpr typename list<T, Allocator>::reverse_iterator list<T, Allocator>::rend()
 	{
 		return reverse_iterator(begin());
 	}
+
+	template<typename T, class Allocator>
+	template<typename ...Args>
+	constexpr typename list<T, Allocator>::node_ptr list<T, Allocator>::create_node(Args && ...args)
+	{
+		node_ptr ptr = m_Allocator.allocate(1);
+		m_Telemetry.allocated(ptr, sizeof(node));
+		new(ptr) node(std::in_place, std::forward<Args>(args)...);
+
+		return ptr;
+	}
+
+	template<typename T, class Allocator>
+	constexpr void list<T, Allocator>::destroy_node(node_ptr ptr)
+	{
+		ptr->~node();
+		m_Telemetry.freed(ptr, sizeof(node));
+		m_Allocator.deallocate(ptr, 1);
+	}
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,719 @@
+#ifndef MAPPED_VECTOR_H
+#define MAPPED_VECTOR_H
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "growth_policy.h"
+#include "iterator.h"
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// mapped_vector																	///
+///																					///
+/// This class is a vector whose storage is a file mapped with						///
+/// mmap(MAP_SHARED). The file holds a small header (element size, size,			///
+/// capacity) followed by the elements, so opening an existing file gives back		///
+/// its contents without reading or parsing anything: pages are faulted in as		///
+/// they are touched. Growing extends the file with ftruncate and remaps it.		///
+/// Only trivially copyable types can be stored. Needs a POSIX system.				///
+///																					///
+///////////////////////////////////////////////////////////////////////////////////////
+
+namespace mystl
+{
+	enum class open_mode
+	{
+		read_only,		// maps an existing file, mutators and non-const accessors throw std::logic_error
+		read_write,		// maps an existing file or creates an empty one
+		truncate		// creates the file, dropping any previous contents
+	};
+
+	template<typename T, class GrowthPolicy = growth::page_aligned<>>
+	class mapped_vector
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "mapped_vector stores its elements as raw bytes");
+		static_assert(alignof(T) <= 64, "mapped_vector aligns its elements to 64 bytes");
+
+	// typedefs
+	public:
+		using		value_type				= T;
+
+		using		reference_type			= T&;
+		using		pointer_type			= T*;
+
+		using		const_reference_type	= const T&;
+		using		const_pointer_type		= const T*;
+
+		using		const_iterator			= mystl::const_iterator<mapped_vector<T, GrowthPolicy>>;
+		using		iterator				= mystl::iterator<mapped_vector<T, GrowthPolicy>>;
+
+		using		const_reverse_iterator	= mystl::const_reverse_iterator<const_iterator>;
+		using		reverse_iterator		= mystl::reverse_iterator<iterator>;
+
+	// constructor/destructor
+	public:
+		explicit							mapped_vector(const char* path, const open_mode& mode = open_mode::read_write);
+											mapped_vector(const mapped_vector& other) = delete;
+											mapped_vector(mapped_vector&& other) noexcept;
+											~mapped_vector();
+
+	// size functions
+	public:
+					size_t					size() const;
+					size_t					max_size() const;
+					size_t					capacity() const;
+
+					bool					empty() const;
+					bool					is_read_only() const;
+
+	// access functions
+	public:
+					reference_type			operator[](const size_t& index);
+					const_reference_type	operator[](const size_t& index) const;
+					const_reference_type	at(const size_t& index) const;
+
+					reference_type			front();
+					reference_type			back();
+
+					const_reference_type	front() const;
+					const_reference_type	back() const;
+
+					pointer_type			data();
+					const_pointer_type		data() const;
+
+	// mutator functions
+	public:
+					reference_type			push_back(const_reference_type element);
+
+		template<typename... Args>
+					reference_type			emplace_back(Args&&... args);
+
+					iterator				insert(iterator position, const_reference_type element);
+					iterator				erase(iterator position);
+					iterator				erase(iterator first, iterator last);
+
+		template<class Iterator> requires (!std::is_integral_v<Iterator>)
+					void					append(Iterator first, Iterator last);
+
+					value_type				pop_back();
+
+					void					clear();
+					void					reserve(const size_t& size);
+					void					resize(const size_t& size);
+					void					resize(const size_t& size, const_reference_type fillElement);
+					void					shrink_to_fit();
+					void					swap(mapped_vector& other);
+
+		// writes dirty pages back to the file and waits for the write
+					void					flush();
+
+	// operators
+	public:
+					mapped_vector&			operator=(const mapped_vector& other) = delete;
+					mapped_vector&			operator=(mapped_vector&& other) noexcept;
+
+	// iterator functions
+	public:
+					const_iterator			cbegin() const;
+					const_iterator			cend() const;
+
+					const_iterator			begin() const;
+					const_iterator			end() const;
+
+					iterator				begin();
+					iterator				end();
+
+					const_reverse_iterator	crbegin() const;
+					const_reverse_iterator	crend() const;
+
+					reverse_iterator		rbegin();
+					reverse_iterator		rend();
+
+	// file layout
+	private:
+		struct header
+		{
+			uint64_t				magic;
+			uint32_t				version;
+			uint32_t				elementSize;
+			uint64_t				size;
+			uint64_t				capacity;
+		};
+
+		static constexpr uint64_t			file_magic		= 0x3156454D4C54534Dull;	// "MSTLMEV1"
+		static constexpr uint32_t			file_version	= 1;
+		static constexpr size_t				header_bytes	= 64;
+
+	// helpers
+	private:
+					void					check_writable() const;
+					void					remap(const size_t& newCapacity);
+					void					grow(const size_t& required);
+					void					close();
+
+		[[noreturn]] void					abandon(const char* what);
+		[[noreturn]] static void			fail(const char* what);
+
+	// variables
+	private:
+					int						m_File		= -1;
+					header*					m_Header	= nullptr;
+					pointer_type			m_Data		= nullptr;
+					size_t					m_MapBytes	= 0;
+					size_t					m_Capacity	= 0;
+					bool					m_ReadOnly	= false;
+	};
+
+	// opens (or creates) the file and maps it. an existing file is checked
+	// against the header written for T; a mismatch throws std::runtime_error
+	template<typename T, class GrowthPolicy>
+	inline mapped_vector<T, GrowthPolicy>::mapped_vector(const char* path, const open_mode& mode) : m_ReadOnly(mode == open_mode::read_only)
+	{
+		int flags = m_ReadOnly ? O_RDONLY : O_RDWR | O_CREAT;
+		if (mode == open_mode::truncate)
+			flags |= O_TRUNC;
+
+		m_File = ::open(path, flags | O_CLOEXEC, 0644);
+		if (m_File < 0)
+			fail("mapped_vector: open");
+
+		struct stat info{};
+		if (fstat(m_File, &info) != 0)
+			abandon("mapped_vector: fstat");
+
+		size_t fileBytes = (size_t)info.st_size;
+
+		if (fileBytes == 0 && !m_ReadOnly)
+		{
+			if (ftruncate(m_File, (off_t)header_bytes) != 0)
+				abandon("mapped_vector: ftruncate");
+
+			fileBytes = header_bytes;
+		}
+
+		if (fileBytes < header_bytes)
+		{
+			close();
+			throw std::runtime_error("mapped_vector: file is too small to hold a header");
+		}
+
+		void* map = mmap(nullptr, fileBytes, m_ReadOnly ? PROT_READ : PROT_READ | PROT_WRITE, MAP_SHARED, m_File, 0);
+		if (map == MAP_FAILED)
+			abandon("mapped_vector: mmap");
+
+		m_Header = static_cast<header*>(map);
+		m_Data = reinterpret_cast<pointer_type>(static_cast<unsigned char*>(map) + header_bytes);
+		m_MapBytes = fileBytes;
+		m_Capacity = (fileBytes - header_bytes) / sizeof(T);
+
+		if (fileBytes == header_bytes && m_Header->magic == 0 && !m_ReadOnly)
+			*m_Header = header{ file_magic, file_version, (uint32_t)sizeof(T), 0, 0 };
+
+		// the file may be longer than the header says when a growth was cut
+		// short between ftruncate and the header update; the extra is kept
+		if (m_Header->magic != file_magic || m_Header->version != file_version || m_Header->elementSize != sizeof(T)
+			|| m_Header->size > m_Capacity)
+		{
+			close();
+			throw std::runtime_error("mapped_vector: file was not written by a mapped_vector of this type");
+		}
+
+		if (!m_ReadOnly)
+			m_Header->capacity = m_Capacity;
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline mapped_vector<T, GrowthPolicy>::mapped_vector(mapped_vector&& other) noexcept
+		: m_File(other.m_File), m_Header(other.m_Header), m_Data(other.m_Data), m_MapBytes(other.m_MapBytes), m_Capacity(other.m_Capacity), m_ReadOnly(other.m_ReadOnly)
+	{
+		other.m_File = -1;
+		other.m_Header = nullptr;
+		other.m_Data = nullptr;
+		other.m_MapBytes = 0;
+		other.m_Capacity = 0;
+	}
+
+	// unmapping does not wait for the kernel to write the pages back, call
+	// flush() first when the file has to be on disk
+	template<typename T, class GrowthPolicy>
+	inline mapped_vector<T, GrowthPolicy>::~mapped_vector()
+	{
+		close();
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline size_t
+		mapped_vector<T, GrowthPolicy>::size() const
+	{
+		return m_Header ? (size_t)m_Header->size : 0;
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline size_t
+		mapped_vector<T, GrowthPolicy>::max_size() const
+	{
+		return (SIZE_MAX - header_bytes) / sizeof(T);
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline size_t
+		mapped_vector<T, GrowthPolicy>::capacity() const
+	{
+		return m_Capacity;
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline bool
+		mapped_vector<T, GrowthPolicy>::empty() const
+	{
+		return size() == 0;
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline bool
+		mapped_vector<T, GrowthPolicy>::is_read_only() const
+	{
+		return m_ReadOnly;
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline typename mapped_vector<T, GrowthPolicy>::reference_type
+		mapped_vector<T, GrowthPolicy>::operator[](const size_t& index)
+	{
+		check_writable();
+		return m_Data[index];
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline typename mapped_vector<T, GrowthPolicy>::const_reference_type
+		mapped_vector<T, GrowthPolicy>::operator[](const size_t& index) const
+	{
+		return m_Data[index];
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline typename mapped_vector<T, GrowthPolicy>::const_reference_type
+		mapped_vector<T, GrowthPolicy>::at(const size_t& index) const
+	{
+		return m_Data[index];
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline typename mapped_vector<T, GrowthPolicy>::reference_type
+		mapped_vector<T, GrowthPolicy>::front()
+	{
+		check_writable();
+		return m_Data[0];
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline typename mapped_vector<T, GrowthPolicy>::reference_type
+		mapped_vector<T, GrowthPolicy>::back()
+	{
+		check_writable();
+		return m_Data[size() - 1];
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline typename mapped_vector<T, GrowthPolicy>::const_reference_type
+		mapped_vector<T, GrowthPolicy>::front() const
+	{
+		return m_Data[0];
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline typename mapped_vector<T, GrowthPolicy>::const_reference_type
+		mapped_vector<T, GrowthPolicy>::back() const
+	{
+		return m_Data[size() - 1];
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline typename mapped_vector<T, GrowthPolicy>::pointer_type
+		mapped_vector<T, GrowthPolicy>::data()
+	{
+		check_writable();
+		return m_Data;
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline typename mapped_vector<T, GrowthPolicy>::const_pointer_type
+		mapped_vector<T, GrowthPolicy>::data() const
+	{
+		return m_Data;
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline typename mapped_vector<T, GrowthPolicy>::reference_type
+		mapped_vector<T, GrowthPolicy>::push_back(const_reference_type element)
+	{
+		return emplace_back(element);
+	}
+
+	template<typename T, class GrowthPolicy>
+	template<typename... Args>
+	inline typename mapped_vector<T, GrowthPolicy>::reference_type
+		mapped_vector<T, GrowthPolicy>::emplace_back(Args&&... args)
+	{
+		check_writable();
+
+		// built before growing, args may refer into the mapping
+		T element(std::forward<Args>(args)...);
+		size_t count = size();
+
+		grow(count + 1);
+
+		m_Data[count] = element;
+		m_Header->size = count + 1;
+
+		return m_Data[count];
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline typename mapped_vector<T, GrowthPolicy>::iterator
+		mapped_vector<T, GrowthPolicy>::insert(iterator position, const_reference_type element)
+	{
+		check_writable();
+
+		T copy(element);
+		size_t index = position - begin();
+		size_t count = size();
+
+		grow(count + 1);
+
+		std::memmove(m_Data + index + 1, m_Data + index, (count - index) * sizeof(T));
+		m_Data[index] = copy;
+		m_Header->size = count + 1;
+
+		return begin() + index;
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline typename mapped_vector<T, GrowthPolicy>::iterator
+		mapped_vector<T, GrowthPolicy>::erase(iterator position)
+	{
+		return erase(position, position + 1);
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline typename mapped_vector<T, GrowthPolicy>::iterator
+		mapped_vector<T, GrowthPolicy>::erase(iterator first, iterator last)
+	{
+		check_writable();
+
+		size_t index = first - begin();
+		size_t count = last - first;
+		size_t tail = size() - index - count;
+
+		std::memmove(m_Data + index, m_Data + index + count, tail * sizeof(T));
+		m_Header->size -= count;
+
+		return begin() + index;
+	}
+
+	template<typename T, class GrowthPolicy>
+	template<class Iterator> requires (!std::is_integral_v<Iterator>)
+	inline void
+		mapped_vector<T, GrowthPolicy>::append(Iterator first, Iterator last)
+	{
+		check_writable();
+
+		if constexpr (is_contiguous_iterator_v<Iterator>)
+		{
+			size_t count = size_t(last - first);
+			if (count == 0)
+				return;
+
+			size_t oldSize = size();
+
+			grow(oldSize + count);
+			std::memmove(m_Data + oldSize, &*first, count * sizeof(T));
+			m_Header->size = oldSize + count;
+		}
+		else
+		{
+			for (; first != last; ++first)
+				emplace_back(*first);
+		}
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline typename mapped_vector<T, GrowthPolicy>::value_type
+		mapped_vector<T, GrowthPolicy>::pop_back()
+	{
+		check_writable();
+
+		if (empty())
+			return value_type();
+
+		return m_Data[--m_Header->size];
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline void
+		mapped_vector<T, GrowthPolicy>::clear()
+	{
+		check_writable();
+
+		m_Header->size = 0;
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline void
+		mapped_vector<T, GrowthPolicy>::reserve(const size_t& size)
+	{
+		check_writable();
+
+		if (size > m_Capacity)
+			remap(size);
+	}
+
+	// new elements are value-initialized, which for the bytes of a freshly
+	// extended file they already are
+	template<typename T, class GrowthPolicy>
+	inline void
+		mapped_vector<T, GrowthPolicy>::resize(const size_t& size)
+	{
+		resize(size, value_type());
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline void
+		mapped_vector<T, GrowthPolicy>::resize(const size_t& size, const_reference_type fillElement)
+	{
+		check_writable();
+
+		T element(fillElement);
+		size_t oldSize = this->size();
+
+		if (size > m_Capacity)
+			remap(size);
+
+		for (size_t i = oldSize; i < size; i++)
+			m_Data[i] = element;
+
+		m_Header->size = size;
+	}
+
+	// cuts the file down to the elements in use
+	template<typename T, class GrowthPolicy>
+	inline void
+		mapped_vector<T, GrowthPolicy>::shrink_to_fit()
+	{
+		check_writable();
+
+		if (m_Capacity > size())
+			remap(size());
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline void
+		mapped_vector<T, GrowthPolicy>::swap(mapped_vector& other)
+	{
+		std::swap(m_File, other.m_File);
+		std::swap(m_Header, other.m_Header);
+		std::swap(m_Data, other.m_Data);
+		std::swap(m_MapBytes, other.m_MapBytes);
+		std::swap(m_Capacity, other.m_Capacity);
+		std::swap(m_ReadOnly, other.m_ReadOnly);
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline void
+		mapped_vector<T, GrowthPolicy>::flush()
+	{
+		if (m_Header && !m_ReadOnly && msync(m_Header, m_MapBytes, MS_SYNC) != 0)
+			fail("mapped_vector: msync");
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline mapped_vector<T, GrowthPolicy>&
+		mapped_vector<T, GrowthPolicy>::operator=(mapped_vector&& other) noexcept
+	{
+		if (this != &other)
+		{
+			close();
+			swap(other);
+		}
+
+		return *this;
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline typename mapped_vector<T, GrowthPolicy>::const_iterator
+		mapped_vector<T, GrowthPolicy>::cbegin() const
+	{
+		return const_iterator(m_Data);
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline typename mapped_vector<T, GrowthPolicy>::const_iterator
+		mapped_vector<T, GrowthPolicy>::cend() const
+	{
+		return const_iterator(m_Data + size());
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline typename mapped_vector<T, GrowthPolicy>::const_iterator
+		mapped_vector<T, GrowthPolicy>::begin() const
+	{
+		return cbegin();
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline typename mapped_vector<T, GrowthPolicy>::const_iterator
+		mapped_vector<T, GrowthPolicy>::end() const
+	{
+		return cend();
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline typename mapped_vector<T, GrowthPolicy>::iterator
+		mapped_vector<T, GrowthPolicy>::begin()
+	{
+		check_writable();
+		return iterator(m_Data);
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline typename mapped_vector<T, GrowthPolicy>::iterator
+		mapped_vector<T, GrowthPolicy>::end()
+	{
+		check_writable();
+		return iterator(m_Data + size());
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline typename mapped_vector<T, GrowthPolicy>::const_reverse_iterator
+		mapped_vector<T, GrowthPolicy>::crbegin() const
+	{
+		return const_reverse_iterator(m_Data + size() - 1);
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline typename mapped_vector<T, GrowthPolicy>::const_reverse_iterator
+		mapped_vector<T, GrowthPolicy>::crend() const
+	{
+		return const_reverse_iterator(m_Data - 1);
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline typename mapped_vector<T, GrowthPolicy>::reverse_iterator
+		mapped_vector<T, GrowthPolicy>::rbegin()
+	{
+		check_writable();
+		return reverse_iterator(m_Data + size() - 1);
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline typename mapped_vector<T, GrowthPolicy>::reverse_iterator
+		mapped_vector<T, GrowthPolicy>::rend()
+	{
+		check_writable();
+		return reverse_iterator(m_Data - 1);
+	}
+
+	// every mutator and every accessor handing out a writable reference checks
+	// up front: writing through a PROT_READ mapping would fault. a read only
+	// vector is read through the const overloads (std::as_const, cbegin)
+	template<typename T, class GrowthPolicy>
+	inline void
+		mapped_vector<T, GrowthPolicy>::check_writable() const
+	{
+		if (m_ReadOnly)
+			throw std::logic_error("mapped_vector: the file is mapped read only");
+	}
+
+	// resizes the file to hold newCapacity elements and maps the new length.
+	// linux moves the mapping with mremap, elsewhere it is mapped again
+	template<typename T, class GrowthPolicy>
+	inline void
+		mapped_vector<T, GrowthPolicy>::remap(const size_t& newCapacity)
+	{
+		check_writable();
+
+		size_t oldBytes = m_MapBytes;
+		size_t newBytes = header_bytes + newCapacity * sizeof(T);
+
+		// the old length stays mapped until the new one exists, so a failure
+		// leaves the vector as it was
+		if (newBytes > oldBytes && ftruncate(m_File, (off_t)newBytes) != 0)
+			fail("mapped_vector: ftruncate");
+
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+		void* map = mremap(m_Header, oldBytes, newBytes, MREMAP_MAYMOVE);
+#else
+		void* map = mmap(nullptr, newBytes, PROT_READ | PROT_WRITE, MAP_SHARED, m_File, 0);
+		if (map != MAP_FAILED)
+			munmap(m_Header, oldBytes);
+#endif
+
+		if (map == MAP_FAILED)
+			fail("mapped_vector: remap");
+
+		m_Header = static_cast<header*>(map);
+		m_Data = reinterpret_cast<pointer_type>(static_cast<unsigned char*>(map) + header_bytes);
+		m_Header->capacity = newCapacity;
+		m_MapBytes = newBytes;
+		m_Capacity = newCapacity;
+
+		if (newBytes < oldBytes && ftruncate(m_File, (off_t)newBytes) != 0)
+			fail("mapped_vector: ftruncate");
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline void
+		mapped_vector<T, GrowthPolicy>::grow(const size_t& required)
+	{
+		if (required > m_Capacity)
+			remap(GrowthPolicy::next_capacity(m_Capacity, required, sizeof(T)));
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline void
+		mapped_vector<T, GrowthPolicy>::close()
+	{
+		if (m_Header)
+			munmap(m_Header, m_MapBytes);
+
+		if (m_File >= 0)
+			::close(m_File);
+
+		m_File = -1;
+		m_Header = nullptr;
+		m_Data = nullptr;
+		m_MapBytes = 0;
+		m_Capacity = 0;
+	}
+
+	// closes what the constructor opened before reporting errno
+	template<typename T, class GrowthPolicy>
+	inline void
+		mapped_vector<T, GrowthPolicy>::abandon(const char* what)
+	{
+		int error = errno;
+		close();
+
+		throw std::system_error(error, std::generic_category(), what);
+	}
+
+	template<typename T, class GrowthPolicy>
+	inline void
+		mapped_vector<T, GrowthPolicy>::fail(const char* what)
+	{
+		throw std::system_error(errno, std::generic_category(), what);
+	}
+}
+
+#endif
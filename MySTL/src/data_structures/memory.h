@@ -0,0 +1,103 @@
+#ifndef MEMORY_H
+#define MEMORY_H
+
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// memory																			///
+///																					///
+/// This file holds the relocation layer used by the contiguous containers.			///
+/// Types that are trivially relocatable can be moved to a new address with a		///
+/// plain memcpy/memmove instead of a move construct followed by a destroy.			///
+/// Every trivially copyable type qualifies by default. Other types opt in by		///
+/// specializing mystl::is_trivially_relocatable.									///
+///																					///
+///////////////////////////////////////////////////////////////////////////////////////
+
+namespace mystl
+{
+	// opt-in trait: specialize for types whose bits can be moved and the source
+	// forgotten (e.g. types that only hold an owning pointer)
+	template<typename T>
+	struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>> { };
+
+	template<typename T>
+	inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+	// destroys count elements starting at first
+	template<typename T>
+	inline void
+		destroy(T* first, const size_t& count)
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>)
+		{
+			for (size_t i = 0; i < count; i++)
+				first[i].~T();
+		}
+	}
+
+	// copy constructs count elements from source into uninitialized dest
+	template<typename T>
+	inline void
+		uninitialized_copy(const T* source, const size_t& count, T* dest)
+	{
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			if (count)
+				std::memcpy(static_cast<void*>(dest), static_cast<const void*>(source), count * sizeof(T));
+		}
+		else
+		{
+			for (size_t i = 0; i < count; i++)
+				new(&dest[i]) T(source[i]);
+		}
+	}
+
+	// moves count elements from source into uninitialized dest and ends the
+	// lifetime of the source elements. the ranges must not overlap
+	template<typename T>
+	inline void
+		relocate(T* dest, T* source, const size_t& count)
+	{
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			if (count)
+				std::memcpy(static_cast<void*>(dest), static_cast<const void*>(source), count * sizeof(T));
+		}
+		else
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				new(&dest[i]) T(std::move(source[i]));
+				source[i].~T();
+			}
+		}
+	}
+
+	// same as relocate, but the ranges may overlap (used to shift a tail in place)
+	template<typename T>
+	inline void
+		relocate_overlapping(T* dest, T* source, const size_t& count)
+	{
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			if (count)
+				std::memmove(static_cast<void*>(dest), static_cast<const void*>(source), count * sizeof(T));
+		}
+		else if (dest < source)
+			relocate(dest, source, count);
+		else
+		{
+			for (size_t i = count; i > 0; i--)
+			{
+				new(&dest[i - 1]) T(std::move(source[i - 1]));
+				source[i - 1].~T();
+			}
+		}
+	}
+}
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef NODE_H
 #define NODE_H
 
+#include <utility>
+
 // simple node struct
 namespace mystl
 {
@@ -19,6 +21,10 @@ namespace mystl
 	public:
 		constexpr node() : data(value_type()), next(nullptr), prev(nullptr) { }
 		constexpr node(const_reference_type& data) : data(data), next(nullptr), prev(nullptr) { }
+
+		// constructs data in place from args (used by emplace, avoids a copy)
+		template<typename... Args>
+		constexpr explicit node(std::in_place_t, Args&&... args) : data(std::forward<Args>(args)...), next(nullptr), prev(nullptr) { }
 		~node() = default;
 	};
 }
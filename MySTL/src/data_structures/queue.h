@@ -15,12 +15,13 @@
 
 namespace mystl
 {
-	template<typename T>
+	template<typename T, class Allocator = allocator<T>>
 	class queue
 	{
 	// typedefs
 	public:
 		using		value_type				= T;
+		using		allocator_type			= Allocator;
 
 		using		reference_type			= T&;
 		using		pointer_type			= T*;
@@ -31,6 +32,9 @@ namespace mystl
 	// constructor/destructor
 	public:
 		constexpr							queue();
+		constexpr	explicit				queue(const Allocator& allocator);
+		constexpr							queue(const queue& other) = default;
+		constexpr							queue(queue&& other) noexcept = default;
 
 	// element access
 	public:
@@ -55,90 +59,108 @@ namespace mystl
 
 		constexpr	value_type				pop();
 
+	// mutator functions
+	public:
+					void					swap(queue& other);
+
+	// operators
+	public:
+		constexpr	queue&					operator=(const queue& other) = default;
+		constexpr	queue&					operator=(queue&& other) noexcept = default;
+
 	// variables
 	private:
-		deque<T> m_Data;
+		deque<T, Allocator> m_Data;
 	};
 
-	template<typename T>
-	constexpr queue<T>::queue() : m_Data()
+	template<typename T, class Allocator>
+	constexpr queue<T, Allocator>::queue() : m_Data()
 	{
 
 	}
 
-	template<typename T>
-	constexpr typename queue<T>::reference_type
-		queue<T>::front()
+	template<typename T, class Allocator>
+	constexpr queue<T, Allocator>::queue(const Allocator& allocator) : m_Data(allocator)
+	{
+
+	}
+
+	template<typename T, class Allocator>
+	constexpr typename queue<T, Allocator>::reference_type
+		queue<T, Allocator>::front()
 	{
 		return m_Data.front();
 	}
 
-	template<typename T>
-	constexpr typename queue<T>::const_reference_type
-		queue<T>::front() const
+	template<typename T, class Allocator>
+	constexpr typename queue<T, Allocator>::const_reference_type
+		queue<T, Allocator>::front() const
 	{
 		return m_Data.front();
 	}
 
-	template<typename T>
-	constexpr typename queue<T>::reference_type
-		queue<T>::back()
+	template<typename T, class Allocator>
+	constexpr typename queue<T, Allocator>::reference_type
+		queue<T, Allocator>::back()
 	{
 		return m_Data.back();
 	}
 
-	template<typename T>
-	constexpr typename queue<T>::const_reference_type
-		queue<T>::back() const
+	template<typename T, class Allocator>
+	constexpr typename queue<T, Allocator>::const_reference_type
+		queue<T, Allocator>::back() const
 	{
 		return m_Data.back();
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	constexpr size_t 
-		queue<T>::size() const
+		queue<T, Allocator>::size() const
 	{
 		return m_Data.size();
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	constexpr bool 
-		queue<T>::empty() const
+		queue<T, Allocator>::empty() const
 	{
 		return m_Data.empty();
 	}
 
-	template<typename T>
-	constexpr typename queue<T>::reference_type
-		queue<T>::push(T&& element)
+	template<typename T, class Allocator>
+	constexpr typename queue<T, Allocator>::reference_type
+		queue<T, Allocator>::push(T&& element)
 	{
-		return m_Data.push_back(element);
+		return m_Data.push_back(std::move(element));
 	}
 
-	template<typename T>
-	constexpr typename queue<T>::reference_type
-		queue<T>::push(const_reference_type element)
+	template<typename T, class Allocator>
+	constexpr typename queue<T, Allocator>::reference_type
+		queue<T, Allocator>::push(const_reference_type element)
 	{
 		return m_Data.push_back(element);
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	template<typename ...Args>
-	constexpr typename queue<T>::reference_type
-		queue<T>::emplace(Args && ...args)
+	constexpr typename queue<T, Allocator>::reference_type
+		queue<T, Allocator>::emplace(Args && ...args)
 	{
 		return m_Data.emplace_back(std::forward<Args>(args)...);
 	}
 
-	template<typename T>
-	constexpr typename queue<T>::value_type
-		queue<T>::pop()
+	template<typename T, class Allocator>
+	constexpr typename queue<T, Allocator>::value_type
+		queue<T, Allocator>::pop()
 	{
-		auto val = m_Data.front();
-
-		m_Data.pop_front();
+		return m_Data.pop_front();
+	}
 
-		return val;
+	template<typename T, class Allocator>
+	inline void
+		queue<T, Allocator>::swap(queue& other)
+	{
+		m_Data.swap(other.m_Data);
 	}
 }
 
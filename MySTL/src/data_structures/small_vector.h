@@ -0,0 +1,290 @@
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include "vector.h"
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// small_vector																	///
+///																					///
+/// This class is a vector that keeps up to N elements inline and only spills		///
+/// to the heap once it overflows. It is built on mystl::vector: the inline			///
+/// buffer is handed to the vector through an allocator that returns it for			///
+/// any request of N elements or fewer. The API and iterator types are the ones		///
+/// from vector.h.																	///
+///																					///
+///////////////////////////////////////////////////////////////////////////////////////
+
+// inline_buffer_allocator
+namespace mystl
+{
+	template<typename T, size_t N, class Allocator = allocator<T>>
+	class inline_buffer_allocator
+	{
+	// typedefs
+	public:
+		using		value_type				= T;
+		using		pointer_type			= T*;
+
+		template<typename U>
+		struct rebind { using other = rebind_allocator<Allocator, U>; };
+
+	// constructor/destructor
+	public:
+		constexpr							inline_buffer_allocator(pointer_type buffer, const Allocator& fallback = Allocator());
+
+	// allocation functions
+	public:
+		[[nodiscard]] pointer_type			allocate(const size_t& count);
+					void					deallocate(pointer_type ptr, const size_t& count);
+
+	// accessors
+	public:
+		constexpr	const Allocator&		fallback() const;
+
+	// equality operators
+	public:
+		constexpr	bool					operator==(const inline_buffer_allocator& other) const;
+		constexpr	bool					operator!=(const inline_buffer_allocator& other) const;
+
+	// variables
+	private:
+					pointer_type			m_Buffer	= nullptr;
+					Allocator				m_Fallback{};
+	};
+
+	template<typename T, size_t N, class Allocator>
+	constexpr inline_buffer_allocator<T, N, Allocator>::inline_buffer_allocator(pointer_type buffer, const Allocator& fallback) : m_Buffer(buffer), m_Fallback(fallback)
+	{ }
+
+	template<typename T, size_t N, class Allocator>
+	inline typename inline_buffer_allocator<T, N, Allocator>::pointer_type
+		inline_buffer_allocator<T, N, Allocator>::allocate(const size_t& count)
+	{
+		if (count <= N)
+			return m_Buffer;
+
+		return m_Fallback.allocate(count);
+	}
+
+	template<typename T, size_t N, class Allocator>
+	inline void
+		inline_buffer_allocator<T, N, Allocator>::deallocate(pointer_type ptr, const size_t& count)
+	{
+		if (ptr != m_Buffer)
+			m_Fallback.deallocate(ptr, count);
+	}
+
+	template<typename T, size_t N, class Allocator>
+	constexpr const Allocator&
+		inline_buffer_allocator<T, N, Allocator>::fallback() const
+	{
+		return m_Fallback;
+	}
+
+	template<typename T, size_t N, class Allocator>
+	constexpr bool
+		inline_buffer_allocator<T, N, Allocator>::operator==(const inline_buffer_allocator& other) const
+	{
+		return m_Buffer == other.m_Buffer;
+	}
+
+	template<typename T, size_t N, class Allocator>
+	constexpr bool
+		inline_buffer_allocator<T, N, Allocator>::operator!=(const inline_buffer_allocator& other) const
+	{
+		return !(*this == other);
+	}
+}
+
+// small_vector
+namespace mystl
+{
+	// raw inline storage, kept in a base class so it exists before the vector
+	// base is constructed and asks the allocator for its first block
+	template<typename T, size_t N>
+	struct small_vector_storage
+	{
+		alignas(T) unsigned char m_Storage[N * sizeof(T)];
+
+		constexpr T* buffer() { return reinterpret_cast<T*>(m_Storage); }
+		constexpr const T* buffer() const { return reinterpret_cast<const T*>(m_Storage); }
+	};
+
+	// the vector base is private: a copy of it would keep the allocator and so
+	// point at this object's inline buffer. its API is re-exported below
+	template<typename T, size_t N, class GrowthPolicy = growth::standard, class Allocator = allocator<T>>
+	class small_vector : private small_vector_storage<T, N>, private vector<T, GrowthPolicy, inline_buffer_allocator<T, N, Allocator>>
+	{
+		static_assert(N > 0, "small_vector needs at least one inline element");
+
+	// base class
+	public:
+		using		storage_class			= small_vector_storage<T, N>;
+		using		base_class				= vector<T, GrowthPolicy, inline_buffer_allocator<T, N, Allocator>>;
+
+	// typedefs
+	public:
+		using		value_type				= typename base_class::value_type;
+		using		allocator_type			= typename base_class::allocator_type;
+
+		using		reference_type			= typename base_class::reference_type;
+		using		pointer_type			= typename base_class::pointer_type;
+
+		using		const_reference_type	= typename base_class::const_reference_type;
+		using		const_pointer_type		= typename base_class::const_pointer_type;
+
+		using		const_iterator			= typename base_class::const_iterator;
+		using		iterator				= typename base_class::iterator;
+
+		using		const_reverse_iterator	= typename base_class::const_reverse_iterator;
+		using		reverse_iterator		= typename base_class::reverse_iterator;
+
+	// constructor/destructor
+	public:
+		constexpr							small_vector();
+		constexpr	explicit				small_vector(const Allocator& allocator);
+		constexpr							small_vector(const size_t& count, const_reference_type fillElement);
+		constexpr							small_vector(const small_vector& other);
+		constexpr							small_vector(small_vector&& other);
+											~small_vector() = default;
+
+	// size functions
+	public:
+		using		base_class::size;
+		using		base_class::max_size;
+		using		base_class::capacity;
+		using		base_class::empty;
+		using		base_class::growth_policy;
+		using		base_class::get_allocator;
+		using		base_class::telemetry_stats;
+
+		constexpr	bool					is_inline() const;
+		static constexpr size_t				inline_capacity();
+
+	// access functions
+	public:
+		using		base_class::operator[];
+		using		base_class::at;
+		using		base_class::front;
+		using		base_class::back;
+		using		base_class::data;
+
+	// mutator functions
+	public:
+		using		base_class::push_back;
+		using		base_class::emplace_back;
+		using		base_class::emplace;
+		using		base_class::insert;
+		using		base_class::erase;
+		using		base_class::append;
+		using		base_class::assign;
+		using		base_class::pop_back;
+		using		base_class::clear;
+		using		base_class::reserve;
+		using		base_class::resize;
+		using		base_class::resize_default_init;
+		using		base_class::shrink_to_fit;
+
+					void					swap(small_vector& other);
+
+	// operators
+	public:
+		constexpr	small_vector&			operator=(const small_vector& other);
+		constexpr	small_vector&			operator=(small_vector&& other);
+
+	// iterator functions
+	public:
+		using		base_class::cbegin;
+		using		base_class::cend;
+		using		base_class::begin;
+		using		base_class::end;
+		using		base_class::crbegin;
+		using		base_class::crend;
+		using		base_class::rbegin;
+		using		base_class::rend;
+	};
+
+	template<typename T, size_t N, class GrowthPolicy, class Allocator>
+	constexpr small_vector<T, N, GrowthPolicy, Allocator>::small_vector() : storage_class(), base_class(N, allocator_type(storage_class::buffer()))
+	{
+
+	}
+
+	template<typename T, size_t N, class GrowthPolicy, class Allocator>
+	constexpr small_vector<T, N, GrowthPolicy, Allocator>::small_vector(const Allocator& allocator) : storage_class(), base_class(N, allocator_type(storage_class::buffer(), allocator))
+	{
+
+	}
+
+	template<typename T, size_t N, class GrowthPolicy, class Allocator>
+	constexpr small_vector<T, N, GrowthPolicy, Allocator>::small_vector(const size_t& count, const_reference_type fillElement) : small_vector()
+	{
+		if (count > N)
+			base_class::reserve(count);
+
+		for (size_t i = 0; i < count; i++)
+			base_class::emplace_back(fillElement);
+	}
+
+	template<typename T, size_t N, class GrowthPolicy, class Allocator>
+	constexpr small_vector<T, N, GrowthPolicy, Allocator>::small_vector(const small_vector& other) : small_vector(other.get_allocator().fallback())
+	{
+		*this = other;
+	}
+
+	// a spilled vector hands over its heap block. the inline buffer cannot
+	// change owners, so inline elements are relocated instead
+	template<typename T, size_t N, class GrowthPolicy, class Allocator>
+	constexpr small_vector<T, N, GrowthPolicy, Allocator>::small_vector(small_vector&& other) : small_vector(other.get_allocator().fallback())
+	{
+		*this = std::move(other);
+	}
+
+	template<typename T, size_t N, class GrowthPolicy, class Allocator>
+	constexpr bool
+		small_vector<T, N, GrowthPolicy, Allocator>::is_inline() const
+	{
+		return base_class::data() == storage_class::buffer();
+	}
+
+	template<typename T, size_t N, class GrowthPolicy, class Allocator>
+	constexpr size_t
+		small_vector<T, N, GrowthPolicy, Allocator>::inline_capacity()
+	{
+		return N;
+	}
+
+	template<typename T, size_t N, class GrowthPolicy, class Allocator>
+	inline void
+		small_vector<T, N, GrowthPolicy, Allocator>::swap(small_vector& other)
+	{
+		base_class::swap(other);
+	}
+
+	template<typename T, size_t N, class GrowthPolicy, class Allocator>
+	constexpr small_vector<T, N, GrowthPolicy, Allocator>&
+		small_vector<T, N, GrowthPolicy, Allocator>::operator=(const small_vector& other)
+	{
+		base_class::operator=(other);
+		return *this;
+	}
+
+	// a heap block from the same fallback allocator is taken over as is. the
+	// moved-from vector is left without storage, like a moved-from vector
+	template<typename T, size_t N, class GrowthPolicy, class Allocator>
+	constexpr small_vector<T, N, GrowthPolicy, Allocator>&
+		small_vector<T, N, GrowthPolicy, Allocator>::operator=(small_vector&& other)
+	{
+		if (this == &other)
+			return *this;
+
+		if (other.data() && !other.is_inline() && get_allocator().fallback() == other.get_allocator().fallback())
+			base_class::take_block(other);
+		else
+			base_class::operator=(std::move(other));
+
+		return *this;
+	}
+}
+
+#endif
@@ -0,0 +1,624 @@
+#ifndef SOA_VECTOR_H
+#define SOA_VECTOR_H
+
+#include <cstddef>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "growth_policy.h"
+#include "iterator.h"
+#include "memory.h"
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// soa_vector																		///
+///																					///
+/// This class is a vector of rows stored as a structure of arrays: every field		///
+/// of soa_vector<Ts...> lives in its own contiguous column, so a loop over one		///
+/// field reads only that field's cache lines. The columns share one size and		///
+/// capacity and sit in a single block, each one aligned to a cache line.			///
+/// Rows are read and written through tuples of references (proxy references),		///
+/// and column<I>() hands out a std::span that the algorithms, simd kernels			///
+/// included, take as any other contiguous range.									///
+///																					///
+///////////////////////////////////////////////////////////////////////////////////////
+
+// soa_row
+namespace mystl
+{
+	// proxy reference to one row: a tuple of references into the columns.
+	// assigning to it writes every field, and swap() exchanges the fields of
+	// two rows, so mutating algorithms (mystl::sort, std::sort) can move rows
+	template<typename... Ts>
+	class soa_row : public std::tuple<Ts&...>
+	{
+	// constructors
+	public:
+		constexpr							soa_row(Ts&... fields);
+
+	// operators
+	public:
+		using		std::tuple<Ts&...>::operator=;
+	};
+
+	template<typename... Ts>
+	constexpr soa_row<Ts...>::soa_row(Ts&... fields) : std::tuple<Ts&...>(fields...)
+	{
+
+	}
+
+	// rows are prvalues, so they are taken by value and swapped field by field
+	template<typename... Ts>
+	constexpr void
+		swap(soa_row<Ts...> a, soa_row<Ts...> b)
+	{
+		std::apply([&b](Ts&... left)
+		{
+			std::apply([&left...](Ts&... right)
+			{
+				using std::swap;
+				(swap(left, right), ...);
+			}, b);
+		}, a);
+	}
+}
+
+// structured bindings see a row as the tuple it wraps
+template<typename... Ts>
+struct std::tuple_size<mystl::soa_row<Ts...>> : std::integral_constant<size_t, sizeof...(Ts)> { };
+
+template<size_t I, typename... Ts>
+struct std::tuple_element<I, mystl::soa_row<Ts...>> : std::tuple_element<I, std::tuple<Ts&...>> { };
+
+// soa_vector
+namespace mystl
+{
+	template<typename... Ts>
+	class soa_vector
+	{
+		static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one column");
+
+	// typedefs
+	public:
+		using		value_type				= std::tuple<Ts...>;
+
+		using		reference_type			= soa_row<Ts...>;
+		using		const_reference_type	= std::tuple<const Ts&...>;
+
+		using		const_iterator			= mystl::index_iterator<soa_vector<Ts...>, true>;
+		using		iterator				= mystl::index_iterator<soa_vector<Ts...>, false>;
+
+		using		growth_policy			= growth::standard;
+
+		template<size_t I>
+		using		column_type				= std::tuple_element_t<I, value_type>;
+
+		static constexpr size_t				columns				= sizeof...(Ts);
+		static constexpr size_t				column_alignment	= 64;
+
+		static_assert(((alignof(Ts) <= column_alignment) && ...), "soa_vector aligns its columns to 64 bytes");
+
+	// constructor/destructor
+	public:
+		constexpr							soa_vector() = default;
+		constexpr	explicit				soa_vector(const size_t& capacity);
+											soa_vector(const soa_vector& other);
+											soa_vector(soa_vector&& other) noexcept;
+											~soa_vector();
+
+	// size functions
+	public:
+		constexpr	size_t					size() const;
+		constexpr	size_t					capacity() const;
+		constexpr	bool					empty() const;
+
+	// access functions
+	public:
+		constexpr	reference_type			operator[](const size_t& index);
+		constexpr	const_reference_type	operator[](const size_t& index) const;
+
+		constexpr	reference_type			front();
+		constexpr	reference_type			back();
+
+		constexpr	const_reference_type	front() const;
+		constexpr	const_reference_type	back() const;
+
+		// one field of every row, as a contiguous range
+		template<size_t I>
+		constexpr	std::span<column_type<I>>		column();
+		template<size_t I>
+		constexpr	std::span<const column_type<I>>	column() const;
+
+		template<size_t I>
+		constexpr	column_type<I>*			data();
+		template<size_t I>
+		constexpr	const column_type<I>*	data() const;
+
+	// mutator functions
+	public:
+		template<typename... Args> requires (sizeof...(Args) == sizeof...(Ts))
+		constexpr	reference_type			emplace_back(Args&&... args);
+
+		constexpr	reference_type			push_back(const value_type& row);
+		constexpr	reference_type			push_back(value_type&& row);
+
+		constexpr	value_type				pop_back();
+
+					void					clear();
+					void					reserve(const size_t& size);
+					void					resize(const size_t& size);
+					void					shrink_to_fit();
+					void					swap(soa_vector& other);
+
+	// operators
+	public:
+					soa_vector&				operator=(const soa_vector& other);
+					soa_vector&				operator=(soa_vector&& other) noexcept;
+
+	// iterator functions
+	public:
+		constexpr	const_iterator			cbegin() const;
+		constexpr	const_iterator			cend() const;
+
+		constexpr	iterator				begin();
+		constexpr	iterator				end();
+
+		constexpr	const_iterator			begin() const;
+		constexpr	const_iterator			end() const;
+
+	// helpers
+	private:
+		using		column_pointers			= std::tuple<Ts*...>;
+		using		indices					= std::index_sequence_for<Ts...>;
+
+		static		size_t					block_bytes(const size_t& capacity);
+		static		column_pointers			carve(unsigned char* block, const size_t& capacity);
+
+					void					realloc(const size_t& newCapacity);
+					void					release();
+
+		template<size_t... I, typename... Args>
+		static		void					construct_row(column_pointers& dest, const size_t& index, std::index_sequence<I...>, Args&&... args);
+		template<size_t... I>
+		static		void					destroy_rows(column_pointers& pointers, const size_t& first, const size_t& count, std::index_sequence<I...>);
+		template<size_t... I>
+		static		void					relocate_rows(column_pointers& dest, column_pointers& source, const size_t& count, std::index_sequence<I...>);
+		template<size_t... I>
+		constexpr	reference_type			row(const size_t& index, std::index_sequence<I...>);
+		template<size_t... I>
+		constexpr	const_reference_type	row(const size_t& index, std::index_sequence<I...>) const;
+
+	// variables
+	private:
+					unsigned char*			m_Block		= nullptr;
+					column_pointers			m_Columns{};
+					size_t					m_Size		= 0;
+					size_t					m_Capacity	= 0;
+	};
+
+	template<typename... Ts>
+	constexpr soa_vector<Ts...>::soa_vector(const size_t& capacity)
+	{
+		reserve(capacity);
+	}
+
+	template<typename... Ts>
+	inline soa_vector<Ts...>::soa_vector(const soa_vector& other)
+	{
+		*this = other;
+	}
+
+	template<typename... Ts>
+	inline soa_vector<Ts...>::soa_vector(soa_vector&& other) noexcept
+	{
+		swap(other);
+	}
+
+	template<typename... Ts>
+	inline soa_vector<Ts...>::~soa_vector()
+	{
+		release();
+	}
+
+	template<typename... Ts>
+	constexpr size_t
+		soa_vector<Ts...>::size() const
+	{
+		return m_Size;
+	}
+
+	template<typename... Ts>
+	constexpr size_t
+		soa_vector<Ts...>::capacity() const
+	{
+		return m_Capacity;
+	}
+
+	template<typename... Ts>
+	constexpr bool
+		soa_vector<Ts...>::empty() const
+	{
+		return m_Size == 0;
+	}
+
+	template<typename... Ts>
+	constexpr typename soa_vector<Ts...>::reference_type
+		soa_vector<Ts...>::operator[](const size_t& index)
+	{
+		return row(index, indices{});
+	}
+
+	template<typename... Ts>
+	constexpr typename soa_vector<Ts...>::const_reference_type
+		soa_vector<Ts...>::operator[](const size_t& index) const
+	{
+		return row(index, indices{});
+	}
+
+	template<typename... Ts>
+	constexpr typename soa_vector<Ts...>::reference_type
+		soa_vector<Ts...>::front()
+	{
+		return row(0, indices{});
+	}
+
+	template<typename... Ts>
+	constexpr typename soa_vector<Ts...>::reference_type
+		soa_vector<Ts...>::back()
+	{
+		return row(m_Size - 1, indices{});
+	}
+
+	template<typename... Ts>
+	constexpr typename soa_vector<Ts...>::const_reference_type
+		soa_vector<Ts...>::front() const
+	{
+		return row(0, indices{});
+	}
+
+	template<typename... Ts>
+	constexpr typename soa_vector<Ts...>::const_reference_type
+		soa_vector<Ts...>::back() const
+	{
+		return row(m_Size - 1, indices{});
+	}
+
+	template<typename... Ts>
+	template<size_t I>
+	constexpr std::span<typename soa_vector<Ts...>::template column_type<I>>
+		soa_vector<Ts...>::column()
+	{
+		return { std::get<I>(m_Columns), m_Size };
+	}
+
+	template<typename... Ts>
+	template<size_t I>
+	constexpr std::span<const typename soa_vector<Ts...>::template column_type<I>>
+		soa_vector<Ts...>::column() const
+	{
+		return { std::get<I>(m_Columns), m_Size };
+	}
+
+	template<typename... Ts>
+	template<size_t I>
+	constexpr typename soa_vector<Ts...>::template column_type<I>*
+		soa_vector<Ts...>::data()
+	{
+		return std::get<I>(m_Columns);
+	}
+
+	template<typename... Ts>
+	template<size_t I>
+	constexpr const typename soa_vector<Ts...>::template column_type<I>*
+		soa_vector<Ts...>::data() const
+	{
+		return std::get<I>(m_Columns);
+	}
+
+	// builds the row in the new block before the old one is released, so
+	// arguments that refer to existing rows stay valid while growing
+	template<typename... Ts>
+	template<typename... Args> requires (sizeof...(Args) == sizeof...(Ts))
+	constexpr typename soa_vector<Ts...>::reference_type
+		soa_vector<Ts...>::emplace_back(Args&&... args)
+	{
+		if (m_Size < m_Capacity)
+			construct_row(m_Columns, m_Size, indices{}, std::forward<Args>(args)...);
+		else
+		{
+			size_t newCapacity = growth_policy::next_capacity(m_Capacity, m_Size + 1, (sizeof(Ts) + ...));
+			unsigned char* block = static_cast<unsigned char*>(::operator new(block_bytes(newCapacity), std::align_val_t(column_alignment)));
+			column_pointers newColumns = carve(block, newCapacity);
+
+			try
+			{
+				construct_row(newColumns, m_Size, indices{}, std::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				::operator delete(block, std::align_val_t(column_alignment));
+				throw;
+			}
+
+			relocate_rows(newColumns, m_Columns, m_Size, indices{});
+			::operator delete(m_Block, std::align_val_t(column_alignment));
+
+			m_Block = block;
+			m_Columns = newColumns;
+			m_Capacity = newCapacity;
+		}
+
+		return row(m_Size++, indices{});
+	}
+
+	template<typename... Ts>
+	constexpr typename soa_vector<Ts...>::reference_type
+		soa_vector<Ts...>::push_back(const value_type& row)
+	{
+		return std::apply([this](const Ts&... fields) -> reference_type { return emplace_back(fields...); }, row);
+	}
+
+	template<typename... Ts>
+	constexpr typename soa_vector<Ts...>::reference_type
+		soa_vector<Ts...>::push_back(value_type&& row)
+	{
+		return std::apply([this](Ts&... fields) -> reference_type { return emplace_back(std::move(fields)...); }, row);
+	}
+
+	template<typename... Ts>
+	constexpr typename soa_vector<Ts...>::value_type
+		soa_vector<Ts...>::pop_back()
+	{
+		if (empty())
+			return value_type();
+
+		value_type last = std::apply([](Ts&... fields) { return value_type(std::move(fields)...); }, row(m_Size - 1, indices{}));
+		destroy_rows(m_Columns, --m_Size, 1, indices{});
+
+		return last;
+	}
+
+	template<typename... Ts>
+	inline void
+		soa_vector<Ts...>::clear()
+	{
+		destroy_rows(m_Columns, 0, m_Size, indices{});
+		m_Size = 0;
+	}
+
+	template<typename... Ts>
+	inline void
+		soa_vector<Ts...>::reserve(const size_t& size)
+	{
+		if (size > m_Capacity)
+			realloc(size);
+	}
+
+	// new rows are value-initialized
+	template<typename... Ts>
+	inline void
+		soa_vector<Ts...>::resize(const size_t& size)
+	{
+		if (size < m_Size)
+		{
+			destroy_rows(m_Columns, size, m_Size - size, indices{});
+			m_Size = size;
+			return;
+		}
+
+		reserve(size);
+
+		while (m_Size < size)
+			emplace_back(Ts()...);
+	}
+
+	template<typename... Ts>
+	inline void
+		soa_vector<Ts...>::shrink_to_fit()
+	{
+		if (m_Capacity > m_Size)
+			realloc(m_Size);
+	}
+
+	template<typename... Ts>
+	inline void
+		soa_vector<Ts...>::swap(soa_vector& other)
+	{
+		std::swap(m_Block, other.m_Block);
+		std::swap(m_Columns, other.m_Columns);
+		std::swap(m_Size, other.m_Size);
+		std::swap(m_Capacity, other.m_Capacity);
+	}
+
+	template<typename... Ts>
+	inline soa_vector<Ts...>&
+		soa_vector<Ts...>::operator=(const soa_vector& other)
+	{
+		if (this == &other)
+			return *this;
+
+		clear();
+		reserve(other.m_Size);
+
+		for (size_t i = 0; i < other.m_Size; i++)
+			std::apply([this](const Ts&... fields) { emplace_back(fields...); }, other[i]);
+
+		return *this;
+	}
+
+	template<typename... Ts>
+	inline soa_vector<Ts...>&
+		soa_vector<Ts...>::operator=(soa_vector&& other) noexcept
+	{
+		if (this != &other)
+		{
+			release();
+			swap(other);
+		}
+
+		return *this;
+	}
+
+	template<typename... Ts>
+	constexpr typename soa_vector<Ts...>::const_iterator
+		soa_vector<Ts...>::cbegin() const
+	{
+		return const_iterator(this, 0);
+	}
+
+	template<typename... Ts>
+	constexpr typename soa_vector<Ts...>::const_iterator
+		soa_vector<Ts...>::cend() const
+	{
+		return const_iterator(this, m_Size);
+	}
+
+	template<typename... Ts>
+	constexpr typename soa_vector<Ts...>::iterator
+		soa_vector<Ts...>::begin()
+	{
+		return iterator(this, 0);
+	}
+
+	template<typename... Ts>
+	constexpr typename soa_vector<Ts...>::iterator
+		soa_vector<Ts...>::end()
+	{
+		return iterator(this, m_Size);
+	}
+
+	template<typename... Ts>
+	constexpr typename soa_vector<Ts...>::const_iterator
+		soa_vector<Ts...>::begin() const
+	{
+		return cbegin();
+	}
+
+	template<typename... Ts>
+	constexpr typename soa_vector<Ts...>::const_iterator
+		soa_vector<Ts...>::end() const
+	{
+		return cend();
+	}
+
+	// columns follow each other in the block, each one starting on a cache line
+	template<typename... Ts>
+	inline size_t
+		soa_vector<Ts...>::block_bytes(const size_t& capacity)
+	{
+		size_t bytes = 0;
+		((bytes += (capacity * sizeof(Ts) + column_alignment - 1) & ~(column_alignment - 1)), ...);
+
+		return bytes;
+	}
+
+	template<typename... Ts>
+	inline typename soa_vector<Ts...>::column_pointers
+		soa_vector<Ts...>::carve(unsigned char* block, const size_t& capacity)
+	{
+		size_t offset = 0;
+
+		// braced initialization runs the carving left to right
+		return column_pointers{ [&]()
+		{
+			Ts* column = reinterpret_cast<Ts*>(block + offset);
+			offset += (capacity * sizeof(Ts) + column_alignment - 1) & ~(column_alignment - 1);
+			return column;
+		}()... };
+	}
+
+	// same steps as vector::realloc: new block, relocate every column, free
+	// the old block. the capacity never drops below the size
+	template<typename... Ts>
+	inline void
+		soa_vector<Ts...>::realloc(const size_t& newCapacity)
+	{
+		if (newCapacity == 0)
+		{
+			release();
+			return;
+		}
+
+		unsigned char* block = static_cast<unsigned char*>(::operator new(block_bytes(newCapacity), std::align_val_t(column_alignment)));
+		column_pointers newColumns = carve(block, newCapacity);
+
+		relocate_rows(newColumns, m_Columns, m_Size, indices{});
+
+		if (m_Block)
+			::operator delete(m_Block, std::align_val_t(column_alignment));
+
+		m_Block = block;
+		m_Columns = newColumns;
+		m_Capacity = newCapacity;
+	}
+
+	template<typename... Ts>
+	inline void
+		soa_vector<Ts...>::release()
+	{
+		clear();
+
+		if (m_Block)
+			::operator delete(m_Block, std::align_val_t(column_alignment));
+
+		m_Block = nullptr;
+		m_Columns = column_pointers{};
+		m_Capacity = 0;
+	}
+
+	// constructs every field of one row. a field that throws destroys the
+	// fields built before it
+	template<typename... Ts>
+	template<size_t... I, typename... Args>
+	inline void
+		soa_vector<Ts...>::construct_row(column_pointers& dest, const size_t& index, std::index_sequence<I...>, Args&&... args)
+	{
+		size_t built = 0;
+
+		try
+		{
+			((new(&std::get<I>(dest)[index]) Ts(std::forward<Args>(args)), built++), ...);
+		}
+		catch (...)
+		{
+			((I < built ? std::get<I>(dest)[index].~Ts() : void()), ...);
+			throw;
+		}
+	}
+
+	template<typename... Ts>
+	template<size_t... I>
+	inline void
+		soa_vector<Ts...>::destroy_rows(column_pointers& pointers, const size_t& first, const size_t& count, std::index_sequence<I...>)
+	{
+		(destroy(std::get<I>(pointers) + first, count), ...);
+	}
+
+	template<typename... Ts>
+	template<size_t... I>
+	inline void
+		soa_vector<Ts...>::relocate_rows(column_pointers& dest, column_pointers& source, const size_t& count, std::index_sequence<I...>)
+	{
+		(relocate(std::get<I>(dest), std::get<I>(source), count), ...);
+	}
+
+	template<typename... Ts>
+	template<size_t... I>
+	constexpr typename soa_vector<Ts...>::reference_type
+		soa_vector<Ts...>::row(const size_t& index, std::index_sequence<I...>)
+	{
+		return reference_type(std::get<I>(m_Columns)[index]...);
+	}
+
+	template<typename... Ts>
+	template<size_t... I>
+	constexpr typename soa_vector<Ts...>::const_reference_type
+		soa_vector<Ts...>::row(const size_t& index, std::index_sequence<I...>) const
+	{
+		return const_reference_type(std::get<I>(m_Columns)[index]...);
+	}
+}
+
+#endif
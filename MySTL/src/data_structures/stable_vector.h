@@ -0,0 +1,521 @@
+#ifndef STABLE_VECTOR_H
+#define STABLE_VECTOR_H
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "allocator.h"
+#include "iterator.h"
+#include "memory.h"
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// stable_vector																	///
+///																					///
+/// This class is a segmented vector: elements live in blocks that never move.		///
+/// Block k holds FirstBlock << k elements, so the blocks double in size and an		///
+/// index maps to its block with one bit scan. Growing allocates the next block		///
+/// and copies nothing, so push_back has no O(n) spikes and pointers, references	///
+/// and iterators to elements stay valid until the element is removed. The spine	///
+/// is a fixed array of block pointers, which does not move either: one thread		///
+/// may push_back while others read the elements below size().						///
+///																					///
+///////////////////////////////////////////////////////////////////////////////////////
+
+namespace mystl
+{
+	template<typename T, size_t FirstBlock = 64, class Allocator = allocator<T>>
+	class stable_vector
+	{
+		static_assert(FirstBlock && !(FirstBlock & (FirstBlock - 1)), "the first block size must be a power of two");
+
+	// typedefs
+	public:
+		using		value_type				= T;
+		using		allocator_type			= Allocator;
+
+		using		reference_type			= T&;
+		using		pointer_type			= T*;
+
+		using		const_reference_type	= const T&;
+		using		const_pointer_type		= const T*;
+
+		using		const_iterator			= mystl::index_iterator<stable_vector<T, FirstBlock, Allocator>, true>;
+		using		iterator				= mystl::index_iterator<stable_vector<T, FirstBlock, Allocator>, false>;
+
+	// constructor/destructor
+	public:
+		constexpr							stable_vector() = default;
+		constexpr	explicit				stable_vector(const Allocator& allocator);
+		constexpr							stable_vector(const size_t& count, const_reference_type fillElement);
+		constexpr							stable_vector(const stable_vector& other);
+		constexpr							stable_vector(stable_vector&& other) noexcept;
+											~stable_vector();
+
+	// size functions
+	public:
+		constexpr	size_t					size() const;
+		constexpr	size_t					max_size() const;
+		constexpr	size_t					capacity() const;
+
+		constexpr	bool					empty() const;
+
+		// blocks allocated so far, and the elements in use in block k
+		constexpr	size_t					segment_count() const;
+		constexpr	std::span<T>			segment(const size_t& k);
+		constexpr	std::span<const T>		segment(const size_t& k) const;
+
+	// access functions
+	public:
+		constexpr	reference_type			operator[](const size_t& index);
+		constexpr	const_reference_type	operator[](const size_t& index) const;
+		constexpr	const_reference_type	at(const size_t& index) const;
+
+		constexpr	reference_type			front();
+		constexpr	reference_type			back();
+
+		constexpr	const_reference_type	front() const;
+		constexpr	const_reference_type	back() const;
+
+	// mutator functions
+	public:
+		constexpr	reference_type			push_back(T&& element);
+		constexpr	reference_type			push_back(const_reference_type element);
+
+		template<typename... Args>
+		constexpr	reference_type			emplace_back(Args&&... args);
+
+		constexpr	value_type				pop_back();
+
+					void					clear();
+					void					reserve(const size_t& size);
+					void					resize(const size_t& size);
+					void					shrink_to_fit();
+					void					swap(stable_vector& other);
+
+	// operators
+	public:
+		constexpr	stable_vector&			operator=(const stable_vector& other);
+		constexpr	stable_vector&			operator=(stable_vector&& other) noexcept;
+
+	// iterator functions
+	public:
+		constexpr	const_iterator			cbegin() const;
+		constexpr	const_iterator			cend() const;
+
+		constexpr	iterator				begin();
+		constexpr	iterator				end();
+
+		constexpr	const_iterator			begin() const;
+		constexpr	const_iterator			end() const;
+
+	// helpers
+	private:
+		static constexpr size_t				first_shift		= std::countr_zero(FirstBlock);
+		static constexpr size_t				max_blocks		= sizeof(size_t) * 8 - first_shift;
+
+		// block of index i, and where block k starts
+		static constexpr size_t				block_of(const size_t& index);
+		static constexpr size_t				block_start(const size_t& k);
+		static constexpr size_t				block_size(const size_t& k);
+
+		constexpr	pointer_type			slot(const size_t& index) const;
+		constexpr	void					add_block();
+		constexpr	void					destroy_elements();
+
+	// variables
+	private:
+					pointer_type			m_Blocks[max_blocks]	= {};
+					std::atomic<size_t>		m_BlockCount			= 0;
+					std::atomic<size_t>		m_Size					= 0;
+					Allocator				m_Allocator{};
+	};
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr stable_vector<T, FirstBlock, Allocator>::stable_vector(const Allocator& allocator) : m_Allocator(allocator)
+	{ }
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr stable_vector<T, FirstBlock, Allocator>::stable_vector(const size_t& count, const_reference_type fillElement)
+	{
+		reserve(count);
+		for (size_t i = 0; i < count; i++)
+			emplace_back(fillElement);
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr stable_vector<T, FirstBlock, Allocator>::stable_vector(const stable_vector& other) : m_Allocator(other.m_Allocator)
+	{
+		*this = other;
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr stable_vector<T, FirstBlock, Allocator>::stable_vector(stable_vector&& other) noexcept : m_Allocator(other.m_Allocator)
+	{
+		swap(other);
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	stable_vector<T, FirstBlock, Allocator>::~stable_vector()
+	{
+		destroy_elements();
+
+		size_t blocks = m_BlockCount.load(std::memory_order_relaxed);
+		for (size_t k = 0; k < blocks; k++)
+			m_Allocator.deallocate(m_Blocks[k], block_size(k));
+	}
+
+	// safe to call while another thread pushes: every element below the
+	// value returned is fully constructed
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr size_t
+		stable_vector<T, FirstBlock, Allocator>::size() const
+	{
+		return m_Size.load(std::memory_order_acquire);
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr size_t
+		stable_vector<T, FirstBlock, Allocator>::max_size() const
+	{
+		return block_start(max_blocks - 1) + (block_size(max_blocks - 1) - 1);
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr size_t
+		stable_vector<T, FirstBlock, Allocator>::capacity() const
+	{
+		return block_start(segment_count());
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr bool
+		stable_vector<T, FirstBlock, Allocator>::empty() const
+	{
+		return size() == 0;
+	}
+
+	// safe to call while another thread pushes, like size(): the block count
+	// is published after the block pointer is stored
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr size_t
+		stable_vector<T, FirstBlock, Allocator>::segment_count() const
+	{
+		return m_BlockCount.load(std::memory_order_acquire);
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr std::span<T>
+		stable_vector<T, FirstBlock, Allocator>::segment(const size_t& k)
+	{
+		size_t count = size();
+		size_t start = block_start(k);
+
+		if (start >= count)
+			return {};
+
+		return { m_Blocks[k], count - start < block_size(k) ? count - start : block_size(k) };
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr std::span<const T>
+		stable_vector<T, FirstBlock, Allocator>::segment(const size_t& k) const
+	{
+		return const_cast<stable_vector*>(this)->segment(k);
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr typename stable_vector<T, FirstBlock, Allocator>::reference_type
+		stable_vector<T, FirstBlock, Allocator>::operator[](const size_t& index)
+	{
+		return *slot(index);
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr typename stable_vector<T, FirstBlock, Allocator>::const_reference_type
+		stable_vector<T, FirstBlock, Allocator>::operator[](const size_t& index) const
+	{
+		return *slot(index);
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr typename stable_vector<T, FirstBlock, Allocator>::const_reference_type
+		stable_vector<T, FirstBlock, Allocator>::at(const size_t& index) const
+	{
+		return *slot(index);
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr typename stable_vector<T, FirstBlock, Allocator>::reference_type
+		stable_vector<T, FirstBlock, Allocator>::front()
+	{
+		return *slot(0);
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr typename stable_vector<T, FirstBlock, Allocator>::reference_type
+		stable_vector<T, FirstBlock, Allocator>::back()
+	{
+		return *slot(size() - 1);
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr typename stable_vector<T, FirstBlock, Allocator>::const_reference_type
+		stable_vector<T, FirstBlock, Allocator>::front() const
+	{
+		return *slot(0);
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr typename stable_vector<T, FirstBlock, Allocator>::const_reference_type
+		stable_vector<T, FirstBlock, Allocator>::back() const
+	{
+		return *slot(size() - 1);
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr typename stable_vector<T, FirstBlock, Allocator>::reference_type
+		stable_vector<T, FirstBlock, Allocator>::push_back(T&& element)
+	{
+		return emplace_back(std::move(element));
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr typename stable_vector<T, FirstBlock, Allocator>::reference_type
+		stable_vector<T, FirstBlock, Allocator>::push_back(const_reference_type element)
+	{
+		return emplace_back(element);
+	}
+
+	// the element is constructed before the size is published, so readers
+	// never see it half built. elements never move, so args may refer to one
+	template<typename T, size_t FirstBlock, class Allocator>
+	template<typename... Args>
+	constexpr typename stable_vector<T, FirstBlock, Allocator>::reference_type
+		stable_vector<T, FirstBlock, Allocator>::emplace_back(Args&&... args)
+	{
+		size_t index = m_Size.load(std::memory_order_relaxed);
+
+		if (index == capacity())
+			add_block();
+
+		pointer_type element = new(slot(index)) T(std::forward<Args>(args)...);
+		m_Size.store(index + 1, std::memory_order_release);
+
+		return *element;
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr typename stable_vector<T, FirstBlock, Allocator>::value_type
+		stable_vector<T, FirstBlock, Allocator>::pop_back()
+	{
+		size_t count = m_Size.load(std::memory_order_relaxed);
+
+		if (count == 0)
+			return value_type();
+
+		pointer_type last = slot(count - 1);
+		value_type element(std::move(*last));
+
+		m_Size.store(count - 1, std::memory_order_release);
+		last->~T();
+
+		return element;
+	}
+
+	// keeps the blocks, so pushing back up to the old size allocates nothing
+	template<typename T, size_t FirstBlock, class Allocator>
+	inline void
+		stable_vector<T, FirstBlock, Allocator>::clear()
+	{
+		destroy_elements();
+		m_Size.store(0, std::memory_order_release);
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	inline void
+		stable_vector<T, FirstBlock, Allocator>::reserve(const size_t& size)
+	{
+		while (capacity() < size)
+			add_block();
+	}
+
+	// new elements are value-initialized
+	template<typename T, size_t FirstBlock, class Allocator>
+	inline void
+		stable_vector<T, FirstBlock, Allocator>::resize(const size_t& size)
+	{
+		reserve(size);
+
+		while (this->size() < size)
+			emplace_back();
+
+		while (this->size() > size)
+			pop_back();
+	}
+
+	// frees the blocks past the one holding the last element
+	template<typename T, size_t FirstBlock, class Allocator>
+	inline void
+		stable_vector<T, FirstBlock, Allocator>::shrink_to_fit()
+	{
+		size_t count = size();
+		size_t needed = count ? block_of(count - 1) + 1 : 0;
+
+		size_t blocks = m_BlockCount.load(std::memory_order_relaxed);
+		while (blocks > needed)
+		{
+			blocks--;
+			m_BlockCount.store(blocks, std::memory_order_release);
+			m_Allocator.deallocate(m_Blocks[blocks], block_size(blocks));
+			m_Blocks[blocks] = nullptr;
+		}
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	inline void
+		stable_vector<T, FirstBlock, Allocator>::swap(stable_vector& other)
+	{
+		for (size_t k = 0; k < max_blocks; k++)
+			std::swap(m_Blocks[k], other.m_Blocks[k]);
+
+		std::swap(m_Allocator, other.m_Allocator);
+
+		size_t blocks = m_BlockCount.load(std::memory_order_relaxed);
+		m_BlockCount.store(other.m_BlockCount.load(std::memory_order_relaxed), std::memory_order_release);
+		other.m_BlockCount.store(blocks, std::memory_order_release);
+
+		size_t count = m_Size.load(std::memory_order_relaxed);
+		m_Size.store(other.m_Size.load(std::memory_order_relaxed), std::memory_order_release);
+		other.m_Size.store(count, std::memory_order_release);
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr stable_vector<T, FirstBlock, Allocator>&
+		stable_vector<T, FirstBlock, Allocator>::operator=(const stable_vector& other)
+	{
+		if (this == &other)
+			return *this;
+
+		clear();
+		reserve(other.size());
+
+		for (size_t k = 0; k < other.segment_count(); k++)
+			for (const T& element : other.segment(k))
+				emplace_back(element);
+
+		return *this;
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr stable_vector<T, FirstBlock, Allocator>&
+		stable_vector<T, FirstBlock, Allocator>::operator=(stable_vector&& other) noexcept
+	{
+		if (this != &other)
+		{
+			stable_vector released(std::move(*this));
+			swap(other);
+		}
+
+		return *this;
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr typename stable_vector<T, FirstBlock, Allocator>::const_iterator
+		stable_vector<T, FirstBlock, Allocator>::cbegin() const
+	{
+		return const_iterator(this, 0);
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr typename stable_vector<T, FirstBlock, Allocator>::const_iterator
+		stable_vector<T, FirstBlock, Allocator>::cend() const
+	{
+		return const_iterator(this, size());
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr typename stable_vector<T, FirstBlock, Allocator>::iterator
+		stable_vector<T, FirstBlock, Allocator>::begin()
+	{
+		return iterator(this, 0);
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr typename stable_vector<T, FirstBlock, Allocator>::iterator
+		stable_vector<T, FirstBlock, Allocator>::end()
+	{
+		return iterator(this, size());
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr typename stable_vector<T, FirstBlock, Allocator>::const_iterator
+		stable_vector<T, FirstBlock, Allocator>::begin() const
+	{
+		return cbegin();
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr typename stable_vector<T, FirstBlock, Allocator>::const_iterator
+		stable_vector<T, FirstBlock, Allocator>::end() const
+	{
+		return cend();
+	}
+
+	// index + FirstBlock has its highest bit at first_shift + k for every
+	// index in block k
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr size_t
+		stable_vector<T, FirstBlock, Allocator>::block_of(const size_t& index)
+	{
+		return size_t(std::bit_width(index + FirstBlock)) - 1 - first_shift;
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr size_t
+		stable_vector<T, FirstBlock, Allocator>::block_start(const size_t& k)
+	{
+		return (FirstBlock << k) - FirstBlock;
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr size_t
+		stable_vector<T, FirstBlock, Allocator>::block_size(const size_t& k)
+	{
+		return FirstBlock << k;
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr typename stable_vector<T, FirstBlock, Allocator>::pointer_type
+		stable_vector<T, FirstBlock, Allocator>::slot(const size_t& index) const
+	{
+		size_t k = block_of(index);
+		return m_Blocks[k] + (index - block_start(k));
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr void
+		stable_vector<T, FirstBlock, Allocator>::add_block()
+	{
+		size_t k = m_BlockCount.load(std::memory_order_relaxed);
+		m_Blocks[k] = m_Allocator.allocate(block_size(k));
+		m_BlockCount.store(k + 1, std::memory_order_release);
+	}
+
+	template<typename T, size_t FirstBlock, class Allocator>
+	constexpr void
+		stable_vector<T, FirstBlock, Allocator>::destroy_elements()
+	{
+		size_t blocks = m_BlockCount.load(std::memory_order_relaxed);
+		for (size_t k = 0; k < blocks; k++)
+		{
+			std::span<T> used = segment(k);
+			destroy(used.data(), used.size());
+		}
+	}
+}
+
+#endif
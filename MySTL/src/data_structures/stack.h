@@ -13,12 +13,13 @@
 
 namespace mystl
 {
-	template<typename T>
+	template<typename T, class Allocator = allocator<T>>
 	class stack
 	{
 	// typedefs
 	public:
 		using		value_type				= T;
+		using		allocator_type			= Allocator;
 
 		using		reference_type			= T&;
 		using		pointer_type			= T*;
@@ -29,6 +30,9 @@ namespace mystl
 	// constructor/destructor
 	public:
 		constexpr							stack();
+		constexpr	explicit				stack(const Allocator& allocator);
+		constexpr							stack(const stack& other) = default;
+		constexpr							stack(stack&& other) noexcept = default;
 
 	// size functions
 	public:
@@ -50,76 +54,94 @@ namespace mystl
 
 		constexpr	value_type				pop();
 
+	// mutator functions
+	public:
+					void					swap(stack& other);
+
+	// operators
+	public:
+		constexpr	stack&					operator=(const stack& other) = default;
+		constexpr	stack&					operator=(stack&& other) noexcept = default;
+
 	// variables
 	private:
-					deque<T>				m_Data;
+					deque<T, Allocator>		m_Data;
 	};
 
-	template<typename T>
-	constexpr stack<T>::stack() : m_Data()
+	template<typename T, class Allocator>
+	constexpr stack<T, Allocator>::stack() : m_Data()
+	{
+
+	}
+
+	template<typename T, class Allocator>
+	constexpr stack<T, Allocator>::stack(const Allocator& allocator) : m_Data(allocator)
 	{
 
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	constexpr size_t 
-		stack<T>::size() const
+		stack<T, Allocator>::size() const
 	{
 		return m_Data.size();
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	constexpr bool 
-		stack<T>::empty() const
+		stack<T, Allocator>::empty() const
 	{
 		return m_Data.empty();
 	}
 
-	template<typename T>
-	constexpr typename stack<T>::reference_type
-		stack<T>::top()
+	template<typename T, class Allocator>
+	constexpr typename stack<T, Allocator>::reference_type
+		stack<T, Allocator>::top()
 	{
 		return m_Data.front();
 	}
 
-	template<typename T>
-	constexpr typename stack<T>::const_reference_type
-		stack<T>::top() const
+	template<typename T, class Allocator>
+	constexpr typename stack<T, Allocator>::const_reference_type
+		stack<T, Allocator>::top() const
 	{
 		return m_Data.front();
 	}
 
-	template<typename T>
-	constexpr typename stack<T>::reference_type
-		stack<T>::push(T&& element)
+	template<typename T, class Allocator>
+	constexpr typename stack<T, Allocator>::reference_type
+		stack<T, Allocator>::push(T&& element)
 	{
-		return m_Data.push_front(element);
+		return m_Data.push_front(std::move(element));
 	}
 
-	template<typename T>
-	constexpr typename stack<T>::reference_type
-		stack<T>::push(const_reference_type element)
+	template<typename T, class Allocator>
+	constexpr typename stack<T, Allocator>::reference_type
+		stack<T, Allocator>::push(const_reference_type element)
 	{
 		return m_Data.push_front(element);
 	}
 
-	template<typename T>
+	template<typename T, class Allocator>
 	template<typename ...Args>
-	constexpr typename stack<T>::reference_type
-		stack<T>::emplace(Args && ...args)
+	constexpr typename stack<T, Allocator>::reference_type
+		stack<T, Allocator>::emplace(Args && ...args)
 	{
 		return m_Data.emplace_front(std::forward<Args>(args)...);
 	}
 
-	template<typename T>
-	constexpr typename stack<T>::value_type
-		stack<T>::pop()
+	template<typename T, class Allocator>
+	constexpr typename stack<T, Allocator>::value_type
+		stack<T, Allocator>::pop()
 	{
-		auto val = m_Data.front();
-		
-		m_Data.pop_front();
+		return m_Data.pop_front();
+	}
 
-		return val;
+	template<typename T, class Allocator>
+	inline void
+		stack<T, Allocator>::swap(stack& other)
+	{
+		m_Data.swap(other.m_Data);
 	}
 }
 
@@ -0,0 +1,378 @@
+#ifndef STATIC_SEARCH_INDEX_H
+#define STATIC_SEARCH_INDEX_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "vector.h"
+#include "../algorithms/simd.h"
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// static_search_index																///
+///																					///
+/// This class answers lower_bound/upper_bound queries over a sorted sequence		///
+/// that no longer changes, with fewer cache misses than a binary search. The		///
+/// keys are copied into one of two layouts. eytzinger stores the implicit			///
+/// binary search tree in breadth first order: the first levels share a few			///
+/// cache lines and the descendants log2(64 / sizeof(T)) levels down (four			///
+/// for 4 byte keys) share one, which is prefetched while the current level			///
+/// is compared. btree stores an implicit B+ tree (S+ tree): the sorted keys		///
+/// in leaves of one cache line, under levels of separator keys compared a			///
+/// line at once with avx2 for int32_t and float. Queries return the rank of		///
+/// the key in the sorted input, computed from where the search ends.				///
+///																					///
+///////////////////////////////////////////////////////////////////////////////////////
+
+// node kernels
+namespace mystl::simd::scalar
+{
+	// number of the count keys ordered before value (lower) or not after it
+	template<typename T>
+	inline size_t
+		node_rank(const T* keys, const size_t& count, const T& value, const bool& upper)
+	{
+		size_t rank = 0;
+
+		if (upper)
+		{
+			for (size_t i = 0; i < count; i++)
+				rank += !(value < keys[i]);
+		}
+		else
+		{
+			for (size_t i = 0; i < count; i++)
+				rank += keys[i] < value;
+		}
+
+		return rank;
+	}
+}
+
+#if defined(MYSTL_SIMD_X86)
+
+// one node is 16 int32_t or float keys, two avx2 registers
+MYSTL_SIMD_TARGET_BEGIN("avx2,popcnt")
+namespace mystl::simd::avx2
+{
+	inline size_t
+		node_rank(const int32_t* keys, const int32_t& value, const bool& upper)
+	{
+		__m256i needle = _mm256_set1_epi32(value);
+		__m256i low = _mm256_load_si256(reinterpret_cast<const __m256i*>(keys));
+		__m256i high = _mm256_load_si256(reinterpret_cast<const __m256i*>(keys + 8));
+
+		if (upper)
+		{
+			uint32_t after = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(low, needle)))
+				| (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(high, needle))) << 8;
+
+			return 16 - (size_t)_mm_popcnt_u32(after);
+		}
+
+		uint32_t before = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(needle, low)))
+			| (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(needle, high))) << 8;
+
+		return (size_t)_mm_popcnt_u32(before);
+	}
+
+	// the predicates match the scalar ones for NaN too: key < value is
+	// ordered, !(value < key) is "not greater", true when unordered
+	inline size_t
+		node_rank(const float* keys, const float& value, const bool& upper)
+	{
+		__m256 needle = _mm256_set1_ps(value);
+		__m256 low = _mm256_load_ps(keys);
+		__m256 high = _mm256_load_ps(keys + 8);
+
+		if (upper)
+			return (size_t)_mm_popcnt_u32((uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(low, needle, _CMP_NGT_UQ))
+				| (uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(high, needle, _CMP_NGT_UQ)) << 8);
+
+		return (size_t)_mm_popcnt_u32((uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(low, needle, _CMP_LT_OQ))
+			| (uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(high, needle, _CMP_LT_OQ)) << 8);
+	}
+}
+MYSTL_SIMD_TARGET_END
+
+#endif
+
+namespace mystl
+{
+	enum class search_layout
+	{
+		eytzinger,	// breadth first binary tree, prefetches a cache line of descendants
+		btree		// implicit B+ tree (S+ tree) with one cache line of keys per node
+	};
+
+	template<typename T, search_layout Layout = search_layout::eytzinger>
+	class static_search_index
+	{
+	// typedefs
+	public:
+		using		value_type				= T;
+		using		const_reference_type	= const T&;
+
+		// keys per cache line, the eytzinger prefetch block and the btree node.
+		// the eytzinger prefetch reaches log2(line_keys) levels ahead
+		static constexpr size_t				line_keys		= sizeof(T) <= 32 ? 64 / sizeof(T) : 2;
+
+	// constructor/destructor
+	public:
+		constexpr							static_search_index() = default;
+
+		// [first, last) must be sorted by operator<
+		template<class Iterator>
+											static_search_index(Iterator first, Iterator last);
+
+		template<class GrowthPolicy, class Allocator>
+		explicit							static_search_index(const vector<T, GrowthPolicy, Allocator>& sorted);
+
+	// size functions
+	public:
+		constexpr	size_t					size() const;
+		constexpr	bool					empty() const;
+
+	// search functions
+	public:
+		// rank of the first key not less than value (lower) or greater than
+		// value (upper) in the sorted input, size() if there is none
+					size_t					lower_bound(const_reference_type value) const;
+					size_t					upper_bound(const_reference_type value) const;
+					bool					contains(const_reference_type value) const;
+
+	// helpers
+	private:
+		template<class Iterator>
+					void					build_eytzinger(Iterator& source, const size_t& slot);
+		template<class Iterator>
+					void					build_btree(Iterator source);
+
+		template<bool Upper>
+					size_t					search(const_reference_type value) const;
+
+					size_t					eytzinger_rank(const size_t& slot) const;
+
+	// variables
+	private:
+					aligned_vector<T, 64>	m_Keys{};
+					vector<size_t>			m_Levels{};		// btree: first node of each level from the root, then the node count
+					size_t					m_Size		= 0;
+	};
+
+	// eytzinger slots are 1 based so the children of k are 2k and 2k + 1
+	template<typename T, search_layout Layout>
+	template<class Iterator>
+	inline static_search_index<T, Layout>::static_search_index(Iterator first, Iterator last) : m_Size(size_t(last - first))
+	{
+		if (m_Size == 0)
+			return;
+
+		if constexpr (Layout == search_layout::eytzinger)
+		{
+			Iterator source = first;
+			m_Keys.resize(m_Size + 1, *first);
+
+			build_eytzinger(source, 1);
+		}
+		else
+			build_btree(first);
+	}
+
+	template<typename T, search_layout Layout>
+	template<class GrowthPolicy, class Allocator>
+	inline static_search_index<T, Layout>::static_search_index(const vector<T, GrowthPolicy, Allocator>& sorted) : static_search_index(sorted.data(), sorted.data() + sorted.size())
+	{ }
+
+	template<typename T, search_layout Layout>
+	constexpr size_t
+		static_search_index<T, Layout>::size() const
+	{
+		return m_Size;
+	}
+
+	template<typename T, search_layout Layout>
+	constexpr bool
+		static_search_index<T, Layout>::empty() const
+	{
+		return m_Size == 0;
+	}
+
+	template<typename T, search_layout Layout>
+	inline size_t
+		static_search_index<T, Layout>::lower_bound(const_reference_type value) const
+	{
+		return search<false>(value);
+	}
+
+	template<typename T, search_layout Layout>
+	inline size_t
+		static_search_index<T, Layout>::upper_bound(const_reference_type value) const
+	{
+		return search<true>(value);
+	}
+
+	template<typename T, search_layout Layout>
+	inline bool
+		static_search_index<T, Layout>::contains(const_reference_type value) const
+	{
+		return lower_bound(value) != upper_bound(value);
+	}
+
+	// fills the subtree at slot in order, so the slots read back sorted
+	template<typename T, search_layout Layout>
+	template<class Iterator>
+	inline void
+		static_search_index<T, Layout>::build_eytzinger(Iterator& source, const size_t& slot)
+	{
+		if (slot > m_Size)
+			return;
+
+		build_eytzinger(source, 2 * slot);
+
+		m_Keys[slot] = *source;
+		++source;
+
+		build_eytzinger(source, 2 * slot + 1);
+	}
+
+	// the leaves hold the sorted keys, padded to whole nodes with copies of
+	// the largest one. every inner level has a node per line_keys + 1 nodes
+	// below it, and key j of a node is the first key under its child j + 1
+	// (the largest key for a child past the end). the root level comes first
+	template<typename T, search_layout Layout>
+	template<class Iterator>
+	inline void
+		static_search_index<T, Layout>::build_btree(Iterator source)
+	{
+		vector<size_t> counts{};
+		counts.push_back((m_Size + line_keys - 1) / line_keys);
+		while (counts.back() > 1)
+			counts.push_back((counts.back() + line_keys) / (line_keys + 1));
+
+		size_t nodes = 0;
+		for (size_t level = counts.size(); level-- > 0;)
+		{
+			m_Levels.push_back(nodes);
+			nodes += counts[level];
+		}
+		m_Levels.push_back(nodes);
+
+		const T largest = *(source + (m_Size - 1));
+		m_Keys.resize(nodes * line_keys, largest);
+
+		T* leaves = m_Keys.data() + m_Levels[counts.size() - 1] * line_keys;
+		for (size_t i = 0; i < m_Size; i++, ++source)
+			leaves[i] = *source;
+
+		// height counts the levels above the leaves, leavesUnder how many
+		// leaves a node of the level below spans
+		size_t leavesUnder = 1;
+		for (size_t height = 1; height < counts.size(); height++)
+		{
+			T* keys = m_Keys.data() + m_Levels[counts.size() - 1 - height] * line_keys;
+
+			for (size_t node = 0; node < counts[height]; node++)
+			{
+				for (size_t j = 0; j < line_keys; j++)
+				{
+					size_t first = (node * (line_keys + 1) + j + 1) * leavesUnder * line_keys;
+					keys[node * line_keys + j] = first < m_Size ? leaves[first] : largest;
+				}
+			}
+
+			leavesUnder *= line_keys + 1;
+		}
+	}
+
+	// eytzinger: walks down taking the right child when the key goes before
+	// value, then drops the trailing right turns (and the last left one) to
+	// get back to the answer, whose rank follows from its slot. btree: counts
+	// the keys of each inner node that go before value, which picks the child
+	// (the last one when that child is past the end), and the count in the
+	// leaf is the offset of the answer from the leaf's first key
+	template<typename T, search_layout Layout>
+	template<bool Upper>
+	inline size_t
+		static_search_index<T, Layout>::search(const_reference_type value) const
+	{
+		const T* keys = m_Keys.data();
+
+		if constexpr (Layout == search_layout::eytzinger)
+		{
+			size_t slot = 1;
+
+			while (slot <= m_Size)
+			{
+				simd::prefetch(reinterpret_cast<const void*>(reinterpret_cast<uintptr_t>(keys) + slot * line_keys * sizeof(T)));
+
+				if constexpr (Upper)
+					slot = 2 * slot + !(value < keys[slot]);
+				else
+					slot = 2 * slot + (keys[slot] < value);
+			}
+
+			slot >>= std::countr_one(slot) + 1;
+			return slot ? eytzinger_rank(slot) : m_Size;
+		}
+		else
+		{
+			constexpr bool vectorized = line_keys == 16 && (std::is_same_v<T, int32_t> || std::is_same_v<T, float>);
+
+			if (m_Size == 0)
+				return 0;
+
+#if defined(MYSTL_SIMD_X86)
+			const bool avx2 = vectorized && simd::active_isa() >= simd::isa::avx2;
+#else
+			const bool avx2 = false;
+#endif
+			auto node_rank = [&](const T* keysOfNode)
+			{
+#if defined(MYSTL_SIMD_X86)
+				if constexpr (vectorized)
+				{
+					if (avx2)
+						return simd::avx2::node_rank(keysOfNode, value, Upper);
+				}
+#endif
+				return simd::scalar::node_rank(keysOfNode, line_keys, value, Upper);
+			};
+
+			const size_t* levels = m_Levels.data();
+			const size_t leafLevel = m_Levels.size() - 2;
+			size_t node = 0;
+
+			for (size_t level = 0; level < leafLevel; level++)
+			{
+				size_t last = levels[level + 2] - levels[level + 1] - 1;
+
+				node = node * (line_keys + 1) + node_rank(keys + (levels[level] + node) * line_keys);
+				node = node < last ? node : last;
+			}
+
+			size_t rank = node * line_keys + node_rank(keys + (levels[leafLevel] + node) * line_keys);
+			return rank < m_Size ? rank : m_Size;
+		}
+	}
+
+	// the rank of a slot in the perfect tree one level deeper than the full
+	// levels, less the last level slots in front of it that are not there.
+	// in that tree the last level holds the even ranks, filled from the left
+	template<typename T, search_layout Layout>
+	inline size_t
+		static_search_index<T, Layout>::eytzinger_rank(const size_t& slot) const
+	{
+		size_t height = size_t(std::bit_width(m_Size)) - 1;
+		size_t depth = size_t(std::bit_width(slot)) - 1;
+
+		size_t rank = ((2 * (slot - (size_t(1) << depth)) + 1) << (height - depth)) - 1;
+		size_t lastBefore = (rank + 1) / 2;
+		size_t lastFilled = m_Size - (size_t(1) << height) + 1;
+
+		return lastBefore > lastFilled ? rank - (lastBefore - lastFilled) : rank;
+	}
+}
+
+#endif
@@ -0,0 +1,652 @@
+#ifndef STATIC_VECTOR_H
+#define STATIC_VECTOR_H
+
+#include <assert.h>
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "iterator.h"
+#include "memory.h"
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// static_vector																	///
+///																					///
+/// This class is a vector with a fixed capacity N whose elements live inside		///
+/// the object, like array, but in uninitialized storage: only the first size()		///
+/// slots hold constructed elements, so T does not need a default constructor		///
+/// and nothing is built before it is pushed. It never touches the heap.			///
+/// Going past N asserts in debug builds and throws std::bad_alloc otherwise,		///
+/// like std::inplace_vector; try_push_back and try_emplace_back report a full		///
+/// vector by returning nullptr instead. pop_back() returns value_type() on an		///
+/// empty vector, so using it needs T to be default constructible.					///
+///																					///
+///////////////////////////////////////////////////////////////////////////////////////
+
+namespace mystl
+{
+	template<typename T, size_t N>
+	class static_vector
+	{
+		static_assert(N > 0, "static_vector needs a capacity of at least one element");
+
+	// typedefs
+	public:
+		using		value_type				= T;
+
+		using		reference_type			= T&;
+		using		pointer_type			= T*;
+
+		using		const_reference_type	= const T&;
+		using		const_pointer_type		= const T*;
+
+		using		const_iterator			= mystl::const_iterator<static_vector<T, N>>;
+		using		iterator				= mystl::iterator<static_vector<T, N>>;
+
+		using		const_reverse_iterator	= mystl::const_reverse_iterator<const_iterator>;
+		using		reverse_iterator		= mystl::reverse_iterator<iterator>;
+
+	// constructor/destructor
+	public:
+											static_vector() = default;
+											static_vector(const size_t& count, const_reference_type fillElement);
+											static_vector(const static_vector& other);
+											static_vector(static_vector&& other) noexcept;
+											~static_vector();
+
+	// size functions
+	public:
+					size_t					size() const;
+		static constexpr size_t				max_size();
+		static constexpr size_t				capacity();
+
+					bool					empty() const;
+					bool					full() const;
+
+	// access functions
+	public:
+					reference_type			operator[](const size_t& index);
+					const_reference_type	operator[](const size_t& index) const;
+					const_reference_type	at(const size_t& index) const;
+
+					reference_type			front();
+					reference_type			back();
+
+					const_reference_type	front() const;
+					const_reference_type	back() const;
+
+					pointer_type			data();
+					const_pointer_type		data() const;
+
+	// mutator functions
+	public:
+					reference_type			push_back(T&& element);
+					reference_type			push_back(const_reference_type element);
+
+		template<typename... Args>
+					reference_type			emplace_back(Args&&... args);
+
+					pointer_type			try_push_back(T&& element);
+					pointer_type			try_push_back(const_reference_type element);
+
+		template<typename... Args>
+					pointer_type			try_emplace_back(Args&&... args);
+
+		template<typename... Args>
+					iterator				emplace(iterator position, Args&&... args);
+
+					iterator				insert(iterator position, T&& element);
+					iterator				insert(iterator position, const_reference_type element);
+					iterator				insert(iterator position, const size_t& count, const_reference_type element);
+
+		template<class Iterator> requires (!std::is_integral_v<Iterator>)
+					iterator				insert(iterator position, Iterator first, Iterator last);
+
+					iterator				erase(iterator position);
+					iterator				erase(iterator first, iterator last);
+
+		// returns value_type() when empty, which needs a default constructor
+					value_type				pop_back();
+
+					void					clear();
+					void					resize(const size_t& size);
+					void					resize(const size_t& size, const_reference_type fillElement);
+					void					swap(static_vector& other);
+
+	// operators
+	public:
+					static_vector&			operator=(const static_vector& other);
+					static_vector&			operator=(static_vector&& other) noexcept;
+
+	// iterator functions
+	public:
+					const_iterator			cbegin() const;
+					const_iterator			cend() const;
+
+					iterator				begin();
+					iterator				end();
+
+					const_reverse_iterator	crbegin() const;
+					const_reverse_iterator	crend() const;
+
+					reverse_iterator		rbegin();
+					reverse_iterator		rend();
+
+	// helpers
+	private:
+					void					check_capacity(const size_t& count) const;
+					pointer_type			open_gap(const size_t& index, const size_t& count);
+
+		template<class Iterator>
+					size_t					distance(Iterator first, Iterator last) const;
+
+	// variables (raw bytes, which is why nothing here is constexpr)
+	private:
+		alignas(T)	unsigned char			m_Storage[N * sizeof(T)];
+					size_t					m_Size		= 0;
+	};
+
+	template<typename T, size_t N>
+	inline static_vector<T, N>::static_vector(const size_t& count, const_reference_type fillElement)
+	{
+		check_capacity(count);
+
+		for (; m_Size < count; m_Size++)
+			new(data() + m_Size) T(fillElement);
+	}
+
+	template<typename T, size_t N>
+	inline static_vector<T, N>::static_vector(const static_vector& other) : m_Size(other.m_Size)
+	{
+		uninitialized_copy(other.data(), other.m_Size, data());
+	}
+
+	// the storage cannot change owners, so the elements are relocated and the
+	// source is left empty
+	template<typename T, size_t N>
+	inline static_vector<T, N>::static_vector(static_vector&& other) noexcept : m_Size(other.m_Size)
+	{
+		relocate(data(), other.data(), other.m_Size);
+		other.m_Size = 0;
+	}
+
+	template<typename T, size_t N>
+	inline static_vector<T, N>::~static_vector()
+	{
+		destroy(data(), m_Size);
+	}
+
+	template<typename T, size_t N>
+	inline size_t
+		static_vector<T, N>::size() const
+	{
+		return m_Size;
+	}
+
+	template<typename T, size_t N>
+	constexpr size_t
+		static_vector<T, N>::max_size()
+	{
+		return N;
+	}
+
+	template<typename T, size_t N>
+	constexpr size_t
+		static_vector<T, N>::capacity()
+	{
+		return N;
+	}
+
+	template<typename T, size_t N>
+	inline bool
+		static_vector<T, N>::empty() const
+	{
+		return m_Size == 0;
+	}
+
+	template<typename T, size_t N>
+	inline bool
+		static_vector<T, N>::full() const
+	{
+		return m_Size == N;
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::reference_type
+		static_vector<T, N>::operator[](const size_t& index)
+	{
+		return data()[index];
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::const_reference_type
+		static_vector<T, N>::operator[](const size_t& index) const
+	{
+		return data()[index];
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::const_reference_type
+		static_vector<T, N>::at(const size_t& index) const
+	{
+		assert("static_vector subscript out of range" && index < m_Size);
+		return data()[index];
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::reference_type
+		static_vector<T, N>::front()
+	{
+		return data()[0];
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::reference_type
+		static_vector<T, N>::back()
+	{
+		return data()[m_Size - 1];
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::const_reference_type
+		static_vector<T, N>::front() const
+	{
+		return data()[0];
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::const_reference_type
+		static_vector<T, N>::back() const
+	{
+		return data()[m_Size - 1];
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::pointer_type
+		static_vector<T, N>::data()
+	{
+		return std::launder(reinterpret_cast<T*>(m_Storage));
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::const_pointer_type
+		static_vector<T, N>::data() const
+	{
+		return std::launder(reinterpret_cast<const T*>(m_Storage));
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::reference_type
+		static_vector<T, N>::push_back(T&& element)
+	{
+		return emplace_back(std::move(element));
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::reference_type
+		static_vector<T, N>::push_back(const_reference_type element)
+	{
+		return emplace_back(element);
+	}
+
+	template<typename T, size_t N>
+	template<typename... Args>
+	inline typename static_vector<T, N>::reference_type
+		static_vector<T, N>::emplace_back(Args&&... args)
+	{
+		check_capacity(m_Size + 1);
+
+		T* element = new(data() + m_Size) T(std::forward<Args>(args)...);
+		m_Size++;
+
+		return *element;
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::pointer_type
+		static_vector<T, N>::try_push_back(T&& element)
+	{
+		return try_emplace_back(std::move(element));
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::pointer_type
+		static_vector<T, N>::try_push_back(const_reference_type element)
+	{
+		return try_emplace_back(element);
+	}
+
+	template<typename T, size_t N>
+	template<typename... Args>
+	inline typename static_vector<T, N>::pointer_type
+		static_vector<T, N>::try_emplace_back(Args&&... args)
+	{
+		if (m_Size == N)
+			return nullptr;
+
+		return &emplace_back(std::forward<Args>(args)...);
+	}
+
+	template<typename T, size_t N>
+	template<typename... Args>
+	inline typename static_vector<T, N>::iterator
+		static_vector<T, N>::emplace(iterator position, Args&&... args)
+	{
+		size_t index = position - begin();
+
+		if (index == m_Size)
+		{
+			emplace_back(std::forward<Args>(args)...);
+			return begin() + index;
+		}
+
+		// built first so args may safely refer to elements of this vector
+		T element(std::forward<Args>(args)...);
+
+		new(open_gap(index, 1)) T(std::move(element));
+		m_Size++;
+
+		return begin() + index;
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::iterator
+		static_vector<T, N>::insert(iterator position, T&& element)
+	{
+		return emplace(position, std::move(element));
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::iterator
+		static_vector<T, N>::insert(iterator position, const_reference_type element)
+	{
+		return emplace(position, element);
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::iterator
+		static_vector<T, N>::insert(iterator position, const size_t& count, const_reference_type element)
+	{
+		size_t index = position - begin();
+
+		if (count == 0)
+			return position;
+
+		// copied first, element may live in the tail that is about to move
+		T filler(element);
+		T* gap = open_gap(index, count);
+
+		for (size_t i = 0; i < count; i++)
+			new(&gap[i]) T(filler);
+		m_Size += count;
+
+		return begin() + index;
+	}
+
+	template<typename T, size_t N>
+	template<class Iterator> requires (!std::is_integral_v<Iterator>)
+	inline typename static_vector<T, N>::iterator
+		static_vector<T, N>::insert(iterator position, Iterator first, Iterator last)
+	{
+		size_t index = position - begin();
+
+		// a single pass range is appended and rotated into place
+		if constexpr (is_single_pass_iterator_v<Iterator>)
+		{
+			size_t oldSize = m_Size;
+
+			try
+			{
+				for (; first != last; ++first)
+					emplace_back(*first);
+			}
+			catch (...)
+			{
+				destroy(data() + oldSize, m_Size - oldSize);
+				m_Size = oldSize;
+				throw;
+			}
+
+			std::rotate(data() + index, data() + oldSize, data() + m_Size);
+
+			return begin() + index;
+		}
+		else
+		{
+			size_t count = distance(first, last);
+
+			if (count == 0)
+				return position;
+
+			T* gap = open_gap(index, count);
+
+			for (size_t i = 0; i < count; i++, ++first)
+				new(&gap[i]) T(*first);
+			m_Size += count;
+
+			return begin() + index;
+		}
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::iterator
+		static_vector<T, N>::erase(iterator position)
+	{
+		return erase(position, position + 1);
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::iterator
+		static_vector<T, N>::erase(iterator first, iterator last)
+	{
+		size_t index = first - begin();
+		size_t count = last - first;
+
+		if (count == 0)
+			return first;
+
+		destroy(data() + index, count);
+		relocate_overlapping(data() + index, data() + index + count, m_Size - index - count);
+		m_Size -= count;
+
+		return begin() + index;
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::value_type
+		static_vector<T, N>::pop_back()
+	{
+		if (m_Size == 0)
+			return value_type();
+
+		m_Size--;
+		value_type val = std::move(data()[m_Size]);
+		data()[m_Size].~T();
+
+		return val;
+	}
+
+	template<typename T, size_t N>
+	inline void
+		static_vector<T, N>::clear()
+	{
+		destroy(data(), m_Size);
+		m_Size = 0;
+	}
+
+	template<typename T, size_t N>
+	inline void
+		static_vector<T, N>::resize(const size_t& size)
+	{
+		check_capacity(size);
+
+		if (size < m_Size)
+			destroy(data() + size, m_Size - size);
+
+		for (; m_Size < size; m_Size++)
+			new(data() + m_Size) T();
+
+		m_Size = size;
+	}
+
+	template<typename T, size_t N>
+	inline void
+		static_vector<T, N>::resize(const size_t& size, const_reference_type fillElement)
+	{
+		check_capacity(size);
+
+		if (size < m_Size)
+			destroy(data() + size, m_Size - size);
+
+		for (; m_Size < size; m_Size++)
+			new(data() + m_Size) T(fillElement);
+
+		m_Size = size;
+	}
+
+	// swaps the common prefix in place and relocates the longer tail across
+	template<typename T, size_t N>
+	inline void
+		static_vector<T, N>::swap(static_vector& other)
+	{
+		using std::swap;
+
+		static_vector& longer = m_Size < other.m_Size ? other : *this;
+		static_vector& shorter = m_Size < other.m_Size ? *this : other;
+		size_t common = shorter.m_Size;
+
+		for (size_t i = 0; i < common; i++)
+			swap(data()[i], other.data()[i]);
+
+		relocate(shorter.data() + common, longer.data() + common, longer.m_Size - common);
+		std::swap(m_Size, other.m_Size);
+	}
+
+	template<typename T, size_t N>
+	inline static_vector<T, N>&
+		static_vector<T, N>::operator=(const static_vector& other)
+	{
+		if (this == &other)
+			return *this;
+
+		clear();
+		uninitialized_copy(other.data(), other.m_Size, data());
+		m_Size = other.m_Size;
+
+		return *this;
+	}
+
+	template<typename T, size_t N>
+	inline static_vector<T, N>&
+		static_vector<T, N>::operator=(static_vector&& other) noexcept
+	{
+		if (this == &other)
+			return *this;
+
+		clear();
+		relocate(data(), other.data(), other.m_Size);
+		m_Size = other.m_Size;
+		other.m_Size = 0;
+
+		return *this;
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::const_iterator
+		static_vector<T, N>::cbegin() const
+	{
+		return const_iterator(data());
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::const_iterator
+		static_vector<T, N>::cend() const
+	{
+		return const_iterator(data() + m_Size);
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::iterator
+		static_vector<T, N>::begin()
+	{
+		return iterator(data());
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::iterator
+		static_vector<T, N>::end()
+	{
+		return iterator(data() + m_Size);
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::const_reverse_iterator
+		static_vector<T, N>::crbegin() const
+	{
+		return const_reverse_iterator(data() + m_Size - 1);
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::const_reverse_iterator
+		static_vector<T, N>::crend() const
+	{
+		return const_reverse_iterator(data() - 1);
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::reverse_iterator
+		static_vector<T, N>::rbegin()
+	{
+		return reverse_iterator(data() + m_Size - 1);
+	}
+
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::reverse_iterator
+		static_vector<T, N>::rend()
+	{
+		return reverse_iterator(data() - 1);
+	}
+
+	// growing past N is caught by the assert in debug builds and throws
+	// std::bad_alloc otherwise, like std::inplace_vector
+	template<typename T, size_t N>
+	inline void
+		static_vector<T, N>::check_capacity(const size_t& count) const
+	{
+		assert("static_vector capacity exceeded" && count <= N);
+
+		if (count > N)
+			throw std::bad_alloc();
+	}
+
+	// shifts the tail up by count in place. returns the (uninitialized) gap
+	template<typename T, size_t N>
+	inline typename static_vector<T, N>::pointer_type
+		static_vector<T, N>::open_gap(const size_t& index, const size_t& count)
+	{
+		check_capacity(m_Size + count);
+
+		relocate_overlapping(data() + index + count, data() + index, m_Size - index);
+
+		return data() + index;
+	}
+
+	template<typename T, size_t N>
+	template<class Iterator>
+	inline size_t
+		static_vector<T, N>::distance(Iterator first, Iterator last) const
+	{
+		if constexpr (is_contiguous_iterator_v<Iterator>)
+			return size_t(last - first);
+
+		size_t count = 0;
+		for (; first != last; ++first)
+			count++;
+
+		return count;
+	}
+}
+
+#endif
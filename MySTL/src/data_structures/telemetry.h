@@ -0,0 +1,337 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#if defined(MYSTL_TELEMETRY)
+#include <atomic>
+#include <cstdio>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// telemetry																		///
+///																					///
+/// Opt-in allocation counters for the mystl containers. Defining MYSTL_TELEMETRY	///
+/// gives vector, list and binary_search_tree a probe that records allocations,		///
+/// frees, live and peak bytes, reallocations and bytes moved, readable per			///
+/// instance through telemetry_stats() and summed per container type through		///
+/// telemetry::type_stats<Container>(). telemetry::to_json() dumps every type		///
+/// that allocated. Without the define the probe is an empty member whose			///
+/// functions do nothing, so the containers do not change size or speed.			///
+///																					///
+///////////////////////////////////////////////////////////////////////////////////////
+
+// takes no space when the member type is empty (msvc ignores the standard spelling)
+#if defined(_MSC_VER) && !defined(__clang__)
+#define MYSTL_NO_UNIQUE_ADDRESS				[[msvc::no_unique_address]]
+#else
+#define MYSTL_NO_UNIQUE_ADDRESS				[[no_unique_address]]
+#endif
+
+// counters
+namespace mystl::telemetry
+{
+#if defined(MYSTL_TELEMETRY)
+	inline constexpr bool enabled = true;
+#else
+	inline constexpr bool enabled = false;
+#endif
+
+	// a reallocation counts as one allocation and one free as well
+	struct counters
+	{
+		size_t	allocations		= 0;
+		size_t	frees			= 0;
+		size_t	bytes_live		= 0;
+		size_t	peak_bytes		= 0;
+		size_t	reallocations	= 0;
+		size_t	bytes_moved		= 0;
+	};
+}
+
+#if defined(MYSTL_TELEMETRY)
+
+// type registry
+namespace mystl::telemetry::detail
+{
+	// the container's name as the compiler spells it in a function signature
+	template<class Container>
+	inline std::string_view
+		type_name()
+	{
+#if defined(_MSC_VER) && !defined(__clang__)
+		std::string_view signature = __FUNCSIG__;
+		size_t start = signature.find("type_name<") + 10;
+		size_t end = signature.rfind(">(void)");
+#else
+		std::string_view signature = __PRETTY_FUNCTION__;
+		size_t start = signature.find("Container = ") + 12;
+		size_t end = signature.find(';', start);
+
+		if (end == std::string_view::npos)
+			end = signature.rfind(']');
+#endif
+		return signature.substr(start, end - start);
+	}
+
+	// per type totals, updated by every instance from any thread. records
+	// link themselves into a list the first time their type allocates
+	struct type_record
+	{
+		explicit						type_record(const std::string_view& name);
+
+		std::string_view				name;
+		std::atomic<size_t>				allocations{ 0 };
+		std::atomic<size_t>				frees{ 0 };
+		std::atomic<size_t>				bytes_live{ 0 };
+		std::atomic<size_t>				peak_bytes{ 0 };
+		std::atomic<size_t>				reallocations{ 0 };
+		std::atomic<size_t>				bytes_moved{ 0 };
+		type_record*					next = nullptr;
+	};
+
+	inline std::atomic<type_record*>	g_Records{ nullptr };
+
+	inline type_record::type_record(const std::string_view& name) : name(name)
+	{
+		next = g_Records.load(std::memory_order_relaxed);
+		while (!g_Records.compare_exchange_weak(next, this, std::memory_order_release, std::memory_order_relaxed)) { }
+	}
+
+	template<class Container>
+	inline type_record&
+		record_of()
+	{
+		static type_record record(type_name<Container>());
+		return record;
+	}
+
+	inline void
+		raise_peak(std::atomic<size_t>& peak, const size_t& live)
+	{
+		size_t seen = peak.load(std::memory_order_relaxed);
+		while (seen < live && !peak.compare_exchange_weak(seen, live, std::memory_order_relaxed)) { }
+	}
+
+	inline counters
+		snapshot(const type_record& record)
+	{
+		return counters{
+			record.allocations.load(std::memory_order_relaxed),
+			record.frees.load(std::memory_order_relaxed),
+			record.bytes_live.load(std::memory_order_relaxed),
+			record.peak_bytes.load(std::memory_order_relaxed),
+			record.reallocations.load(std::memory_order_relaxed),
+			record.bytes_moved.load(std::memory_order_relaxed)
+		};
+	}
+}
+
+#endif
+
+// probe
+namespace mystl::telemetry
+{
+	// the member a container reports its storage through. the counters follow
+	// the storage: a moved-to probe takes them over, a copy starts from zero
+	template<class Container>
+	class probe
+	{
+	// constructor/destructor
+	public:
+		constexpr							probe() = default;
+		constexpr							probe(const probe&) { }
+		constexpr							probe(probe&& other) noexcept;
+
+	// recording functions
+	public:
+		// block may be nullptr (a moved-from container), which records nothing
+		constexpr	void					allocated(const void* block, const size_t& bytes);
+		constexpr	void					freed(const void* block, const size_t& bytes);
+		// one block replaced by another, bytesMoved of it copied across
+		constexpr	void					reallocated(const size_t& oldBytes, const size_t& newBytes, const size_t& bytesMoved);
+		// adds other's counters to these and resets other, for a container
+		// that took over other's storage
+		constexpr	void					absorb(probe& other);
+
+	// accessors
+	public:
+		constexpr	counters				stats() const;
+
+	// assignment operators
+	public:
+		constexpr	probe&					operator=(const probe&) { return *this; }
+		constexpr	probe&					operator=(probe&& other) noexcept;
+
+#if defined(MYSTL_TELEMETRY)
+	// variables
+	private:
+					counters				m_Counters{};
+#endif
+	};
+
+	template<class Container>
+	constexpr probe<Container>::probe(probe&& other) noexcept
+	{
+		absorb(other);
+	}
+
+	template<class Container>
+	constexpr void
+		probe<Container>::allocated([[maybe_unused]] const void* block, [[maybe_unused]] const size_t& bytes)
+	{
+#if defined(MYSTL_TELEMETRY)
+		if (!block)
+			return;
+
+		m_Counters.allocations++;
+		m_Counters.bytes_live += bytes;
+		if (m_Counters.peak_bytes < m_Counters.bytes_live)
+			m_Counters.peak_bytes = m_Counters.bytes_live;
+
+		detail::type_record& record = detail::record_of<Container>();
+		record.allocations.fetch_add(1, std::memory_order_relaxed);
+		detail::raise_peak(record.peak_bytes, record.bytes_live.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+#endif
+	}
+
+	template<class Container>
+	constexpr void
+		probe<Container>::freed([[maybe_unused]] const void* block, [[maybe_unused]] const size_t& bytes)
+	{
+#if defined(MYSTL_TELEMETRY)
+		if (!block)
+			return;
+
+		m_Counters.frees++;
+		m_Counters.bytes_live -= bytes;
+
+		detail::type_record& record = detail::record_of<Container>();
+		record.frees.fetch_add(1, std::memory_order_relaxed);
+		record.bytes_live.fetch_sub(bytes, std::memory_order_relaxed);
+#endif
+	}
+
+	// both blocks are live while the elements move, so the peak counts both
+	template<class Container>
+	constexpr void
+		probe<Container>::reallocated([[maybe_unused]] const size_t& oldBytes, [[maybe_unused]] const size_t& newBytes, [[maybe_unused]] const size_t& bytesMoved)
+	{
+#if defined(MYSTL_TELEMETRY)
+		m_Counters.allocations++;
+		m_Counters.frees++;
+		m_Counters.reallocations++;
+		m_Counters.bytes_moved += bytesMoved;
+		m_Counters.bytes_live += newBytes;
+		if (m_Counters.peak_bytes < m_Counters.bytes_live)
+			m_Counters.peak_bytes = m_Counters.bytes_live;
+		m_Counters.bytes_live -= oldBytes;
+
+		detail::type_record& record = detail::record_of<Container>();
+		record.allocations.fetch_add(1, std::memory_order_relaxed);
+		record.frees.fetch_add(1, std::memory_order_relaxed);
+		record.reallocations.fetch_add(1, std::memory_order_relaxed);
+		record.bytes_moved.fetch_add(bytesMoved, std::memory_order_relaxed);
+		detail::raise_peak(record.peak_bytes, record.bytes_live.fetch_add(newBytes, std::memory_order_relaxed) + newBytes);
+		record.bytes_live.fetch_sub(oldBytes, std::memory_order_relaxed);
+#endif
+	}
+
+	template<class Container>
+	constexpr void
+		probe<Container>::absorb([[maybe_unused]] probe& other)
+	{
+#if defined(MYSTL_TELEMETRY)
+		m_Counters.allocations += other.m_Counters.allocations;
+		m_Counters.frees += other.m_Counters.frees;
+		m_Counters.bytes_live += other.m_Counters.bytes_live;
+		m_Counters.reallocations += other.m_Counters.reallocations;
+		m_Counters.bytes_moved += other.m_Counters.bytes_moved;
+		if (m_Counters.peak_bytes < other.m_Counters.peak_bytes)
+			m_Counters.peak_bytes = other.m_Counters.peak_bytes;
+
+		other.m_Counters = counters{};
+#endif
+	}
+
+	template<class Container>
+	constexpr counters
+		probe<Container>::stats() const
+	{
+#if defined(MYSTL_TELEMETRY)
+		return m_Counters;
+#else
+		return counters{};
+#endif
+	}
+
+	template<class Container>
+	constexpr probe<Container>&
+		probe<Container>::operator=([[maybe_unused]] probe&& other) noexcept
+	{
+#if defined(MYSTL_TELEMETRY)
+		if (this != &other)
+		{
+			m_Counters = other.m_Counters;
+			other.m_Counters = counters{};
+		}
+#endif
+		return *this;
+	}
+}
+
+// aggregates
+namespace mystl::telemetry
+{
+	// totals over every instance of Container, all zero until one allocates
+	template<class Container>
+	inline counters
+		type_stats()
+	{
+#if defined(MYSTL_TELEMETRY)
+		return detail::snapshot(detail::record_of<Container>());
+#else
+		return counters{};
+#endif
+	}
+
+	// [{"type": "mystl::vector<int>", "allocations": 3, ...}, ...] with one
+	// object per container type that allocated, newest type first. "[]"
+	// without MYSTL_TELEMETRY
+	inline std::string
+		to_json()
+	{
+		std::string json = "[";
+
+#if defined(MYSTL_TELEMETRY)
+		for (detail::type_record* record = detail::g_Records.load(std::memory_order_acquire); record; record = record->next)
+		{
+			counters totals = detail::snapshot(*record);
+			char numbers[256];
+
+			std::snprintf(numbers, sizeof(numbers),
+				"\", \"allocations\": %zu, \"frees\": %zu, \"bytes_live\": %zu, \"peak_bytes\": %zu, \"reallocations\": %zu, \"bytes_moved\": %zu}",
+				totals.allocations, totals.frees, totals.bytes_live, totals.peak_bytes, totals.reallocations, totals.bytes_moved);
+
+			json += json.size() > 1 ? ",\n {\"type\": \"" : "\n {\"type\": \"";
+			for (char c : record->name)
+			{
+				if (c == '"' || c == '\\')
+					json += '\\';
+				json += c;
+			}
+			json += numbers;
+		}
+
+		if (json.size() > 1)
+			json += '\n';
+#endif
+
+		json += ']';
+		return json;
+	}
+}
+
+#endif
@@ -1,7 +1,18 @@
 #ifndef VECTOR_H
 #define VECTOR_H
 
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "allocator.h"
+#include "growth_policy.h"
 #include "iterator.h"
+#include "memory.h"
+#include "telemetry.h"
 
 ///////////////////////////////////////////////////////////////////////////////////////
 /// vector																			///
@@ -9,19 +20,22 @@
 /// This class is a templated vector class meant to mimic the C++ STL vector.		///
 /// The vector takes in a type. If no size is specified, the size					///
 /// defaults to 2. Note that bounds checking isn't implemented. The size grows		///
-/// differently depending on the current size: size < 10 ? size doubles :			///
-/// size grows by 1.5x.																///
+/// according to the GrowthPolicy argument (see growth_policy.h). By default:		///
+/// size < 10 ? size doubles : size grows by 1.5x. Storage comes from the			///
+/// Allocator argument (see allocator.h). Building with MYSTL_TELEMETRY counts		///
+/// its allocations (see telemetry.h).												///
 ///																					///
 ///////////////////////////////////////////////////////////////////////////////////////
 
 namespace mystl
 {
-	template<typename T>
+	template<typename T, class GrowthPolicy = growth::standard, class Allocator = allocator<T>>
 	class vector
 	{
 	// typedefs
 	public:
 		using		value_type				= T;
+		using		allocator_type			= Allocator;
 
 		using		reference_type			= T&;
 		using		pointer_type			= T*;
@@ -29,19 +43,22 @@ namespace mystl
 		using		const_reference_type	= const T&;
 		using		const_pointer_type		= const T*;
 
-		using		const_iterator			= const_iterator<vector<T>>;
-		using		iterator				= iterator<vector<T>>;
+		using		const_iterator			= mystl::const_iterator<vector<T, GrowthPolicy, Allocator>>;
+		using		iterator				= mystl::iterator<vector<T, GrowthPolicy, Allocator>>;
 
-		using		const_reverse_iterator	= const_reverse_iterator<const_iterator>;
-		using		reverse_iterator		= reverse_iterator<iterator>;
+		using		const_reverse_iterator	= mystl::const_reverse_iterator<const_iterator>;
+		using		reverse_iterator		= mystl::reverse_iterator<iterator>;
 
 	// constructor/destructor
 	public:
 		constexpr							vector();
 		constexpr							vector(const size_t& capacity);
+		constexpr	explicit				vector(const Allocator& allocator);
+		constexpr							vector(const size_t& capacity, const Allocator& allocator);
 		constexpr							vector(const size_t& capacity, T&& fillElement);
 		constexpr							vector(const size_t& capacity, const_reference_type fillElement);
 		constexpr							vector(const vector& other);
+		constexpr							vector(vector&& other) noexcept;
 											~vector();
 
 	// size functions
@@ -52,6 +69,10 @@ namespace mystl
 
 		constexpr	bool					empty() const;
 
+		constexpr	const GrowthPolicy&		growth_policy() const;
+		constexpr	allocator_type			get_allocator() const;
+		constexpr	telemetry::counters		telemetry_stats() const;
+
 	// access functions
 	public:
 		constexpr	reference_type			operator[](const size_t& index);
@@ -78,18 +99,38 @@ namespace mystl
 		template<typename... Args>
 		constexpr	iterator				emplace(iterator position, Args&&... args);
 
-		constexpr	reference_type			pop_back();
+		constexpr	iterator				insert(iterator position, T&& element);
+		constexpr	iterator				insert(iterator position, const_reference_type element);
+		constexpr	iterator				insert(iterator position, const size_t& count, const_reference_type element);
+
+		template<class Iterator> requires (!std::is_integral_v<Iterator>)
+		constexpr	iterator				insert(iterator position, Iterator first, Iterator last);
+
+		constexpr	iterator				erase(iterator position);
+		constexpr	iterator				erase(iterator first, iterator last);
+
+		template<class Iterator> requires (!std::is_integral_v<Iterator>)
+		constexpr	void					append(Iterator first, Iterator last);
+
+		template<class Iterator> requires (!std::is_integral_v<Iterator>)
+		constexpr	void					assign(Iterator first, Iterator last);
+
+		constexpr	value_type				pop_back();
 
 	// mutator functions
 	public:
-					[[noreturn]] void		clear();
-					[[noreturn]] void		reserve(const size_t& size);
-					[[noreturn]] void		resize(const size_t& size);
-					[[noreturn]] void		shrink_to_fit();
+					void					clear();
+					void					reserve(const size_t& size);
+					void					resize(const size_t& size);
+					void					resize(const size_t& size, const_reference_type fillElement);
+					void					resize_default_init(const size_t& size);
+					void					shrink_to_fit();
+					void					swap(vector& other);
 
 	// operators
 	public:
-		constexpr	vector<T>&				operator=(const vector& other);
+		constexpr	vector&					operator=(const vector& other);
+		constexpr	vector&					operator=(vector&& other) noexcept(std::allocator_traits<Allocator>::is_always_equal::value);
 
 	// iterator functions
 	public:
@@ -105,8 +146,19 @@ namespace mystl
 		constexpr	reverse_iterator		rbegin();
 		constexpr	reverse_iterator		rend();
 
+	// helpers for derived containers
+	protected:
+		constexpr	void					take_block(vector& other);
+
 	// helpers
 	private:
+		constexpr	void					grow(const size_t& required);
+		constexpr	pointer_type			open_gap(const size_t& index, const size_t& count);
+
+		template<class Iterator>
+		constexpr	size_t					distance(Iterator first, Iterator last) const;
+		template<class Iterator>
+		constexpr	void					construct_range(pointer_type dest, Iterator first, const size_t& count);
 		constexpr	void					realloc(const size_t& newCapacity);
 		constexpr	size_t					pow(const size_t& num, const size_t& power) const;
 
@@ -115,169 +167,220 @@ namespace mystl
 					pointer_type			m_Data		= nullptr;
 					size_t					m_Size		= 0;
 					size_t					m_Capacity	= 0;
+					GrowthPolicy			m_Growth{};
+					Allocator				m_Allocator{};
+		MYSTL_NO_UNIQUE_ADDRESS telemetry::probe<vector> m_Telemetry{};
 	};
 
-	template<typename T>
-	constexpr vector<T>::vector() : m_Data(nullptr), m_Size(0), m_Capacity(2)
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr vector<T, GrowthPolicy, Allocator>::vector() : m_Data(nullptr), m_Size(0), m_Capacity(2)
+	{
+		realloc(2);
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr vector<T, GrowthPolicy, Allocator>::vector(const size_t& capacity) : m_Data(nullptr), m_Size(0), m_Capacity(capacity)
+	{
+		realloc(capacity);
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr vector<T, GrowthPolicy, Allocator>::vector(const Allocator& allocator) : m_Data(nullptr), m_Size(0), m_Capacity(2), m_Allocator(allocator)
 	{
 		realloc(2);
 	}
 
-	template<typename T>
-	constexpr vector<T>::vector(const size_t& capacity) : m_Data(nullptr), m_Size(0), m_Capacity(capacity)
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr vector<T, GrowthPolicy, Allocator>::vector(const size_t& capacity, const Allocator& allocator) : m_Data(nullptr), m_Size(0), m_Capacity(capacity), m_Allocator(allocator)
 	{
 		realloc(capacity);
 	}
 
-	template<typename T>
-	constexpr vector<T>::vector(const size_t& capacity, T&& fillElement) : m_Data(nullptr), m_Size(capacity), m_Capacity(capacity)
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr vector<T, GrowthPolicy, Allocator>::vector(const size_t& capacity, T&& fillElement) : m_Data(nullptr), m_Size(capacity), m_Capacity(capacity)
 	{
 		realloc(capacity);
 		for (size_t i = 0; i < m_Capacity; i++)
-			m_Data[i] = std::move(fillElement);
+			new(&m_Data[i]) T(fillElement);
 	}
 
-	template<typename T>
-	constexpr vector<T>::vector(const size_t& capacity, const_reference_type fillElement) : m_Data(nullptr), m_Size(capacity), m_Capacity(capacity)
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr vector<T, GrowthPolicy, Allocator>::vector(const size_t& capacity, const_reference_type fillElement) : m_Data(nullptr), m_Size(capacity), m_Capacity(capacity)
 	{
 		realloc(capacity);
 		for (size_t i = 0; i < m_Capacity; i++)
-			m_Data[i] = fillElement;
+			new(&m_Data[i]) T(fillElement);
 	}
 
-	template<typename T>
-	constexpr vector<T>::vector(const vector& other)
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr vector<T, GrowthPolicy, Allocator>::vector(const vector& other) : m_Allocator(other.m_Allocator)
 	{
 		m_Size = other.m_Size;
 		m_Capacity = other.m_Capacity;
-		m_Data = (T*)::operator new(m_Capacity * sizeof(T));
+		m_Data = m_Allocator.allocate(m_Capacity);
+		m_Telemetry.allocated(m_Data, m_Capacity * sizeof(T));
 
-		for (size_t i = 0; i < m_Size; i++)
-			new(&m_Data[i]) T(std::move(other.m_Data[i]));
+		uninitialized_copy(other.m_Data, m_Size, m_Data);
 	}
 
-	template<typename T>
-	vector<T>::~vector()
+	// takes other's block; other is left empty with no storage
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr vector<T, GrowthPolicy, Allocator>::vector(vector&& other) noexcept : m_Data(other.m_Data), m_Size(other.m_Size), m_Capacity(other.m_Capacity), m_Growth(std::move(other.m_Growth)), m_Allocator(std::move(other.m_Allocator)), m_Telemetry(std::move(other.m_Telemetry))
 	{
-		clear();
-		::operator delete(m_Data, m_Capacity * sizeof(T));
+		other.m_Data = nullptr;
+		other.m_Size = 0;
+		other.m_Capacity = 0;
 	}
 
+	template<typename T, class GrowthPolicy, class Allocator>
+	vector<T, GrowthPolicy, Allocator>::~vector()
+	{
+		clear();
+		m_Telemetry.freed(m_Data, m_Capacity * sizeof(T));
+		m_Allocator.deallocate(m_Data, m_Capacity);
+	}
 
-	template<typename T>
+	template<typename T, class GrowthPolicy, class Allocator>
 	constexpr size_t 
-		vector<T>::size() const
+		vector<T, GrowthPolicy, Allocator>::size() const
 	{
 		return m_Size;
 	}
 
-	template<typename T>
+	template<typename T, class GrowthPolicy, class Allocator>
 	constexpr size_t 
-		vector<T>::max_size() const
+		vector<T, GrowthPolicy, Allocator>::max_size() const
 	{
 		return pow(2, CHAR_BIT * (sizeof(m_Data[0]))) - 1;
 	}
 
-	template<typename T>
+	template<typename T, class GrowthPolicy, class Allocator>
 	constexpr size_t 
-		vector<T>::capacity() const
+		vector<T, GrowthPolicy, Allocator>::capacity() const
 	{
 		return m_Capacity;
 	}
 
-	template<typename T>
+	template<typename T, class GrowthPolicy, class Allocator>
 	constexpr bool 
-		vector<T>::empty() const
+		vector<T, GrowthPolicy, Allocator>::empty() const
 	{
 		return m_Size == 0;
 	}
 
-	template<typename T>
-	constexpr typename vector<T>::reference_type 
-		vector<T>::operator[](const size_t& index)
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr const GrowthPolicy&
+		vector<T, GrowthPolicy, Allocator>::growth_policy() const
+	{
+		return m_Growth;
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename vector<T, GrowthPolicy, Allocator>::allocator_type
+		vector<T, GrowthPolicy, Allocator>::get_allocator() const
+	{
+		return m_Allocator;
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr telemetry::counters
+		vector<T, GrowthPolicy, Allocator>::telemetry_stats() const
+	{
+		return m_Telemetry.stats();
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename vector<T, GrowthPolicy, Allocator>::reference_type 
+		vector<T, GrowthPolicy, Allocator>::operator[](const size_t& index)
 	{
 		return m_Data[index];
 	}
 
-	template<typename T>
-	constexpr typename vector<T>::const_reference_type 
-		vector<T>::operator[](const size_t& index) const
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename vector<T, GrowthPolicy, Allocator>::const_reference_type 
+		vector<T, GrowthPolicy, Allocator>::operator[](const size_t& index) const
 	{
 		return m_Data[index];
 	}
 
-	template<typename T>
-	constexpr typename vector<T>::const_reference_type 
-		vector<T>::at(const size_t& index) const
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename vector<T, GrowthPolicy, Allocator>::const_reference_type 
+		vector<T, GrowthPolicy, Allocator>::at(const size_t& index) const
 	{
 		return m_Data[index];
 	}
 
-	template<typename T>
-	constexpr typename vector<T>::reference_type 
-		vector<T>::front()
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename vector<T, GrowthPolicy, Allocator>::reference_type 
+		vector<T, GrowthPolicy, Allocator>::front()
 	{
 		return m_Data[0];
 	}
 
-	template<typename T>
-	constexpr typename vector<T>::reference_type 
-		vector<T>::back()
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename vector<T, GrowthPolicy, Allocator>::reference_type 
+		vector<T, GrowthPolicy, Allocator>::back()
 	{
 		return m_Data[m_Size - 1];
 	}
 
-	template<typename T>
-	constexpr typename vector<T>::const_reference_type 
-		vector<T>::front() const
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename vector<T, GrowthPolicy, Allocator>::const_reference_type 
+		vector<T, GrowthPolicy, Allocator>::front() const
 	{
 		return m_Data[0];
 	}
 
-	template<typename T>
-	constexpr typename vector<T>::const_reference_type 
-		vector<T>::back() const
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename vector<T, GrowthPolicy, Allocator>::const_reference_type 
+		vector<T, GrowthPolicy, Allocator>::back() const
 	{
 		return m_Data[m_Size - 1];
 	}
 
-	template<typename T>
-	constexpr typename vector<T>::pointer_type 
-		vector<T>::data()
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename vector<T, GrowthPolicy, Allocator>::pointer_type 
+		vector<T, GrowthPolicy, Allocator>::data()
 	{
 		return m_Data;
 	}
 
-	template<typename T>
-	constexpr typename vector<T>::const_pointer_type 
-		vector<T>::data() const
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename vector<T, GrowthPolicy, Allocator>::const_pointer_type 
+		vector<T, GrowthPolicy, Allocator>::data() const
 	{
 		return m_Data;
 	}
 
-	template<typename T>
-	constexpr typename vector<T>::reference_type 
-		vector<T>::push_back(T&& element)
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename vector<T, GrowthPolicy, Allocator>::reference_type 
+		vector<T, GrowthPolicy, Allocator>::push_back(T&& element)
 	{
-		return emplace_back(element);
+		return emplace_back(std::move(element));
 	}
 
-	template<typename T>
-	constexpr typename vector<T>::reference_type 
-		vector<T>::push_back(const_reference_type element)
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename vector<T, GrowthPolicy, Allocator>::reference_type 
+		vector<T, GrowthPolicy, Allocator>::push_back(const_reference_type element)
 	{
 		return emplace_back(element);
 	}
 
-	template<typename T>
+	template<typename T, class GrowthPolicy, class Allocator>
 	template<typename... Args>
-	constexpr typename vector<T>::reference_type 
-		vector<T>::emplace_back(Args&&... args)
+	constexpr typename vector<T, GrowthPolicy, Allocator>::reference_type 
+		vector<T, GrowthPolicy, Allocator>::emplace_back(Args&&... args)
 	{
 		if (m_Size >= m_Capacity)
 		{
-			size_t growth = m_Size < 5 ? m_Capacity * 2 : m_Capacity + (m_Capacity << 1);
-			realloc(growth);
+			// built before growing so args may safely refer to elements of
+			// this vector (e.g. push_back(v[0]) on a full vector)
+			T element(std::forward<Args>(args)...);
+
+			grow(m_Size + 1);
+			new(&m_Data[m_Size]) T(std::move(element));
+
+			return m_Data[m_Size++];
 		}
 
 		new(&m_Data[m_Size]) T(std::forward<Args>(args)...);
@@ -285,69 +388,179 @@ namespace mystl
 		return m_Data[m_Size++];
 	}
 
-	template<typename T>
+	template<typename T, class GrowthPolicy, class Allocator>
 	template<typename... Args>
-	constexpr typename vector<T>::iterator
-		vector<T>::emplace(iterator position, Args&&... args)
+	constexpr typename vector<T, GrowthPolicy, Allocator>::iterator
+		vector<T, GrowthPolicy, Allocator>::emplace(iterator position, Args&&... args)
 	{
-		ptrdiff_t diff = end() - position;
+		size_t index = position - begin();
 
-		if (m_Size == 0)
+		if (index == m_Size)
 		{
-			emplace_back(args...);
-			return begin();
+			emplace_back(std::forward<Args>(args)...);
+			return begin() + index;
 		}
 
-		if (m_Size >= m_Capacity)
+		// built first so args may safely refer to elements of this vector
+		T element(std::forward<Args>(args)...);
+
+		new(open_gap(index, 1)) T(std::move(element));
+		m_Size++;
+
+		return begin() + index;
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename vector<T, GrowthPolicy, Allocator>::iterator
+		vector<T, GrowthPolicy, Allocator>::insert(iterator position, T&& element)
+	{
+		return emplace(position, std::move(element));
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename vector<T, GrowthPolicy, Allocator>::iterator
+		vector<T, GrowthPolicy, Allocator>::insert(iterator position, const_reference_type element)
+	{
+		return emplace(position, element);
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename vector<T, GrowthPolicy, Allocator>::iterator
+		vector<T, GrowthPolicy, Allocator>::insert(iterator position, const size_t& count, const_reference_type element)
+	{
+		size_t index = position - begin();
+
+		if (count == 0)
+			return position;
+
+		T fillElement(element);
+		T* gap = open_gap(index, count);
+
+		for (size_t i = 0; i < count; i++)
+			new(&gap[i]) T(fillElement);
+
+		m_Size += count;
+
+		return begin() + index;
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	template<class Iterator> requires (!std::is_integral_v<Iterator>)
+	constexpr typename vector<T, GrowthPolicy, Allocator>::iterator
+		vector<T, GrowthPolicy, Allocator>::insert(iterator position, Iterator first, Iterator last)
+	{
+		size_t index = position - begin();
+
+		// a single pass range is appended and rotated into place
+		if constexpr (is_single_pass_iterator_v<Iterator>)
 		{
-			size_t growth = m_Size < 5 ? m_Capacity * 2 : m_Capacity + (m_Capacity << 1);
-			realloc(growth);
+			size_t oldSize = m_Size;
+
+			append(first, last);
+			std::rotate(m_Data + index, m_Data + oldSize, m_Data + m_Size);
+
+			return begin() + index;
 		}
+		else
+		{
+			size_t count = distance(first, last);
 
-		T* temp = new T[diff]{};
-		iterator it = begin() + diff;
-		size_t i = 0;
+			if (count == 0)
+				return position;
+
+			construct_range(open_gap(index, count), first, count);
+			m_Size += count;
+
+			return begin() + index;
+		}
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename vector<T, GrowthPolicy, Allocator>::iterator
+		vector<T, GrowthPolicy, Allocator>::erase(iterator position)
+	{
+		return erase(position, position + 1);
+	}
 
-		while (it != end())
-			new(&temp[i++]) T(std::move(*(it++)));
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename vector<T, GrowthPolicy, Allocator>::iterator
+		vector<T, GrowthPolicy, Allocator>::erase(iterator first, iterator last)
+	{
+		size_t index = first - begin();
+		size_t count = last - first;
 
-		size_t size = i;
+		if (count == 0)
+			return first;
 
-		m_Data[diff] = T(std::forward<Args>(args)...);
+		destroy(m_Data + index, count);
+		relocate_overlapping(m_Data + index, m_Data + index + count, m_Size - index - count);
+		m_Size -= count;
 
-		it = begin() + diff + 1;
-		i = 0;
+		return begin() + index;
+	}
 
-		while (diff > 0)
+	template<typename T, class GrowthPolicy, class Allocator>
+	template<class Iterator> requires (!std::is_integral_v<Iterator>)
+	constexpr void
+		vector<T, GrowthPolicy, Allocator>::append(Iterator first, Iterator last)
+	{
+		// a single pass range cannot be counted first
+		if constexpr (is_single_pass_iterator_v<Iterator>)
 		{
-			*(it++) = temp[i++];
-			diff--;
+			for (; first != last; ++first)
+				emplace_back(*first);
 		}
+		else
+		{
+			size_t count = distance(first, last);
 
-		
-		for (size_t i = 0; i < size; i++)
-			temp[i].~T();
-
-		::operator delete(temp, size * sizeof(T));
-		m_Size++;
+			if (m_Size + count > m_Capacity)
+				grow(m_Size + count);
 
-		return position;
+			construct_range(m_Data + m_Size, first, count);
+			m_Size += count;
+		}
 	}
 
-	template<typename T>
-	constexpr typename vector<T>::reference_type 
-		vector<T>::pop_back()
+	template<typename T, class GrowthPolicy, class Allocator>
+	template<class Iterator> requires (!std::is_integral_v<Iterator>)
+	constexpr void
+		vector<T, GrowthPolicy, Allocator>::assign(Iterator first, Iterator last)
 	{
-		if (m_Size > 0)
+		if constexpr (is_single_pass_iterator_v<Iterator>)
+		{
+			clear();
+			append(first, last);
+		}
+		else
 		{
-			m_Size--;
-			m_Data[m_Size].~T();
+			size_t count = distance(first, last);
+
+			clear();
+			reserve(count);
+
+			construct_range(m_Data, first, count);
+			m_Size = count;
 		}
 	}
 
-	template<typename T>
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename vector<T, GrowthPolicy, Allocator>::value_type 
+		vector<T, GrowthPolicy, Allocator>::pop_back()
+	{
+		if (m_Size == 0)
+			return value_type();
+
+		m_Size--;
+		value_type val = std::move(m_Data[m_Size]);
+		m_Data[m_Size].~T();
+
+		return val;
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
 	inline void 
-		vector<T>::clear()
+		vector<T, GrowthPolicy, Allocator>::clear()
 	{
 		for (size_t i = 0; i < m_Size; i++)
 			m_Data[i].~T();
@@ -355,125 +568,385 @@ namespace mystl
 		m_Size = 0;
 	}
 
-	template<typename T>
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline void 
+		vector<T, GrowthPolicy, Allocator>::reserve(const size_t& size)
+	{
+		if (size > m_Capacity)
+			realloc(size);
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
 	inline void 
-		vector<T>::reserve(const size_t& size)
+		vector<T, GrowthPolicy, Allocator>::resize(const size_t& size)
 	{
-		realloc(size);
+		if (size <= m_Size)
+		{
+			destroy(m_Data + size, m_Size - size);
+			m_Size = size;
+			return;
+		}
+
+		reserve(size);
+
+		for (size_t i = m_Size; i < size; i++)
+			new(&m_Data[i]) T();
+
+		m_Size = size;
 	}
 
-	template<typename T>
+	template<typename T, class GrowthPolicy, class Allocator>
 	inline void 
-		vector<T>::resize(const size_t& size)
+		vector<T, GrowthPolicy, Allocator>::resize(const size_t& size, const_reference_type fillElement)
 	{
-		realloc(size);
+		if (size <= m_Size)
+		{
+			destroy(m_Data + size, m_Size - size);
+			m_Size = size;
+			return;
+		}
+
+		T element(fillElement);
+		reserve(size);
+
+		for (size_t i = m_Size; i < size; i++)
+			new(&m_Data[i]) T(element);
+
+		m_Size = size;
 	}
 
-	template<typename T>
+	// like resize, but new elements are default-initialized: trivial types are
+	// left uninitialized, so a buffer can be filled by a reader without a
+	// zero-fill pass first
+	template<typename T, class GrowthPolicy, class Allocator>
 	inline void 
-		vector<T>::shrink_to_fit()
+		vector<T, GrowthPolicy, Allocator>::resize_default_init(const size_t& size)
 	{
+		if (size <= m_Size)
+		{
+			destroy(m_Data + size, m_Size - size);
+			m_Size = size;
+			return;
+		}
+
+		reserve(size);
+
+		if constexpr (!std::is_trivially_default_constructible_v<T>)
+		{
+			for (size_t i = m_Size; i < size; i++)
+				new(&m_Data[i]) T;
+		}
+
+		m_Size = size;
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline void 
+		vector<T, GrowthPolicy, Allocator>::shrink_to_fit()
+	{
+		if (m_Size == m_Capacity)
+			return;
+
 		realloc(m_Size);
 	}
 
-	template<typename T>
-	constexpr vector<T>& vector<T>::operator=(const vector& other)
+	template<typename T, class GrowthPolicy, class Allocator>
+	inline void
+		vector<T, GrowthPolicy, Allocator>::swap(vector& other)
+	{
+		if (this == &other)
+			return;
+
+		if (m_Allocator == other.m_Allocator)
+		{
+			std::swap(m_Data, other.m_Data);
+			std::swap(m_Size, other.m_Size);
+			std::swap(m_Capacity, other.m_Capacity);
+			std::swap(m_Growth, other.m_Growth);
+			std::swap(m_Telemetry, other.m_Telemetry);
+			return;
+		}
+
+		// blocks cannot change owners (e.g. inline buffers): swap the common
+		// prefix element by element and move the longer tail across
+		vector& longer = m_Size < other.m_Size ? other : *this;
+		vector& shorter = m_Size < other.m_Size ? *this : other;
+		size_t common = shorter.m_Size;
+
+		for (size_t i = 0; i < common; i++)
+			std::swap(m_Data[i], other.m_Data[i]);
+
+		shorter.reserve(longer.m_Size);
+		relocate(shorter.m_Data + common, longer.m_Data + common, longer.m_Size - common);
+		shorter.m_Size = longer.m_Size;
+		longer.m_Size = common;
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr vector<T, GrowthPolicy, Allocator>& vector<T, GrowthPolicy, Allocator>::operator=(const vector& other)
 	{
+		if (this == &other)
+			return *this;
+
+		clear();
+		reserve(other.m_Size);
+
+		uninitialized_copy(other.m_Data, other.m_Size, m_Data);
 		m_Size = other.m_Size;
-		m_Capacity = other.m_Capacity;
-		m_Data = (T*)::operator new(m_Capacity * sizeof(T));
-		
-		for (size_t i = 0; i < m_Size; i++)
-			new(&m_Data[i]) T(std::move(other.m_Data[i]));
-		
+
 		return *this;
 	}
 
+	// steals other's block when the allocators are interchangeable, otherwise
+	// relocates the elements into this vector's own storage
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr vector<T, GrowthPolicy, Allocator>& vector<T, GrowthPolicy, Allocator>::operator=(vector&& other) noexcept(std::allocator_traits<Allocator>::is_always_equal::value)
+	{
+		if (this == &other)
+			return *this;
+
+		clear();
+
+		if (m_Allocator == other.m_Allocator)
+		{
+			m_Telemetry.freed(m_Data, m_Capacity * sizeof(T));
+			m_Allocator.deallocate(m_Data, m_Capacity);
+			m_Telemetry.absorb(other.m_Telemetry);
+
+			m_Data = other.m_Data;
+			m_Size = other.m_Size;
+			m_Capacity = other.m_Capacity;
+			m_Growth = std::move(other.m_Growth);
+
+			other.m_Data = nullptr;
+			other.m_Size = 0;
+			other.m_Capacity = 0;
+
+			return *this;
+		}
+
+		reserve(other.m_Size);
+
+		relocate(m_Data, other.m_Data, other.m_Size);
+		m_Size = other.m_Size;
+		other.m_Size = 0;
+
+		return *this;
+	}
 
-	template<typename T>
-	constexpr typename vector<T>::const_iterator
-		vector<T>::cbegin() const
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename vector<T, GrowthPolicy, Allocator>::const_iterator
+		vector<T, GrowthPolicy, Allocator>::cbegin() const
 	{
 		return const_iterator(m_Data);
 	}
 
-	template<typename T>
-	constexpr typename vector<T>::const_iterator
-		vector<T>::cend() const
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename vector<T, GrowthPolicy, Allocator>::const_iterator
+		vector<T, GrowthPolicy, Allocator>::cend() const
 	{
 		return const_iterator(m_Data + m_Size);
 	}
 
-	template<typename T>
-	constexpr typename vector<T>::iterator
-		vector<T>::begin()
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename vector<T, GrowthPolicy, Allocator>::iterator
+		vector<T, GrowthPolicy, Allocator>::begin()
 	{
 		return iterator(m_Data);
 	}
 
-	template<typename T>
-	constexpr typename vector<T>::iterator
-		vector<T>::end()
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename vector<T, GrowthPolicy, Allocator>::iterator
+		vector<T, GrowthPolicy, Allocator>::end()
 	{
 		return iterator(m_Data + m_Size);
 	}
 
-	template<typename T>
-	constexpr typename vector<T>::const_reverse_iterator
-		vector<T>::crbegin() const
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename vector<T, GrowthPolicy, Allocator>::const_reverse_iterator
+		vector<T, GrowthPolicy, Allocator>::crbegin() const
 	{
 		return const_reverse_iterator(cbegin());
 	}
 
-	template<typename T>
-	constexpr typename vector<T>::const_reverse_iterator
-		vector<T>::crend() const
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename vector<T, GrowthPolicy, Allocator>::const_reverse_iterator
+		vector<T, GrowthPolicy, Allocator>::crend() const
 	{
 		return const_reverse_iterator(cend());
 	}
 
-	template<typename T>
-	constexpr typename vector<T>::reverse_iterator
-		vector<T>::rbegin()
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename vector<T, GrowthPolicy, Allocator>::reverse_iterator
+		vector<T, GrowthPolicy, Allocator>::rbegin()
 	{
 		return reverse_iterator(begin());
 	}
 
-	template<typename T>
-	constexpr typename vector<T>::reverse_iterator
-		vector<T>::rend()
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename vector<T, GrowthPolicy, Allocator>::reverse_iterator
+		vector<T, GrowthPolicy, Allocator>::rend()
 	{
 		return reverse_iterator(end());
 	}
 
-	template<typename T>
+	// takes other's block even when the allocators compare unequal. the caller
+	// guarantees this vector's allocator can release it (small_vector hands
+	// over a block that came from the shared fallback allocator)
+	template<typename T, class GrowthPolicy, class Allocator>
 	constexpr void
-		vector<T>::realloc(const size_t& newCapacity)
+		vector<T, GrowthPolicy, Allocator>::take_block(vector& other)
+	{
+		clear();
+		m_Telemetry.freed(m_Data, m_Capacity * sizeof(T));
+		m_Allocator.deallocate(m_Data, m_Capacity);
+		m_Telemetry.absorb(other.m_Telemetry);
+
+		m_Data = other.m_Data;
+		m_Size = other.m_Size;
+		m_Capacity = other.m_Capacity;
+		m_Growth = std::move(other.m_Growth);
+
+		other.m_Data = nullptr;
+		other.m_Size = 0;
+		other.m_Capacity = 0;
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr void
+		vector<T, GrowthPolicy, Allocator>::grow(const size_t& required)
+	{
+		realloc(GrowthPolicy::next_capacity(m_Capacity, required, sizeof(T)));
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	template<class Iterator>
+	constexpr size_t
+		vector<T, GrowthPolicy, Allocator>::distance(Iterator first, Iterator last) const
+	{
+		if constexpr (is_contiguous_iterator_v<Iterator>)
+			return size_t(last - first);
+
+		size_t count = 0;
+		for (; first != last; ++first)
+			count++;
+
+		return count;
+	}
+
+	// copy constructs count elements from first into uninitialized dest. ranges
+	// that are contiguous in memory become a single memcpy for trivial types
+	template<typename T, class GrowthPolicy, class Allocator>
+	template<class Iterator>
+	constexpr void
+		vector<T, GrowthPolicy, Allocator>::construct_range(pointer_type dest, Iterator first, const size_t& count)
+	{
+		if constexpr (is_contiguous_iterator_v<Iterator> && std::is_same_v<std::remove_cvref_t<decltype(*first)>, T>)
+		{
+			if (count)
+				uninitialized_copy(&*first, count, dest);
+		}
+		else
+		{
+			for (size_t i = 0; i < count; i++, ++first)
+				new(&dest[i]) T(*first);
+		}
+	}
+
+	// makes room for count elements at index with a single pass over the tail.
+	// when the block is full the prefix and the tail are relocated straight to
+	// their final place in the new block. returns the (uninitialized) gap
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr typename vector<T, GrowthPolicy, Allocator>::pointer_type
+		vector<T, GrowthPolicy, Allocator>::open_gap(const size_t& index, const size_t& count)
+	{
+		if (m_Size + count > m_Capacity)
+		{
+			size_t newCapacity = GrowthPolicy::next_capacity(m_Capacity, m_Size + count, sizeof(T));
+
+			// a block that can be resized where it is keeps its prefix in place
+			if constexpr (has_reallocate_v<Allocator> && is_trivially_relocatable_v<T>)
+				realloc(newCapacity);
+			else
+			{
+				T* newBlock = m_Allocator.allocate(newCapacity);
+
+				if (newBlock != m_Data)
+				{
+					relocate(newBlock, m_Data, index);
+					relocate(newBlock + index + count, m_Data + index, m_Size - index);
+					m_Growth.reallocated(m_Capacity, newCapacity, m_Size * sizeof(T));
+					m_Telemetry.reallocated(m_Capacity * sizeof(T), newCapacity * sizeof(T), m_Size * sizeof(T));
+
+					m_Allocator.deallocate(m_Data, m_Capacity);
+					m_Data = newBlock;
+					m_Capacity = newCapacity;
+
+					return m_Data + index;
+				}
+
+				m_Capacity = newCapacity;
+			}
+		}
+
+		relocate_overlapping(m_Data + index + count, m_Data + index, m_Size - index);
+
+		return m_Data + index;
+	}
+
+	template<typename T, class GrowthPolicy, class Allocator>
+	constexpr void
+		vector<T, GrowthPolicy, Allocator>::realloc(const size_t& newCapacity)
 	{
 		if (!m_Data)
 		{
-			m_Data = (T*)::operator new(newCapacity * sizeof(T));
+			m_Data = m_Allocator.allocate(newCapacity);
+			m_Telemetry.allocated(m_Data, newCapacity * sizeof(T));
+			m_Capacity = newCapacity;
 			return;
 		}
 
-		T* newBlock = (T*)::operator new(newCapacity * sizeof(T));
+		if (newCapacity < m_Size)
+		{
+			destroy(m_Data + newCapacity, m_Size - newCapacity);
+			m_Size = newCapacity;
+		}
 
-		m_Size = newCapacity < m_Size ? newCapacity : m_Size;
+		// allocators that resize blocks where they are (mmap_allocator through
+		// mremap) save the copy. nullptr means they could not
+		if constexpr (has_reallocate_v<Allocator> && is_trivially_relocatable_v<T>)
+		{
+			if (T* resized = m_Allocator.reallocate(m_Data, m_Capacity, newCapacity))
+			{
+				m_Growth.reallocated(m_Capacity, newCapacity, 0);
+				m_Telemetry.reallocated(m_Capacity * sizeof(T), newCapacity * sizeof(T), 0);
+				m_Data = resized;
+				m_Capacity = newCapacity;
+				return;
+			}
+		}
 
-		for (size_t i = 0; i < m_Size; i++)
-			new(&newBlock[i]) T(std::move(m_Data[i]));
+		T* newBlock = m_Allocator.allocate(newCapacity);
 
-		for (size_t i = 0; i < m_Size; i++)
-			m_Data[i].~T();
+		// allocators with inline storage (small_vector) may hand back the current block
+		if (newBlock == m_Data)
+		{
+			m_Capacity = newCapacity;
+			return;
+		}
+
+		relocate(newBlock, m_Data, m_Size);
+		m_Growth.reallocated(m_Capacity, newCapacity, m_Size * sizeof(T));
+		m_Telemetry.reallocated(m_Capacity * sizeof(T), newCapacity * sizeof(T), m_Size * sizeof(T));
 
-		::operator delete(m_Data, m_Capacity * sizeof(T));
+		m_Allocator.deallocate(m_Data, m_Capacity);
 		m_Data = newBlock;
 		m_Capacity = newCapacity;
 	}
 
-	template<typename T>
+	template<typename T, class GrowthPolicy, class Allocator>
 	constexpr size_t 
-		vector<T>::pow(const size_t& num, const size_t& exponent) const
+		vector<T, GrowthPolicy, Allocator>::pow(const size_t& num, const size_t& exponent) const
 	{
 		size_t power = num;
 		for (size_t i = 1; i < exponent; i++)
@@ -490,4 +963,13 @@ namespace mystl
 	}
 }
 
-#endif
\ No newline at end of file
+// aligned_vector
+namespace mystl
+{
+	// vector whose data() starts on an Align byte boundary: 32 lets avx2
+	// kernels use aligned loads, 64 keeps buffers on their own cache lines
+	template<typename T, size_t Align = 64, class GrowthPolicy = growth::standard>
+	using aligned_vector = vector<T, GrowthPolicy, aligned_allocator<T, Align>>;
+}
+
+#endif